@@ -41,6 +41,11 @@
 #include <utility>
 #include <vector>
 
+#ifdef HAS_ROOT
+#include <RConfigure.h>
+#include <TROOT.h>
+#endif
+
 namespace srs
 {
     internal::AppExitHelper::~AppExitHelper() noexcept { app_->action_after_destructor(); }
@@ -183,6 +188,7 @@ namespace srs
         check_port_number_validity();
 
         set_cancel_method();
+        init_root();
 
         auto current_loc = std::source_location::current();
         auto monitoring_action = [this, current_loc]()
@@ -200,6 +206,24 @@ namespace srs
         working_thread_ = std::jthread{ monitoring_action };
     }
 
+    // ROOT implicit multithreading is a process-wide state, which is enabled only once for all ROOT outputs.
+    void App::init_root() const
+    {
+#ifdef HAS_ROOT
+        if (config_.root_n_threads == 0)
+        {
+            return;
+        }
+#ifdef R__USE_IMT
+        ROOT::EnableImplicitMT(config_.root_n_threads);
+        spdlog::info("Application: ROOT implicit multithreading is enabled with {} threads.",
+                     ROOT::GetThreadPoolSize());
+#else
+        spdlog::warn("Application: ROOT is built without implicit multithreading. Baskets are compressed serially.");
+#endif
+#endif
+    }
+
     void App::wait_for_reading_finish()
     {
         const auto _ = ExitLogger{};
@@ -283,6 +283,7 @@ namespace srs
 
         void print_statistics() const;
         void init_spdlog();
+        void init_root() const;
         void wait_for_reading_finish();
         void set_remote_fec_endpoints();
         void set_cancel_method();
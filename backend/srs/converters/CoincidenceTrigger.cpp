@@ -0,0 +1,149 @@
+#include "CoincidenceTrigger.hpp"
+#include "srs/data/SRSDataStructs.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fmt/ranges.h>
+#include <functional>
+#include <ranges>
+#include <span>
+#include <spdlog/spdlog.h>
+#include <vector>
+
+namespace srs::process
+{
+    CoincidenceTrigger::CoincidenceTrigger(std::size_t n_lines, const Options& options)
+        : ConverterTask{ "Coincidence trigger", structure, n_lines }
+        , is_event_triggered_{ options.is_event_triggered }
+    {
+        output_data_.resize(n_lines);
+        output_ptrs_.resize(n_lines, nullptr);
+        hit_buffers_.resize(n_lines);
+        event_decisions_.resize(n_lines);
+        stats_.resize(n_lines);
+
+        for (const auto& rule : options.rules)
+        {
+            auto& rule_mask = rule_masks_.emplace_back();
+            rule_mask.window_ps = rule.window_ps;
+            for (const auto plane : rule.planes)
+            {
+                rule_mask.planes.set(plane);
+            }
+            spdlog::info("Software trigger: hits in the planes [{}] within {} ps{}",
+                         fmt::join(rule.planes, ", "),
+                         rule.window_ps,
+                         is_event_triggered_ ? " of an event" : "");
+        }
+    }
+
+    CoincidenceTrigger::~CoincidenceTrigger()
+    {
+        if (auto* report = get_report(); report != nullptr and is_enabled())
+        {
+            report->register_trigger_result(get_name(), stats_);
+        }
+    }
+
+    auto CoincidenceTrigger::trigger_hits(const StructData& struct_data, std::size_t line_number) -> bool
+    {
+        output_ptrs_[line_number] = &struct_data;
+        const auto n_hits = struct_data.hit_data.size();
+        if (struct_data.hit_time.size() != n_hits or struct_data.hit_plane.size() != n_hits)
+        {
+            return false;
+        }
+
+        auto& hits = hit_buffers_[line_number];
+        hits.clear();
+        hits.reserve(n_hits);
+        for (auto idx = std::size_t{}; idx < n_hits; ++idx)
+        {
+            hits.push_back(TriggerHit{ .time = struct_data.hit_time[idx], .plane = struct_data.hit_plane[idx] });
+        }
+        std::ranges::sort(hits, std::less{}, &TriggerHit::time);
+        return is_triggered(hits);
+    }
+
+    auto CoincidenceTrigger::trigger_events(const StructData& struct_data, std::size_t line_number) -> bool
+    {
+        output_ptrs_[line_number] = &struct_data;
+        auto& hits = hit_buffers_[line_number];
+        auto& decisions = event_decisions_[line_number];
+        decisions.clear();
+        for (const auto& event : struct_data.events)
+        {
+            // Hits of an event are already sorted in time.
+            hits.clear();
+            for (const auto& event_hit : event.hits)
+            {
+                hits.push_back(TriggerHit{ .time = event_hit.time, .plane = event_hit.plane });
+            }
+            decisions.push_back(is_triggered(hits));
+        }
+
+        if (std::ranges::none_of(decisions, std::identity{}))
+        {
+            return false;
+        }
+
+        // The hits of the frame are unrelated to its events, which are built from earlier frames.
+        auto& output_data = output_data_[line_number];
+        reset_struct_data(output_data);
+        output_data.header = struct_data.header;
+        for (const auto [event, is_accepted] : std::views::zip(struct_data.events, decisions))
+        {
+            if (is_accepted)
+            {
+                output_data.events.push_back(event);
+            }
+        }
+        output_ptrs_[line_number] = &output_data;
+        return true;
+    }
+
+    auto CoincidenceTrigger::is_triggered(std::span<const TriggerHit> hits) const -> bool
+    {
+        return std::ranges::any_of(rule_masks_,
+                                   [hits](const RuleMask& rule_mask) { return is_rule_fulfilled(rule_mask, hits); });
+    }
+
+    // Sliding window over the time-sorted hits, counting the hits of each required plane inside the window.
+    auto CoincidenceTrigger::is_rule_fulfilled(const RuleMask& rule, std::span<const TriggerHit> hits) -> bool
+    {
+        const auto n_required_planes = rule.planes.count();
+        if (n_required_planes == 0)
+        {
+            return false;
+        }
+        auto plane_counts = std::array<uint32_t, std::size_t{ common::UNMAPPED_PLANE_ID } + 1>{};
+        auto n_covered_planes = std::size_t{};
+        auto window_begin = std::size_t{};
+        for (const auto& hit : hits)
+        {
+            if (not rule.planes.test(hit.plane))
+            {
+                continue;
+            }
+            if (plane_counts[hit.plane]++ == 0)
+            {
+                ++n_covered_planes;
+            }
+            for (; hit.time - hits[window_begin].time > rule.window_ps; ++window_begin)
+            {
+                const auto plane = hits[window_begin].plane;
+                if (rule.planes.test(plane) and --plane_counts[plane] == 0)
+                {
+                    --n_covered_planes;
+                }
+            }
+            if (n_covered_planes == n_required_planes)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+} // namespace srs::process
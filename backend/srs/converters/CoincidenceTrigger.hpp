@@ -0,0 +1,127 @@
+#pragma once
+
+#include "srs/converters/DataConvertOptions.hpp"
+#include "srs/data/SRSDataStructs.hpp"
+#include "srs/utils/AppReport.hpp"
+#include "srs/utils/CommonConcepts.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
+#include "srs/workflow/BaseTask.hpp"
+#include <atomic>
+#include <bitset>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace srs::process
+{
+    /**
+     * @brief Software trigger that only forwards the frames with coincident hits in the required detector planes
+     *
+     * Each rule requires hits in all of its planes within its time window. A frame is accepted if any rule is
+     * fulfilled by its hits. If the event building is enabled, the rules are applied to each built event instead and
+     * the frame is accepted if any of its events is accepted. As the events attached to a frame are built from the
+     * hits of earlier frames, the output of an accepted frame only contains its header and the accepted events. The
+     * input struct data is forwarded without any copy in the hit mode.
+     *
+     * Rejected frames stop the execution of the downstream tasks. Hits missing in the channel mapping never fulfil a
+     * rule.
+     */
+    class CoincidenceTrigger
+        : public ConverterTask<DataConvertOptions::structure, const StructData*, const StructData*>
+    {
+      public:
+        struct Rule
+        {
+            std::vector<uint8_t> planes; //!< planes that must all have hits
+            uint64_t window_ps = 0;      //!< maximum time difference among the hits of the planes
+        };
+
+        struct Options
+        {
+            std::vector<Rule> rules;         //!< trigger is disabled if empty
+            bool is_event_triggered = false; //!< whether the rules are applied to the built events
+        };
+
+        //! Rejected frames stop the execution of the downstream tasks.
+        static constexpr auto IsFrameFilter = true;
+
+        explicit CoincidenceTrigger(std::size_t n_lines = 1, const Options& options = {});
+
+        CoincidenceTrigger(const CoincidenceTrigger&) = delete;
+        CoincidenceTrigger(CoincidenceTrigger&&) = delete;
+        CoincidenceTrigger& operator=(const CoincidenceTrigger&) = delete;
+        CoincidenceTrigger& operator=(CoincidenceTrigger&&) = delete;
+        ~CoincidenceTrigger();
+
+        [[nodiscard]] auto operator()(std::size_t line_number = 0) const -> OutputType
+        {
+            assert(line_number < get_n_lines());
+            return output_ptrs_[line_number];
+        }
+
+        auto run(const OutputTo<InputType> auto& prev_data_converter, std::size_t line_number = 0) -> RunResult
+        {
+            assert(line_number < get_n_lines());
+            const auto* input_data = prev_data_converter(line_number);
+            if (not is_enabled())
+            {
+                output_ptrs_[line_number] = input_data;
+                return input_data;
+            }
+            const auto is_accepted = is_event_triggered_ ? trigger_events(*input_data, line_number)
+                                                         : trigger_hits(*input_data, line_number);
+            auto& stat = stats_[line_number];
+            if (not is_accepted)
+            {
+                ++stat.n_rejected_frames;
+                ++n_rejected_frames_;
+                return std::unexpected{ std::string_view{ "Frame rejected by the software trigger" } };
+            }
+            ++stat.n_accepted_frames;
+            ++n_accepted_frames_;
+            return this->operator()(line_number);
+        }
+
+        [[nodiscard]] auto is_enabled() const -> bool { return not rule_masks_.empty(); }
+
+        //! Total numbers of the accepted and rejected frames from all pipelines
+        [[nodiscard]] auto get_trigger_stat() const -> AppReport::TriggerStat
+        {
+            return AppReport::TriggerStat{ .n_accepted_frames = n_accepted_frames_.load(),
+                                           .n_rejected_frames = n_rejected_frames_.load() };
+        }
+
+      private:
+        struct TriggerHit
+        {
+            uint64_t time = 0;
+            uint8_t plane = common::UNMAPPED_PLANE_ID;
+        };
+
+        struct RuleMask
+        {
+            std::bitset<std::size_t{ common::UNMAPPED_PLANE_ID } + 1> planes;
+            uint64_t window_ps = 0;
+        };
+
+        bool is_event_triggered_ = false;
+        std::vector<RuleMask> rule_masks_;
+        std::vector<StructData> output_data_;
+        std::vector<const StructData*> output_ptrs_;
+        // Buffers of the time-sorted hits reused by each pipeline
+        std::vector<std::vector<TriggerHit>> hit_buffers_;
+        std::vector<std::vector<bool>> event_decisions_;
+        std::vector<AppReport::TriggerStat> stats_;
+        std::atomic<std::size_t> n_accepted_frames_ = 0;
+        std::atomic<std::size_t> n_rejected_frames_ = 0;
+
+        auto trigger_hits(const StructData& struct_data, std::size_t line_number) -> bool;
+        auto trigger_events(const StructData& struct_data, std::size_t line_number) -> bool;
+        [[nodiscard]] auto is_triggered(std::span<const TriggerHit> hits) const -> bool;
+        static auto is_rule_fulfilled(const RuleMask& rule, std::span<const TriggerHit> hits) -> bool;
+    };
+} // namespace srs::process
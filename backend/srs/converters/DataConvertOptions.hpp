@@ -18,7 +18,11 @@ namespace srs::process
         structure,
         structure_to_proto,
         proto,
-        proto_frame
+        proto_frame,
+        structure_to_packed_proto,
+        packed_proto,
+        packed_proto_frame,
+        flat
     };
 
     constexpr auto convert_option_to_string(DataConvertOptions option) -> std::string_view
@@ -40,6 +44,14 @@ namespace srs::process
                 return std::string_view{ "proto" };
             case proto_frame:
                 return std::string_view{ "proto_frame" };
+            case structure_to_packed_proto:
+                return std::string_view{ "structure_to_packed_proto" };
+            case packed_proto:
+                return std::string_view{ "packed_proto" };
+            case packed_proto_frame:
+                return std::string_view{ "packed_proto_frame" };
+            case flat:
+                return std::string_view{ "flat" };
             default:
                 return std::string_view{ "invalid" };
         }
@@ -59,9 +71,16 @@ namespace srs::process
     constexpr auto EMPTY_CONVERT_OPTION_COUNT_MAP = []()
     {
         using enum DataConvertOptions;
-        return std::array{ std::make_pair(raw, 0),       std::make_pair(raw_frame, 0),
-                           std::make_pair(structure, 0), std::make_pair(structure_to_proto, 0),
-                           std::make_pair(proto, 0),     std::make_pair(proto_frame, 0) };
+        return std::array{ std::make_pair(raw, 0),
+                           std::make_pair(raw_frame, 0),
+                           std::make_pair(structure, 0),
+                           std::make_pair(structure_to_proto, 0),
+                           std::make_pair(proto, 0),
+                           std::make_pair(proto_frame, 0),
+                           std::make_pair(structure_to_packed_proto, 0),
+                           std::make_pair(packed_proto, 0),
+                           std::make_pair(packed_proto_frame, 0),
+                           std::make_pair(flat, 0) };
     }();
 
     constexpr auto CONVERT_OPTION_RELATIONS = []()
@@ -72,7 +91,11 @@ namespace srs::process
                            ConvertOptionRelation{ structure, structure_to_proto },
                            ConvertOptionRelation{ structure, structure_to_proto },
                            ConvertOptionRelation{ structure_to_proto, proto },
-                           ConvertOptionRelation{ structure_to_proto, proto_frame } };
+                           ConvertOptionRelation{ structure_to_proto, proto_frame },
+                           ConvertOptionRelation{ structure, structure_to_packed_proto },
+                           ConvertOptionRelation{ structure_to_packed_proto, packed_proto },
+                           ConvertOptionRelation{ structure_to_packed_proto, packed_proto_frame },
+                           ConvertOptionRelation{ structure, flat } };
     }();
 
     // NOLINTBEGIN (misc-no-recursion)
@@ -132,6 +155,14 @@ class fmt::formatter<srs::process::DataConvertOptions>
                 return fmt::format_to(ctn.out(), "proto_frame");
             case structure_to_proto:
                 return fmt::format_to(ctn.out(), "structure_to_proto");
+            case structure_to_packed_proto:
+                return fmt::format_to(ctn.out(), "structure_to_packed_proto");
+            case packed_proto:
+                return fmt::format_to(ctn.out(), "packed_proto");
+            case packed_proto_frame:
+                return fmt::format_to(ctn.out(), "packed_proto_frame");
+            case flat:
+                return fmt::format_to(ctn.out(), "flat");
             default:
                 return fmt::format_to(ctn.out(), "invalid");
         }
@@ -0,0 +1,101 @@
+#include "ExpressionFilter.hpp"
+#include "srs/data/SRSDataStructs.hpp"
+#include <cstddef>
+#include <fmt/format.h>
+#include <optional>
+#include <spdlog/spdlog.h>
+#include <string_view>
+#include <vector>
+
+namespace srs::process
+{
+    namespace
+    {
+        template <typename T>
+        void copy_selected(const std::vector<T>& input, const std::vector<std::size_t>& indices, std::vector<T>& output)
+        {
+            output.clear();
+            if (input.empty())
+            {
+                return;
+            }
+            output.reserve(indices.size());
+            for (const auto idx : indices)
+            {
+                output.push_back(input[idx]);
+            }
+        }
+    } // namespace
+
+    ExpressionFilter::ExpressionFilter(std::size_t n_lines, std::string_view output_name, std::string_view expression)
+        : ConverterTask{ fmt::format("Filter of {}", output_name), structure, n_lines }
+        , expression_{ expression }
+    {
+        expression_buffers_.resize(n_lines);
+        output_data_.resize(n_lines);
+        output_ptrs_.resize(n_lines, nullptr);
+        passed_hit_indices_.resize(n_lines);
+        stats_.resize(n_lines);
+        spdlog::info("Output {:?} is filtered with the {}-level expression {:?}",
+                     output_name,
+                     expression_.is_hit_level() ? "hit" : "frame",
+                     expression_.get_expression());
+    }
+
+    ExpressionFilter::~ExpressionFilter()
+    {
+        if (auto* report = get_report(); report != nullptr)
+        {
+            report->register_filter_result(get_name(), stats_);
+        }
+    }
+
+    auto ExpressionFilter::filter_frame(const StructData& struct_data, std::size_t line_number)
+        -> std::optional<std::size_t>
+    {
+        if (expression_.evaluate(struct_data, expression_buffers_[line_number]).front() == 0)
+        {
+            return std::nullopt;
+        }
+        output_ptrs_[line_number] = &struct_data;
+        return struct_data.hit_data.size();
+    }
+
+    auto ExpressionFilter::filter_hits(const StructData& struct_data, std::size_t line_number)
+        -> std::optional<std::size_t>
+    {
+        const auto n_hits = struct_data.hit_data.size();
+        const auto passed_hits = expression_.evaluate(struct_data, expression_buffers_[line_number]);
+        auto& indices = passed_hit_indices_[line_number];
+        indices.clear();
+        for (auto idx = std::size_t{}; idx < n_hits; ++idx)
+        {
+            if (passed_hits[idx] != 0)
+            {
+                indices.push_back(idx);
+            }
+        }
+
+        if (indices.empty())
+        {
+            return std::nullopt;
+        }
+        if (indices.size() == n_hits)
+        {
+            output_ptrs_[line_number] = &struct_data;
+            return n_hits;
+        }
+
+        auto& output_data = output_data_[line_number];
+        output_data.header = struct_data.header;
+        output_data.marker_data = struct_data.marker_data;
+        output_data.clusters = struct_data.clusters;
+        output_data.events = struct_data.events;
+        copy_selected(struct_data.hit_data, indices, output_data.hit_data);
+        copy_selected(struct_data.hit_time, indices, output_data.hit_time);
+        copy_selected(struct_data.hit_plane, indices, output_data.hit_plane);
+        copy_selected(struct_data.hit_strip, indices, output_data.hit_strip);
+        output_ptrs_[line_number] = &output_data;
+        return indices.size();
+    }
+} // namespace srs::process
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "srs/converters/DataConvertOptions.hpp"
+#include "srs/data/SRSDataStructs.hpp"
+#include "srs/processors/FilterExpression.hpp"
+#include "srs/utils/AppReport.hpp"
+#include "srs/utils/CommonConcepts.hpp"
+#include "srs/workflow/BaseTask.hpp"
+#include <cassert>
+#include <cstddef>
+#include <expected>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace srs::process
+{
+    /**
+     * @brief Filter of the struct data with a filter expression, used by a single output
+     *
+     * A frame-level expression forwards or rejects the whole frame. A hit-level expression removes the hits failing
+     * the expression from all hit columns and rejects the frame if no hit remains. Markers, clusters and events are not
+     * filtered. The input struct data is only copied if some of its hits are removed.
+     *
+     * Rejected frames stop the execution of the downstream tasks of the output.
+     */
+    class ExpressionFilter
+        : public ConverterTask<DataConvertOptions::structure, const StructData*, const StructData*>
+    {
+      public:
+        //! Rejected frames stop the execution of the downstream tasks.
+        static constexpr auto IsFrameFilter = true;
+
+        /**
+         * @brief Constructor that compiles the filter expression.
+         *
+         * Throws std::runtime_error if the expression is invalid.
+         *
+         * @param n_lines Number of pipelines
+         * @param output_name Name of the output using the filter
+         * @param expression Text of the filter expression
+         */
+        ExpressionFilter(std::size_t n_lines, std::string_view output_name, std::string_view expression);
+
+        ExpressionFilter(const ExpressionFilter&) = delete;
+        ExpressionFilter(ExpressionFilter&&) = delete;
+        ExpressionFilter& operator=(const ExpressionFilter&) = delete;
+        ExpressionFilter& operator=(ExpressionFilter&&) = delete;
+        ~ExpressionFilter();
+
+        [[nodiscard]] auto operator()(std::size_t line_number = 0) const -> OutputType
+        {
+            assert(line_number < get_n_lines());
+            return output_ptrs_[line_number];
+        }
+
+        auto run(const OutputTo<InputType> auto& prev_data_converter, std::size_t line_number = 0) -> RunResult
+        {
+            assert(line_number < get_n_lines());
+            const auto* input_data = prev_data_converter(line_number);
+            auto& stat = stats_[line_number];
+            ++stat.n_input_frames;
+            stat.n_input_hits += input_data->hit_data.size();
+
+            const auto n_passed_hits = expression_.is_hit_level() ? filter_hits(*input_data, line_number)
+                                                                  : filter_frame(*input_data, line_number);
+            if (not n_passed_hits.has_value())
+            {
+                return std::unexpected{ std::string_view{ "Frame rejected by the output filter" } };
+            }
+            ++stat.n_passed_frames;
+            stat.n_passed_hits += n_passed_hits.value();
+            return this->operator()(line_number);
+        }
+
+        [[nodiscard]] auto get_expression() const -> const FilterExpression& { return expression_; }
+
+      private:
+        FilterExpression expression_;
+        std::vector<FilterExpression::Buffers> expression_buffers_;
+        std::vector<StructData> output_data_;
+        std::vector<const StructData*> output_ptrs_;
+        std::vector<std::vector<std::size_t>> passed_hit_indices_;
+        std::vector<AppReport::FilterStat> stats_;
+
+        // Both return the number of the passed hits, or std::nullopt if the frame is rejected.
+        auto filter_frame(const StructData& struct_data, std::size_t line_number) -> std::optional<std::size_t>;
+        auto filter_hits(const StructData& struct_data, std::size_t line_number) -> std::optional<std::size_t>;
+    };
+} // namespace srs::process
@@ -0,0 +1,54 @@
+#include "FrameArena.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+
+namespace srs::process
+{
+    FrameArena::FrameArena(std::size_t initial_block_size)
+        : initial_block_(initial_block_size)
+    {
+        resource_.emplace(initial_block_.data(), initial_block_.size(), &heap_resource_);
+    }
+
+    void FrameArena::reset()
+    {
+        ++stat_.n_frames;
+        stat_.max_bytes_used = std::max(stat_.max_bytes_used, bytes_used_);
+        bytes_used_ = 0;
+        if (heap_resource_.n_bytes == 0)
+        {
+            resource_->release();
+            return;
+        }
+
+        // The initial block must not be resized while it's used by the monotonic resource.
+        resource_.reset();
+        initial_block_.resize(initial_block_.size() + heap_resource_.n_bytes);
+        heap_resource_.n_bytes = 0;
+        resource_.emplace(initial_block_.data(), initial_block_.size(), &heap_resource_);
+    }
+
+    auto FrameArena::do_allocate(std::size_t bytes, std::size_t alignment) -> void*
+    {
+        ++stat_.n_messages;
+        bytes_used_ += bytes;
+        const auto n_heap_blocks = heap_resource_.n_blocks;
+        auto* block = resource_->allocate(bytes, alignment);
+        stat_.n_heap_blocks += heap_resource_.n_blocks - n_heap_blocks;
+        return block;
+    }
+
+    auto FrameArena::HeapResource::do_allocate(std::size_t bytes, std::size_t alignment) -> void*
+    {
+        ++n_blocks;
+        n_bytes += bytes;
+        return ::operator new(bytes, std::align_val_t{ alignment });
+    }
+
+    void FrameArena::HeapResource::do_deallocate(void* block, std::size_t bytes, std::size_t alignment)
+    {
+        ::operator delete(block, bytes, std::align_val_t{ alignment });
+    }
+} // namespace srs::process
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "srs/utils/AppReport.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <ranges>
+#include <vector>
+
+namespace srs::process
+{
+    /**
+     * @brief Monotonic memory arena for the outputs of a converter in one pipeline
+     *
+     * Memory is taken from an initial block without any bookkeeping and is released at once by reset(), which is
+     * called at the beginning of each conversion in the same pipeline. Containers allocated from the arena must be
+     * emptied or replaced before the reset, such that none of them refers to the released memory. If a frame needs
+     * more memory than the initial block, the extra blocks are requested from the heap and the initial block is
+     * enlarged accordingly at the next reset. Therefore, once the largest frame has been seen, no more heap
+     * allocations occur.
+     *
+     * The arena is not thread safe. Each pipeline of a converter owns one.
+     */
+    class FrameArena : public std::pmr::memory_resource
+    {
+      public:
+        explicit FrameArena(std::size_t initial_block_size = common::FRAME_ARENA_INITIAL_BLOCK_SIZE);
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena(FrameArena&&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+        FrameArena& operator=(FrameArena&&) = delete;
+        ~FrameArena() override = default;
+
+        //! Release all memory allocated for the previous frame
+        void reset();
+
+        [[nodiscard]] auto get_stat() const -> const AppReport::ArenaStat& { return stat_; }
+
+      private:
+        // Counts the memory blocks requested from the heap by the monotonic resource
+        class HeapResource : public std::pmr::memory_resource
+        {
+          public:
+            std::size_t n_blocks = 0;
+            std::size_t n_bytes = 0;
+
+          private:
+            auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override;
+            void do_deallocate(void* block, std::size_t bytes, std::size_t alignment) override;
+            [[nodiscard]] auto do_is_equal(const std::pmr::memory_resource& other) const noexcept -> bool override
+            {
+                return this == &other;
+            }
+        };
+
+        std::vector<std::byte> initial_block_;
+        HeapResource heap_resource_;
+        std::optional<std::pmr::monotonic_buffer_resource> resource_;
+        std::size_t bytes_used_ = 0;
+        AppReport::ArenaStat stat_;
+
+        auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override;
+        void do_deallocate(void* /*block*/, std::size_t /*bytes*/, std::size_t /*alignment*/) override {}
+        [[nodiscard]] auto do_is_equal(const std::pmr::memory_resource& other) const noexcept -> bool override
+        {
+            return this == &other;
+        }
+    };
+
+    //! Statistics of the arenas of all pipelines
+    inline auto get_arena_stats(const std::vector<std::unique_ptr<FrameArena>>& arenas)
+        -> std::vector<AppReport::ArenaStat>
+    {
+        return arenas | std::views::transform([](const auto& arena) { return arena->get_stat(); }) |
+               std::ranges::to<std::vector>();
+    }
+} // namespace srs::process
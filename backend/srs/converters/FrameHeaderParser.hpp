@@ -0,0 +1,64 @@
+#pragma once
+
+#include "srs/data/SRSDataStructs.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <string_view>
+
+namespace srs::process
+{
+    // Byte layout of the header in the UDP frame, in network byte order
+    constexpr auto FRAME_COUNTER_OFFSET = std::size_t{ 0 };
+    constexpr auto VMM_TAG_OFFSET = FRAME_COUNTER_OFFSET + sizeof(ReceiveDataHeader::frame_counter);
+    constexpr auto FEC_ID_OFFSET = VMM_TAG_OFFSET + sizeof(ReceiveDataHeader::vmm_tag);
+    constexpr auto UDP_TIMESTAMP_OFFSET = FEC_ID_OFFSET + sizeof(ReceiveDataHeader::fec_id);
+    constexpr auto OVERFLOW_OFFSET = UDP_TIMESTAMP_OFFSET + sizeof(ReceiveDataHeader::udp_timestamp);
+    constexpr auto FRAME_HEADER_BYTES = OVERFLOW_OFFSET + sizeof(ReceiveDataHeader::overflow);
+
+    using FrameHeaderResult = std::expected<ReceiveDataHeader, common::DecodeError>;
+
+    namespace internal
+    {
+        template <std::unsigned_integral T>
+        auto read_network_order(std::string_view binary_data, std::size_t offset) -> T
+        {
+            auto value = T{};
+            std::memcpy(&value, binary_data.data() + offset, sizeof(T));
+            if constexpr (std::endian::native == std::endian::little)
+            {
+                value = std::byteswap(value);
+            }
+            return value;
+        }
+    } // namespace internal
+
+    /**
+     * @brief Parse the header of one UDP frame with fixed-offset reads.
+     *
+     * Only the first FRAME_HEADER_BYTES bytes are read. The VMM tag is copied without any check, which is left to the
+     * consumers that require a valid frame.
+     *
+     * @param binary_data Input UDP frame
+     * @return The header, or common::DecodeError::short_frame if the frame is shorter than the header.
+     */
+    inline auto parse_frame_header(std::string_view binary_data) -> FrameHeaderResult
+    {
+        if (binary_data.size() < FRAME_HEADER_BYTES)
+        {
+            return std::unexpected{ common::DecodeError::short_frame };
+        }
+        auto header = ReceiveDataHeader{};
+        header.frame_counter = internal::read_network_order<uint32_t>(binary_data, FRAME_COUNTER_OFFSET);
+        std::ranges::copy(binary_data.substr(VMM_TAG_OFFSET, header.vmm_tag.size()), header.vmm_tag.begin());
+        header.fec_id = static_cast<uint8_t>(binary_data[FEC_ID_OFFSET]);
+        header.udp_timestamp = internal::read_network_order<uint32_t>(binary_data, UDP_TIMESTAMP_OFFSET);
+        header.overflow = internal::read_network_order<uint32_t>(binary_data, OVERFLOW_OFFSET);
+        return header;
+    }
+} // namespace srs::process
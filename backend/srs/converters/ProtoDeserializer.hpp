@@ -1,8 +1,16 @@
 #pragma once
 
+#include "srs/converters/FrameHeaderParser.hpp"
+#include "srs/data/SRSDataStructs.hpp"
 #include "srs/data/message.pb.h"
+#include "srs/utils/CommonDefinitions.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <google/protobuf/io/coded_stream.h>
 #include <google/protobuf/io/zero_copy_stream_impl_lite.h>
 #include <google/protobuf/message_lite.h>
+#include <google/protobuf/wire_format_lite.h>
 #include <string_view>
 
 namespace srs::process
@@ -12,7 +20,65 @@ namespace srs::process
       public:
         ProtoDeserializer() = default;
 
-        static void convert(std::string_view data, proto::Data& proto)
+        // A serialized proto::PackedData always starts with the tag of its varint field "version".
+        static constexpr auto PACKED_DATA_FIRST_BYTE = char{ 0x08 };
+
+        static auto is_packed(std::string_view data) -> bool
+        {
+            return not data.empty() and data.front() == PACKED_DATA_FIRST_BYTE;
+        }
+
+        /**
+         * @brief Parse only the header of a serialized proto::Data or proto::PackedData message.
+         *
+         * All other fields are skipped without being parsed.
+         *
+         * @return The header without the VMM tag, or common::DecodeError::short_frame if the message has no header.
+         */
+        static auto parse_header(std::string_view data) -> FrameHeaderResult
+        {
+            namespace protobuf = google::protobuf;
+            using protobuf::internal::WireFormatLite;
+            const auto header_field_number = is_packed(data) ? static_cast<int>(proto::PackedData::kHeaderFieldNumber)
+                                                             : static_cast<int>(proto::Data::kHeaderFieldNumber);
+            // NOLINTNEXTLINE (cppcoreguidelines-pro-type-reinterpret-cast)
+            auto input = protobuf::io::CodedInputStream{ reinterpret_cast<const uint8_t*>(data.data()),
+                                                         static_cast<int>(data.size()) };
+            for (auto tag = input.ReadTag(); tag != 0; tag = input.ReadTag())
+            {
+                if (WireFormatLite::GetTagFieldNumber(tag) != header_field_number or
+                    WireFormatLite::GetTagWireType(tag) != WireFormatLite::WIRETYPE_LENGTH_DELIMITED)
+                {
+                    if (not WireFormatLite::SkipField(&input, tag))
+                    {
+                        break;
+                    }
+                    continue;
+                }
+                auto header_size = uint32_t{};
+                auto proto_header = proto::StructHeader{};
+                if (not input.ReadVarint32(&header_size) or
+                    header_size > data.size() - static_cast<std::size_t>(input.CurrentPosition()))
+                {
+                    break;
+                }
+                const auto limit = input.PushLimit(static_cast<int>(header_size));
+                if (not proto_header.MergeFromCodedStream(&input) or not input.ConsumedEntireMessage())
+                {
+                    break;
+                }
+                input.PopLimit(limit);
+                auto header = ReceiveDataHeader{};
+                header.frame_counter = proto_header.frame_counter();
+                header.fec_id = static_cast<uint8_t>(proto_header.fec_id());
+                header.udp_timestamp = proto_header.udp_timestamp();
+                header.overflow = proto_header.overflow();
+                return header;
+            }
+            return std::unexpected{ common::DecodeError::short_frame };
+        }
+
+        static void convert(std::string_view data, google::protobuf::MessageLite& proto)
         {
             proto.Clear();
             namespace protobuf = google::protobuf;
@@ -27,7 +93,14 @@ namespace srs::process
             return data_;
         }
 
+        auto convert_packed(std::string_view str_data) -> const proto::PackedData&
+        {
+            convert(str_data, packed_data_);
+            return packed_data_;
+        }
+
       private:
         proto::Data data_;
+        proto::PackedData packed_data_;
     };
 } // namespace srs::process
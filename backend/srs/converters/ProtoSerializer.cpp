@@ -1,41 +1,41 @@
 #include "ProtoSerializer.hpp"
-#include "srs/data/message.pb.h"
-#include "srs/utils/CommonDefinitions.hpp"
-#include <google/protobuf/io/gzip_stream.h>
-#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
-#include <google/protobuf/util/delimited_message_util.h>
+#include <cstddef>
+#include <cstdint>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/message_lite.h>
 #include <string>
 
 namespace srs::process
 {
-    auto protobuf_delim_deserializer_converter::operator()(const proto::Data& proto_data, std::string& output_data)
-        -> int
+    namespace
     {
-        namespace protobuf = google::protobuf;
-        namespace io = protobuf::io;
-        auto output_stream = io::StringOutputStream{ &output_data };
-
-        if constexpr (common::PROTOBUF_ENABLE_GZIP)
-        {
-            auto option = io::GzipOutputStream::Options{};
-            option.compression_level = common::GZIP_DEFAULT_COMPRESSION_LEVEL;
-            auto gzip_output = io::GzipOutputStream{ &output_stream, option };
-            protobuf::util::SerializeDelimitedToZeroCopyStream(proto_data, &gzip_output);
-            [[maybe_unused]] auto res = gzip_output.Flush();
-        }
-        else
+        // The output is resized to the exact message size once, such that the string never reallocates.
+        auto resize_output(std::pmr::string& output_data, std::size_t size) -> uint8_t*
         {
-            protobuf::util::SerializeDelimitedToZeroCopyStream(proto_data, &output_stream);
+            output_data.resize(size);
+            // NOLINTBEGIN (cppcoreguidelines-pro-type-reinterpret-cast)
+            return reinterpret_cast<uint8_t*>(output_data.data());
+            // NOLINTEND (cppcoreguidelines-pro-type-reinterpret-cast)
         }
+    } // namespace
+
+    // NOTE: Delimited messages are written to files, which are compressed as a whole stream by the file writers.
+    auto protobuf_delim_deserializer_converter::operator()(const google::protobuf::MessageLite& proto_data,
+                                                           std::pmr::string& output_data) -> int
+    {
+        namespace io = google::protobuf::io;
+        const auto message_size = static_cast<uint32_t>(proto_data.ByteSizeLong());
+        auto* target = resize_output(output_data, io::CodedOutputStream::VarintSize32(message_size) + message_size);
+        target = io::CodedOutputStream::WriteVarint32ToArray(message_size, target);
+        proto_data.SerializeWithCachedSizesToArray(target);
         return 0;
     };
 
-    auto protobuf_deserializer_converter::operator()(const proto::Data& proto_data, std::string& output_data) -> int
+    auto protobuf_deserializer_converter::operator()(const google::protobuf::MessageLite& proto_data,
+                                                     std::pmr::string& output_data) -> int
     {
-        namespace protobuf = google::protobuf;
-        namespace io = protobuf::io;
-        auto output_stream = io::StringOutputStream{ &output_data };
-        [[maybe_unused]] auto res = proto_data.SerializeToZeroCopyStream(&output_stream);
+        auto* target = resize_output(output_data, proto_data.ByteSizeLong());
+        proto_data.SerializeWithCachedSizesToArray(target);
         return 0;
     };
 } // namespace srs::process
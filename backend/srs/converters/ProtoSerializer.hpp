@@ -1,13 +1,20 @@
 #pragma once
 
 #include "srs/converters/DataConvertOptions.hpp"
+#include "srs/converters/FrameArena.hpp"
+#include "srs/converters/FrameHeaderParser.hpp"
+#include "srs/data/SRSDataStructs.hpp"
 #include "srs/data/message.pb.h"
 #include "srs/utils/CommonConcepts.hpp"
 #include "srs/workflow/BaseTask.hpp"
 #include <cassert>
 #include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <google/protobuf/message_lite.h>
+#include <memory>
+#include <memory_resource>
+#include <ranges>
 #include <spdlog/spdlog.h>
 #include <string>
 #include <string_view>
@@ -16,26 +23,46 @@
 
 namespace srs::process
 {
-    template <typename Converter, DataConvertOptions Conversion>
-    class ProtoSerializerBase : public ConverterTask<Conversion, const proto::Data*, std::string_view>
+    /**
+     * @brief Base class of the serializers from protobuf messages to binary strings
+     *
+     * The output string of each pipeline is allocated on its own srs::process::FrameArena.
+     */
+    template <typename Converter,
+              DataConvertOptions Conversion,
+              typename ProtoType = proto::Data,
+              DataConvertOptions PrevConversion = DataConvertOptions::structure_to_proto>
+    class ProtoSerializerBase : public ConverterTask<Conversion, const ProtoType*, std::string_view>
     {
       public:
         explicit ProtoSerializerBase(std::string name, Converter converter, std::size_t n_lines = 1)
-            : ConverterTask<Conversion, const proto::Data*, std::string_view>{ name,
-                                                                               DataConvertOptions::structure_to_proto,
-                                                                               n_lines }
+            : ConverterTask<Conversion, const ProtoType*, std::string_view>{ name, PrevConversion, n_lines }
             , name_{ std::move(name) }
             , converter_{ converter }
         {
-            output_data_.resize(n_lines);
+            arenas_.reserve(n_lines);
+            output_data_.reserve(n_lines);
+            input_data_.resize(n_lines);
+            for ([[maybe_unused]] auto _ : std::views::iota(std::size_t{ 0 }, n_lines))
+            {
+                arenas_.push_back(std::make_unique<FrameArena>());
+                output_data_.emplace_back(arenas_.back().get());
+            }
         }
-        using Base = ConverterTask<Conversion, const proto::Data*, std::string_view>;
+        using Base = ConverterTask<Conversion, const ProtoType*, std::string_view>;
 
         ProtoSerializerBase(const ProtoSerializerBase&) = delete;
         ProtoSerializerBase(ProtoSerializerBase&&) = delete;
         ProtoSerializerBase& operator=(const ProtoSerializerBase&) = delete;
         ProtoSerializerBase& operator=(ProtoSerializerBase&&) = delete;
-        ~ProtoSerializerBase() { spdlog::debug("Shutting down {:?} serializer.", name_); }
+        ~ProtoSerializerBase()
+        {
+            if (auto* report = Base::get_report(); report != nullptr)
+            {
+                report->register_arena_result(Base::get_name(), get_arena_stats(arenas_));
+            }
+            spdlog::debug("Shutting down {:?} serializer.", name_);
+        }
 
         [[nodiscard]] auto operator()(std::size_t line_num) const -> Base::OutputType
         {
@@ -43,27 +70,44 @@ namespace srs::process
             return output_data_[line_num];
         }
 
+        //! Frame header of the serialized message, without the VMM tag and the overflow
+        [[nodiscard]] auto get_frame_header(std::size_t line_num) const -> FrameHeaderResult
+        {
+            assert(line_num < Base::get_n_lines());
+            const auto& header = input_data_[line_num]->header();
+            auto frame_header = ReceiveDataHeader{};
+            frame_header.frame_counter = header.frame_counter();
+            frame_header.fec_id = static_cast<uint8_t>(header.fec_id());
+            frame_header.udp_timestamp = header.udp_timestamp();
+            return frame_header;
+        }
+
         auto run(const OutputTo<typename Base::InputType> auto& prev_data_converter, std::size_t line_number)
             -> Base::RunResult
         {
             assert(line_number < Base::get_n_lines());
-            output_data_[line_number].clear();
+            auto& arena = *arenas_[line_number];
+            output_data_[line_number] = std::pmr::string{ &arena };
+            arena.reset();
             const auto* input_data = prev_data_converter(line_number);
-            static_assert(std::same_as<decltype(input_data), const proto::Data*>);
+            static_assert(std::same_as<decltype(input_data), const ProtoType*>);
+            input_data_[line_number] = input_data;
             converter_(*input_data, output_data_[line_number]);
             return this->operator()(line_number);
         }
 
       private:
         std::string name_;
-        std::vector<std::string> output_data_;
+        std::vector<const ProtoType*> input_data_;
+        std::vector<std::unique_ptr<FrameArena>> arenas_;
+        std::vector<std::pmr::string> output_data_;
         Converter converter_;
     };
 
     class protobuf_deserializer_converter
     {
       public:
-        auto operator()(const proto::Data& proto_data, std::string& output_data) -> int;
+        auto operator()(const google::protobuf::MessageLite& proto_data, std::pmr::string& output_data) -> int;
     };
 
     class ProtoSerializer : public ProtoSerializerBase<protobuf_deserializer_converter, DataConvertOptions::proto>
@@ -78,7 +122,7 @@ namespace srs::process
     class protobuf_delim_deserializer_converter
     {
       public:
-        auto operator()(const proto::Data& proto_data, std::string& output_data) -> int;
+        auto operator()(const google::protobuf::MessageLite& proto_data, std::pmr::string& output_data) -> int;
     };
 
     class ProtoDelimSerializer
@@ -90,4 +134,30 @@ namespace srs::process
         {
         }
     };
+
+    class PackedProtoSerializer
+        : public ProtoSerializerBase<protobuf_deserializer_converter,
+                                     DataConvertOptions::packed_proto,
+                                     proto::PackedData,
+                                     DataConvertOptions::structure_to_packed_proto>
+    {
+      public:
+        explicit PackedProtoSerializer(std::size_t n_lines)
+            : ProtoSerializerBase{ "PackedProtoSerializer", protobuf_deserializer_converter{}, n_lines }
+        {
+        }
+    };
+
+    class PackedProtoDelimSerializer
+        : public ProtoSerializerBase<protobuf_delim_deserializer_converter,
+                                     DataConvertOptions::packed_proto_frame,
+                                     proto::PackedData,
+                                     DataConvertOptions::structure_to_packed_proto>
+    {
+      public:
+        explicit PackedProtoDelimSerializer(std::size_t n_lines)
+            : ProtoSerializerBase{ "PackedProtoSerializer(delim)", protobuf_delim_deserializer_converter{}, n_lines }
+        {
+        }
+    };
 } // namespace srs::process
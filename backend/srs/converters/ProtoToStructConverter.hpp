@@ -1,8 +1,10 @@
 #pragma once
 
+#include "srs/data/SRSDataCompact.hpp"
 #include "srs/data/SRSDataStructs.hpp"
 #include "srs/data/message.pb.h"
 #include <cstdint>
+#include <ranges>
 
 namespace srs::process
 {
@@ -18,6 +20,17 @@ namespace srs::process
             set_header(proto, struct_data);
             set_hit_data(proto, struct_data);
             set_marker_data(proto, struct_data);
+            set_cluster_data(proto, struct_data);
+        }
+
+        static void convert(const proto::PackedData& proto, StructData& struct_data)
+        {
+            reset_struct_data(struct_data);
+
+            set_header(proto, struct_data);
+            set_hit_data(proto, struct_data);
+            set_marker_data(proto, struct_data);
+            set_cluster_data(proto, struct_data);
         }
 
         auto convert(const proto::Data& proto) -> const StructData&
@@ -26,10 +39,16 @@ namespace srs::process
             return data_;
         }
 
+        auto convert(const proto::PackedData& proto) -> const StructData&
+        {
+            convert(proto, data_);
+            return data_;
+        }
+
       private:
         StructData data_;
 
-        static void set_header(const proto::Data& proto, StructData& struct_data)
+        static void set_header(const auto& proto, StructData& struct_data)
         {
             const auto& proto_header = proto.header();
 
@@ -71,6 +90,80 @@ namespace srs::process
                 hit_data.bc_id = static_cast<uint16_t>(proto_hit.bc_id());
             }
         }
+
+        static void set_marker_data(const proto::PackedData& proto, StructData& struct_data)
+        {
+            const auto& vmm_ids = proto.marker_vmm_id();
+            const auto& timestamp_deltas = proto.marker_srs_timestamp_delta();
+            struct_data.marker_data.reserve(static_cast<uint64_t>(vmm_ids.size()));
+
+            auto timestamp = uint64_t{};
+            for (const auto [vmm_id, timestamp_delta] : std::views::zip(vmm_ids, timestamp_deltas))
+            {
+                timestamp += static_cast<uint64_t>(timestamp_delta);
+                auto& marker_data = struct_data.marker_data.emplace_back();
+                marker_data.srs_timestamp = timestamp;
+                marker_data.vmm_id = static_cast<uint8_t>(vmm_id);
+            }
+        }
+
+        static void set_hit_data(const proto::PackedData& proto, StructData& struct_data)
+        {
+            const auto& channel_words = proto.hit_channel_vmm();
+            struct_data.hit_data.reserve(static_cast<uint64_t>(channel_words.size()));
+
+            for (const auto [channel_word, tdc, offset, adc, bc_id] : std::views::zip(
+                     channel_words, proto.hit_tdc(), proto.hit_offset(), proto.hit_adc(), proto.hit_bc_id()))
+            {
+                auto& hit_data = struct_data.hit_data.emplace_back();
+
+                hit_data.is_over_threshold = internal::unpack_is_over_threshold(channel_word);
+                hit_data.channel_num = internal::unpack_channel_num(channel_word);
+                hit_data.tdc = static_cast<uint8_t>(tdc);
+                hit_data.offset = static_cast<uint8_t>(offset);
+                hit_data.vmm_id = internal::unpack_vmm_id(channel_word);
+                hit_data.adc = static_cast<uint16_t>(adc);
+                hit_data.bc_id = static_cast<uint16_t>(bc_id);
+            }
+        }
+
+        static void set_cluster_data(const proto::Data& proto, StructData& struct_data)
+        {
+            const auto& proto_clusters = proto.cluster_data();
+            struct_data.clusters.reserve(static_cast<uint64_t>(proto_clusters.size()));
+
+            for (const auto& proto_cluster : proto_clusters)
+            {
+                auto& cluster = struct_data.clusters.emplace_back();
+                cluster.plane = static_cast<uint8_t>(proto_cluster.plane());
+                cluster.centroid = proto_cluster.centroid();
+                cluster.charge = proto_cluster.charge();
+                cluster.size = static_cast<uint16_t>(proto_cluster.size());
+                cluster.time = proto_cluster.time();
+            }
+        }
+
+        static void set_cluster_data(const proto::PackedData& proto, StructData& struct_data)
+        {
+            const auto& planes = proto.cluster_plane();
+            struct_data.clusters.reserve(static_cast<uint64_t>(planes.size()));
+
+            auto time = uint64_t{};
+            for (const auto [plane, centroid, charge, size, time_delta] : std::views::zip(planes,
+                                                                                           proto.cluster_centroid(),
+                                                                                           proto.cluster_charge(),
+                                                                                           proto.cluster_size(),
+                                                                                           proto.cluster_time_delta()))
+            {
+                time += static_cast<uint64_t>(time_delta);
+                auto& cluster = struct_data.clusters.emplace_back();
+                cluster.plane = static_cast<uint8_t>(plane);
+                cluster.centroid = centroid;
+                cluster.charge = charge;
+                cluster.size = static_cast<uint16_t>(size);
+                cluster.time = time;
+            }
+        }
     };
 
 } // namespace srs::process
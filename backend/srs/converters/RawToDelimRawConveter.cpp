@@ -1,16 +1,16 @@
 #include "RawToDelimRawConveter.hpp"
 #include <string_view>
-#include <vector>
 #include <zpp_bits.h>
 
 namespace srs::process
 {
-    void Raw2DelimRawConverter::convert(std::string_view input, std::vector<char>& output)
+    auto Raw2DelimRawConverter::convert(std::string_view input) -> SizePrefix
     {
         auto size = static_cast<SizeType>(input.size());
-        output.reserve(size + sizeof(size));
-        auto deserialize_to = zpp::bits::out{ output, zpp::bits::append{}, zpp::bits::endian::big{} };
-        deserialize_to(size, zpp::bits::unsized(input)).or_throw();
+        auto size_prefix = SizePrefix{};
+        auto serialize_to = zpp::bits::out{ size_prefix, zpp::bits::endian::big{} };
+        serialize_to(size).or_throw();
+        return size_prefix;
     }
 
 } // namespace srs::process
@@ -4,6 +4,7 @@
 #include "srs/utils/CommonConcepts.hpp"
 #include "srs/utils/CommonDefinitions.hpp"
 #include "srs/workflow/BaseTask.hpp"
+#include <array>
 #include <cassert>
 #include <cstddef>
 #include <spdlog/spdlog.h>
@@ -17,14 +18,25 @@ namespace srs::workflow
 
 namespace srs::process
 {
+    /**
+     * @brief Converter from the raw frame to the frame prefixed with its size
+     *
+     * The size prefix and the frame are kept separately, such that the frame is never copied. The output is the
+     * original frame and the size prefix, in big endian, is obtained from get_size_prefix(). Writers must write the
+     * size prefix before the frame.
+     */
     class Raw2DelimRawConverter
         : public ConverterTask<DataConvertOptions::raw_frame, std::string_view, std::string_view>
     {
       public:
+        using SizeType = common::RawDelimSizeType;
+        using SizePrefix = std::array<char, sizeof(SizeType)>;
+
         explicit Raw2DelimRawConverter(size_t n_lines = 1)
             : ConverterTask{ "RawDelimiter", raw, n_lines }
         {
             output_data_.resize(n_lines);
+            size_prefixes_.resize(n_lines);
         }
 
         Raw2DelimRawConverter(const Raw2DelimRawConverter&) = default;
@@ -33,25 +45,29 @@ namespace srs::process
         Raw2DelimRawConverter& operator=(Raw2DelimRawConverter&&) = delete;
         ~Raw2DelimRawConverter() { spdlog::debug("Taskflow: raw data delimiter is finished!"); }
 
-        using SizeType = common::RawDelimSizeType;
-
         [[nodiscard]] auto operator()(std::size_t line_num) const -> OutputType
         {
             assert(line_num < get_n_lines());
-            return std::string_view{ output_data_[line_num].data(), output_data_[line_num].size() };
+            return output_data_[line_num];
+        }
+
+        [[nodiscard]] auto get_size_prefix(std::size_t line_num) const -> std::string_view
+        {
+            assert(line_num < get_n_lines());
+            return std::string_view{ size_prefixes_[line_num].data(), size_prefixes_[line_num].size() };
         }
 
         auto run(const OutputTo<InputType> auto& prev_data_converter, std::size_t line_number) -> RunResult
         {
             assert(line_number < get_n_lines());
-            auto& output_data = output_data_[line_number];
-            output_data.clear();
-            convert(prev_data_converter(line_number), output_data);
+            output_data_[line_number] = prev_data_converter(line_number);
+            size_prefixes_[line_number] = convert(output_data_[line_number]);
             return this->operator()(line_number);
         }
 
       private:
-        std::vector<std::vector<char>> output_data_;
-        static void convert(std::string_view input, std::vector<char>& output);
+        std::vector<std::string_view> output_data_;
+        std::vector<SizePrefix> size_prefixes_;
+        static auto convert(std::string_view input) -> SizePrefix;
     };
 } // namespace srs::process
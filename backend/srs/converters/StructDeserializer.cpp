@@ -1,16 +1,24 @@
 #include "StructDeserializer.hpp"
+#include "srs/converters/FrameArena.hpp"
+#include "srs/converters/FrameHeaderParser.hpp"
 #include "srs/data/SRSDataCompact.hpp"
 #include "srs/data/SRSDataStructs.hpp"
+#include "srs/sinks/QuarantineFile.hpp"
 #include "srs/utils/CommonAlias.hpp"
 #include "srs/utils/CommonDefinitions.hpp"
 #include "srs/utils/CommonFunctions.hpp"
 #include "srs/workflow/BaseTask.hpp"
 #include <algorithm>
+#include <atomic>
 #include <bitset>
 #include <cstddef>
 #include <cstdint>
 #include <expected>
+#include <magic_enum/magic_enum.hpp>
+#include <memory>
+#include <ranges>
 #include <string_view>
+#include <spdlog/spdlog.h>
 #include <zpp_bits.h>
 
 namespace srs::process
@@ -63,40 +71,145 @@ namespace srs::process
     StructDeserializer::StructDeserializer(size_t n_lines)
         : ConverterTask{ "Struct deserializer", raw, n_lines }
     {
-        raw_body_part_data_.resize(n_lines);
+        arenas_.reserve(n_lines);
+        raw_body_part_data_.reserve(n_lines);
+        for ([[maybe_unused]] auto _ : std::views::iota(std::size_t{ 0 }, n_lines))
+        {
+            arenas_.push_back(std::make_unique<FrameArena>());
+            raw_body_part_data_.emplace_back(arenas_.back().get());
+        }
         output_data_.resize(n_lines);
+        decode_error_stats_.resize(n_lines);
+    }
+
+    StructDeserializer::~StructDeserializer()
+    {
+        if (auto* report = get_report(); report != nullptr)
+        {
+            report->register_decode_error_result(get_name(), decode_error_stats_);
+            report->register_arena_result(get_name(), get_arena_stats(arenas_));
+        }
     }
 
     // thread safe
     auto StructDeserializer::convert(std::string_view binary_data,
                                      StructData& output_data,
-                                     ReceiveDataSquence& body_part_data) -> std::expected<std::size_t, std::string_view>
+                                     ReceiveDataSquence& body_part_data)
+        -> std::expected<std::size_t, common::DecodeError>
     {
-        auto deserialize_to = zpp::bits::in{ binary_data, zpp::bits::endian::network{}, zpp::bits::no_size{} };
+        return convert(binary_data, parse_frame_header(binary_data), output_data, body_part_data);
+    }
 
+    // thread safe
+    auto StructDeserializer::convert(std::string_view binary_data,
+                                     const FrameHeaderResult& header,
+                                     StructData& output_data,
+                                     ReceiveDataSquence& body_part_data)
+        -> std::expected<std::size_t, common::DecodeError>
+    {
+        using enum common::DecodeError;
         auto read_bytes = binary_data.size() * sizeof(BufferElementType);
-        constexpr auto header_bytes = sizeof(output_data.header);
         constexpr auto element_bytes = common::HIT_DATA_BIT_LENGTH / common::BYTE_BIT_LENGTH;
-        if (read_bytes <= header_bytes)
+        if (read_bytes < FRAME_HEADER_BYTES + element_bytes or not header.has_value())
         {
-            return std::unexpected{ "Deserialization: The size of the binary data is too small!" };
+            return std::unexpected{ short_frame };
         }
-        auto vector_size = (read_bytes - header_bytes) / element_bytes;
-        if (vector_size == 0)
+        output_data.header = header.value();
+        if (output_data.header.vmm_tag != common::VMM_TAG)
         {
-            return std::unexpected{ "Deserialization: Cannot read the header correctly!" };
+            return std::unexpected{ bad_vmm_tag };
+        }
+        if ((read_bytes - FRAME_HEADER_BYTES) % element_bytes != 0)
+        {
+            return std::unexpected{ trailing_bytes };
         }
 
-        // locking mutex to prevent data racing
+        auto vector_size = (read_bytes - FRAME_HEADER_BYTES) / element_bytes;
         body_part_data.resize(vector_size);
         std::ranges::fill(body_part_data, 0);
-        deserialize_to(output_data.header, body_part_data).or_throw();
+        const auto body_data = binary_data.substr(FRAME_HEADER_BYTES);
+        auto deserialize_to = zpp::bits::in{ body_data, zpp::bits::endian::network{}, zpp::bits::no_size{} };
+        if (zpp::bits::failure(deserialize_to(body_part_data)))
+        {
+            return std::unexpected{ short_frame };
+        }
         byte_reverse_data_sq(body_part_data);
+        if (not check_is_valid(body_part_data))
+        {
+            return std::unexpected{ invalid_value };
+        }
         translate_raw_data(output_data, body_part_data);
 
         return body_part_data.size();
     }
 
+    // A data element with all bits being zero is neither a hit (flag bit is 0) nor a meaningful marker (VMM 0 with a
+    // zero timestamp). It only appears if the frame is corrupted or padded with zeros.
+    auto StructDeserializer::check_is_valid(const ReceiveDataSquence& receive_raw_data) -> bool
+    {
+        return std::ranges::none_of(receive_raw_data, [](const DataElementType& element) { return element.none(); });
+    }
+
+    void StructDeserializer::register_decode_error(common::DecodeError error,
+                                                   std::string_view binary_data,
+                                                   std::size_t line_number)
+    {
+        using enum common::DecodeError;
+        auto& stat = decode_error_stats_[line_number];
+        switch (error)
+        {
+            case short_frame:
+                ++stat.n_short_frame;
+                break;
+            case bad_vmm_tag:
+                ++stat.n_bad_vmm_tag;
+                break;
+            case trailing_bytes:
+                ++stat.n_trailing_bytes;
+                break;
+            case invalid_value:
+                ++stat.n_invalid_value;
+                break;
+        }
+        if (auto index = magic_enum::enum_index(error); index.has_value())
+        {
+            decode_error_counts_[index.value()].fetch_add(1, std::memory_order_relaxed);
+        }
+        if (quarantine_file_ != nullptr and quarantine_file_->write(binary_data))
+        {
+            ++stat.n_quarantined;
+        }
+        spdlog::trace(
+            "{}: frame with {} bytes is rejected: {}", get_name(), binary_data.size(), get_error_message(error));
+    }
+
+    auto StructDeserializer::get_error_message(common::DecodeError error) -> std::string_view
+    {
+        using enum common::DecodeError;
+        switch (error)
+        {
+            case short_frame:
+                return "Deserialization: The size of the binary data is too small!";
+            case bad_vmm_tag:
+                return "Deserialization: The VMM tag in the header is not \"VM3\"!";
+            case trailing_bytes:
+                return "Deserialization: The size of the data body is not a multiple of the data element size!";
+            case invalid_value:
+                return "Deserialization: The data body contains invalid values!";
+        }
+        return "Deserialization: Unknown error!";
+    }
+
+    auto StructDeserializer::get_decode_error_counts() const -> DecodeErrorCounts
+    {
+        auto counts = DecodeErrorCounts{};
+        std::ranges::transform(decode_error_counts_,
+                               counts.begin(),
+                               [](const std::atomic<uint64_t>& count) -> uint64_t
+                               { return count.load(std::memory_order_relaxed); });
+        return counts;
+    }
+
     void StructDeserializer::translate_raw_data(StructData& struct_data, ReceiveDataSquence& receive_raw_data)
     {
         for (const auto& element : receive_raw_data)
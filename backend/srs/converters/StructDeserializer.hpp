@@ -1,17 +1,27 @@
 #pragma once
 
 #include "srs/converters/DataConvertOptions.hpp"
+#include "srs/converters/FrameArena.hpp"
+#include "srs/converters/FrameHeaderParser.hpp"
 #include "srs/data/SRSDataStructs.hpp"
+#include "srs/utils/AppReport.hpp"
 #include "srs/utils/CommonConcepts.hpp"
 #include "srs/utils/CommonDefinitions.hpp"
 #include "srs/workflow/BaseTask.hpp"
 #include <asio/any_io_executor.hpp>
 #include <asio/thread_pool.hpp>
+#include <array>
+#include <atomic>
 #include <bitset>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <expected>
+#include <magic_enum/magic_enum.hpp>
+#include <memory>
+#include <memory_resource>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 #include <zpp_bits.h>
 
@@ -20,15 +30,31 @@ namespace srs::workflow
     class TaskDiagram;
 }
 
+namespace srs::sink
+{
+    class QuarantineFile;
+}
+
 namespace srs::process
 {
     class StructDeserializer : public ConverterTask<DataConvertOptions::structure, std::string_view, const StructData*>
     {
       public:
         using DataElementType = std::bitset<common::HIT_DATA_BIT_LENGTH>;
-        using ReceiveDataSquence = std::vector<DataElementType>;
+        using ReceiveDataSquence = std::pmr::vector<DataElementType>;
+        using DecodeErrorCounts = std::array<uint64_t, magic_enum::enum_count<common::DecodeError>()>;
+
+        //! Frames failing the deserialization stop the execution of the downstream tasks.
+        static constexpr auto IsFrameFilter = true;
+
         explicit StructDeserializer(size_t n_lines = 1);
 
+        StructDeserializer(const StructDeserializer&) = delete;
+        StructDeserializer(StructDeserializer&&) = delete;
+        StructDeserializer& operator=(const StructDeserializer&) = delete;
+        StructDeserializer& operator=(StructDeserializer&&) = delete;
+        ~StructDeserializer();
+
         [[nodiscard]] auto operator()(std::size_t line_number = 0) const -> OutputType
         {
             assert(line_number < get_n_lines());
@@ -41,17 +67,76 @@ namespace srs::process
             auto& output_data = output_data_[line_number];
             auto& raw_body_part_data = raw_body_part_data_[line_number];
             reset_struct_data(output_data);
-            raw_body_part_data.clear();
-            auto res = convert(prev_data_converter(line_number), output_data, raw_body_part_data);
-            return res.transform([line_number, this](auto) { return this->operator()(line_number); });
+            // The old buffer must be given back before its memory is released by the arena.
+            auto& arena = *arenas_[line_number];
+            raw_body_part_data = ReceiveDataSquence{ &arena };
+            arena.reset();
+            const auto input_data = prev_data_converter(line_number);
+            // The header already parsed at the beginning of the pipeline is reused.
+            auto res = std::expected<std::size_t, common::DecodeError>{};
+            if constexpr (FrameHeaderProvider<std::remove_cvref_t<decltype(prev_data_converter)>>)
+            {
+                res = convert(
+                    input_data, prev_data_converter.get_frame_header(line_number), output_data, raw_body_part_data);
+            }
+            else
+            {
+                res = convert(input_data, output_data, raw_body_part_data);
+            }
+            if (not res.has_value())
+            {
+                register_decode_error(res.error(), input_data, line_number);
+                return std::unexpected{ get_error_message(res.error()) };
+            }
+            return this->operator()(line_number);
         }
 
+        /**
+         * @brief Set the file to store the frames that fail to be decoded.
+         *
+         * @param quarantine_file Pointer to the quarantine file. nullptr disables the storage.
+         */
+        void set_quarantine(sink::QuarantineFile* quarantine_file) { quarantine_file_ = quarantine_file; }
+
+        //! Total numbers of the frames failing to be decoded, indexed by common::DecodeError. Thread safe.
+        [[nodiscard]] auto get_decode_error_counts() const -> DecodeErrorCounts;
+
+        /**
+         * @brief Deserialize one UDP frame without throwing any exceptions.
+         *
+         * @param binary_data Input UDP frame
+         * @param output Output struct data
+         * @param body_part_data Buffer for the data elements
+         * @return Number of the data elements, or the failure class if the frame is malformed.
+         */
+        static auto convert(std::string_view binary_data, StructData& output, ReceiveDataSquence& body_part_data)
+            -> std::expected<std::size_t, common::DecodeError>;
+
+        /**
+         * @brief Deserialize one UDP frame whose header has been parsed.
+         *
+         * @param binary_data Input UDP frame
+         * @param header Result of srs::process::parse_frame_header on the same frame
+         * @param output Output struct data
+         * @param body_part_data Buffer for the data elements
+         * @return Number of the data elements, or the failure class if the frame is malformed.
+         */
+        static auto convert(std::string_view binary_data,
+                            const FrameHeaderResult& header,
+                            StructData& output,
+                            ReceiveDataSquence& body_part_data) -> std::expected<std::size_t, common::DecodeError>;
+
       private:
+        std::vector<std::unique_ptr<FrameArena>> arenas_;
         std::vector<ReceiveDataSquence> raw_body_part_data_;
         std::vector<StructData> output_data_;
+        std::vector<AppReport::DecodeErrorStat> decode_error_stats_;
+        std::array<std::atomic<uint64_t>, magic_enum::enum_count<common::DecodeError>()> decode_error_counts_{};
+        sink::QuarantineFile* quarantine_file_ = nullptr;
 
-        static auto convert(std::string_view binary_data, StructData& output, ReceiveDataSquence& body_part_data)
-            -> std::expected<std::size_t, std::string_view>;
+        void register_decode_error(common::DecodeError error, std::string_view binary_data, std::size_t line_number);
+        static auto get_error_message(common::DecodeError error) -> std::string_view;
+        static auto check_is_valid(const ReceiveDataSquence& receive_raw_data) -> bool;
         static void translate_raw_data(StructData& struct_data, ReceiveDataSquence& receive_raw_data);
         static void byte_reverse_data_sq(ReceiveDataSquence& receive_raw_data);
         static auto check_is_hit(const DataElementType& element) -> bool
@@ -0,0 +1,118 @@
+#include "StructProcessor.hpp"
+#include "srs/data/SRSDataStructs.hpp"
+#include <cstddef>
+#include <utility>
+#include <spdlog/spdlog.h>
+
+namespace srs::process
+{
+    namespace
+    {
+        void drop_hits(StructData& struct_data)
+        {
+            struct_data.hit_data.clear();
+            struct_data.hit_time.clear();
+            struct_data.hit_plane.clear();
+            struct_data.hit_strip.clear();
+        }
+    } // namespace
+
+    StructProcessor::StructProcessor(std::size_t n_lines, const Options& options)
+        : ConverterTask{ "Struct processor", structure, n_lines }
+    {
+        output_data_.resize(n_lines);
+        output_ptrs_.resize(n_lines, nullptr);
+        if (options.zero_suppression.n_sigma > 0.)
+        {
+            zero_suppressor_.emplace(n_lines, options.zero_suppression);
+            zero_suppression_stats_.resize(n_lines);
+        }
+        if (not options.channel_mapping_filename.empty())
+        {
+            channel_mapper_.emplace(options.channel_mapping_filename);
+        }
+        if (options.clustering.time_window_ps > 0)
+        {
+            if (channel_mapper_.has_value())
+            {
+                strip_clusterer_.emplace(n_lines, options.clustering);
+                if (not options.is_hit_time_enabled)
+                {
+                    spdlog::info("Hit time reconstruction is enabled for the strip clustering.");
+                }
+            }
+            else
+            {
+                spdlog::warn("Strip clustering is disabled because no channel mapping is provided.");
+            }
+        }
+        if (options.event_building.window_ps > 0)
+        {
+            event_builder_.emplace(options.event_building);
+            if (not options.is_hit_time_enabled)
+            {
+                spdlog::info("Hit time reconstruction is enabled for the event building.");
+            }
+        }
+        if (options.is_hit_time_enabled or strip_clusterer_.has_value() or event_builder_.has_value())
+        {
+            hit_time_reconstructor_.emplace(options.bc_clock_period_ps);
+        }
+    }
+
+    StructProcessor::~StructProcessor()
+    {
+        if (auto* report = get_report(); report != nullptr and zero_suppressor_)
+        {
+            report->register_zero_suppression_result(get_name(), zero_suppression_stats_);
+        }
+    }
+
+    auto StructProcessor::flush_events(std::size_t line_number) -> bool
+    {
+        if (not event_builder_)
+        {
+            return false;
+        }
+        auto events = event_builder_->flush();
+        if (events.empty())
+        {
+            return false;
+        }
+        auto& output_data = output_data_[line_number];
+        reset_struct_data(output_data);
+        output_data.events = std::move(events);
+        output_ptrs_[line_number] = &output_data;
+        return true;
+    }
+
+    void StructProcessor::process(StructData& struct_data, std::size_t line_number)
+    {
+        if (zero_suppressor_)
+        {
+            auto& stat = zero_suppression_stats_[line_number];
+            stat.n_input_hits += struct_data.hit_data.size();
+            stat.n_suppressed_hits += zero_suppressor_->process(struct_data, line_number);
+        }
+        if (hit_time_reconstructor_)
+        {
+            hit_time_reconstructor_->process(struct_data);
+        }
+        if (channel_mapper_)
+        {
+            channel_mapper_->process(struct_data);
+        }
+        if (strip_clusterer_)
+        {
+            strip_clusterer_->process(struct_data, line_number);
+        }
+        if (event_builder_)
+        {
+            event_builder_->process(struct_data);
+        }
+        if (strip_clusterer_ and strip_clusterer_->is_hit_dropped())
+        {
+            drop_hits(struct_data);
+        }
+    }
+} // namespace srs::process
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "srs/converters/DataConvertOptions.hpp"
+#include "srs/data/SRSDataStructs.hpp"
+#include "srs/processors/ChannelMapper.hpp"
+#include "srs/processors/EventBuilder.hpp"
+#include "srs/processors/HitTimeReconstructor.hpp"
+#include "srs/processors/StripClusterer.hpp"
+#include "srs/processors/ZeroSuppressor.hpp"
+#include "srs/utils/AppReport.hpp"
+#include "srs/utils/CommonConcepts.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
+#include "srs/workflow/BaseTask.hpp"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace srs::process
+{
+    /**
+     * @brief Processing stages applied to the struct data before any struct consumers
+     *
+     * The input struct data is copied to the internal buffer of the pipeline and modified by each enabled stage. If
+     * no stage is enabled, the input struct data is forwarded without any copy. The zero suppression runs first, such
+     * that the later stages only work on the surviving hits. The strip clustering runs after the channel mapping and
+     * the event building runs last. If only the clusters are kept, the hits are removed after the event building.
+     */
+    class StructProcessor
+        : public ConverterTask<DataConvertOptions::structure, const StructData*, const StructData*>
+    {
+      public:
+        struct Options
+        {
+            bool is_hit_time_enabled = false;
+            uint64_t bc_clock_period_ps = common::DEFAULT_BC_CLOCK_PERIOD_PS;
+            std::string channel_mapping_filename; //!< empty to disable the channel mapping
+            ZeroSuppressor::Options zero_suppression; //!< zero suppression is disabled if n_sigma is not positive
+            StripClusterer::Options clustering;       //!< strip clustering is disabled if time_window_ps is 0
+            EventBuilder::Options event_building;     //!< event building is disabled if window_ps is 0
+        };
+
+        explicit StructProcessor(std::size_t n_lines = 1, const Options& options = {});
+
+        StructProcessor(const StructProcessor&) = delete;
+        StructProcessor(StructProcessor&&) = delete;
+        StructProcessor& operator=(const StructProcessor&) = delete;
+        StructProcessor& operator=(StructProcessor&&) = delete;
+        ~StructProcessor();
+
+        [[nodiscard]] auto operator()(std::size_t line_number = 0) const -> OutputType
+        {
+            assert(line_number < get_n_lines());
+            return output_ptrs_[line_number];
+        }
+
+        auto run(const OutputTo<InputType> auto& prev_data_converter, std::size_t line_number = 0) -> RunResult
+        {
+            assert(line_number < get_n_lines());
+            const auto* input_data = prev_data_converter(line_number);
+            if (not is_enabled())
+            {
+                output_ptrs_[line_number] = input_data;
+                return input_data;
+            }
+            auto& output_data = output_data_[line_number];
+            output_data = *input_data;
+            process(output_data, line_number);
+            output_ptrs_[line_number] = &output_data;
+            return this->operator()(line_number);
+        }
+
+        /**
+         * @brief Build the events still pending in the event builder at the end of the run.
+         *
+         * The events are attached to an additional frame without any hits, which becomes the output of the line.
+         *
+         * @param line_number Pipeline whose output is replaced
+         * @return false if the event building is disabled or no events are left.
+         */
+        auto flush_events(std::size_t line_number = 0) -> bool;
+
+        //! Whether any processing stage is enabled
+        [[nodiscard]] auto is_enabled() const -> bool
+        {
+            return zero_suppressor_.has_value() or hit_time_reconstructor_.has_value() or channel_mapper_.has_value() or
+                   strip_clusterer_.has_value() or event_builder_.has_value();
+        }
+
+      private:
+        std::vector<StructData> output_data_;
+        std::vector<const StructData*> output_ptrs_;
+        std::optional<ZeroSuppressor> zero_suppressor_;
+        std::optional<HitTimeReconstructor> hit_time_reconstructor_;
+        std::optional<ChannelMapper> channel_mapper_;
+        std::optional<StripClusterer> strip_clusterer_;
+        std::optional<EventBuilder> event_builder_;
+        std::vector<AppReport::ZeroSuppressionStat> zero_suppression_stats_;
+
+        void process(StructData& struct_data, std::size_t line_number);
+    };
+} // namespace srs::process
@@ -0,0 +1,53 @@
+#include "StructToFlatConverter.hpp"
+#include "srs/data/SRSDataFlat.hpp"
+#include "srs/data/SRSDataStructs.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace srs::process
+{
+    void Struct2FlatConverter::convert(const StructData& struct_data, std::vector<char>& output_data)
+    {
+        const auto n_markers = struct_data.marker_data.size();
+        const auto n_hits = struct_data.hit_data.size();
+        output_data.resize(sizeof(FlatHeader) + (n_markers * sizeof(FlatMarkerData)) + (n_hits * sizeof(FlatHitData)));
+        auto* position = output_data.data();
+
+        const auto& input_header = struct_data.header;
+        auto header = FlatHeader{};
+        header.header_size = static_cast<uint16_t>(sizeof(FlatHeader));
+        header.frame_counter = input_header.frame_counter;
+        header.udp_timestamp = input_header.udp_timestamp;
+        header.overflow = input_header.overflow;
+        header.fec_id = input_header.fec_id;
+        header.n_markers = static_cast<uint32_t>(n_markers);
+        header.n_hits = static_cast<uint32_t>(n_hits);
+        std::memcpy(position, &header, sizeof(header));
+        position += sizeof(header);
+
+        for (const auto& input_data : struct_data.marker_data)
+        {
+            auto marker = FlatMarkerData{};
+            marker.srs_timestamp = input_data.srs_timestamp;
+            marker.vmm_id = input_data.vmm_id;
+            std::memcpy(position, &marker, sizeof(marker));
+            position += sizeof(marker);
+        }
+
+        for (const auto& input_data : struct_data.hit_data)
+        {
+            auto hit = FlatHitData{};
+            hit.adc = input_data.adc;
+            hit.bc_id = input_data.bc_id;
+            hit.channel_num = input_data.channel_num;
+            hit.tdc = input_data.tdc;
+            hit.offset = input_data.offset;
+            hit.vmm_id = input_data.vmm_id;
+            hit.is_over_threshold = static_cast<uint8_t>(input_data.is_over_threshold);
+            std::memcpy(position, &hit, sizeof(hit));
+            position += sizeof(hit);
+        }
+    }
+} // namespace srs::process
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "srs/converters/DataConvertOptions.hpp"
+#include "srs/data/SRSDataStructs.hpp"
+#include "srs/utils/CommonConcepts.hpp"
+#include "srs/workflow/BaseTask.hpp"
+#include <cassert>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace srs::process
+{
+    /**
+     * @brief Converter from the struct data to the fixed-layout wire format defined in SRSDataFlat.hpp
+     */
+    class Struct2FlatConverter : public ConverterTask<DataConvertOptions::flat, const StructData*, std::string_view>
+    {
+      public:
+        explicit Struct2FlatConverter(std::size_t n_lines)
+            : ConverterTask{ "Struct to flat converter", structure, n_lines }
+        {
+            output_data_.resize(n_lines);
+        }
+
+        [[nodiscard]] auto operator()(std::size_t line_num) const -> OutputType
+        {
+            assert(line_num < get_n_lines());
+            const auto& output_data = output_data_[line_num];
+            return std::string_view{ output_data.data(), output_data.size() };
+        }
+
+        auto run(const OutputTo<InputType> auto& prev_data_converter, std::size_t line_number) -> RunResult
+        {
+            assert(line_number < get_n_lines());
+            auto input_data = prev_data_converter(line_number);
+            convert(*input_data, output_data_[line_number]);
+            return this->operator()(line_number);
+        }
+
+        static void convert(const StructData& struct_data, std::vector<char>& output_data);
+
+      private:
+        std::vector<std::vector<char>> output_data_;
+    };
+} // namespace srs::process
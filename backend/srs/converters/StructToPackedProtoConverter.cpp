@@ -0,0 +1,104 @@
+#include "StructToPackedProtoConverter.hpp"
+#include "srs/data/SRSDataCompact.hpp"
+#include "srs/data/SRSDataStructs.hpp"
+#include "srs/data/message.pb.h"
+#include "srs/utils/CommonDefinitions.hpp"
+#include <cassert>
+#include <cstdint>
+
+namespace srs::process
+{
+    namespace
+    {
+        void set_header(const StructData& struct_data, proto::PackedData& output_data)
+        {
+            const auto& input_header = struct_data.header;
+            auto* header = output_data.mutable_header();
+            assert(header != nullptr);
+            header->set_frame_counter(input_header.frame_counter);
+            header->set_fec_id(input_header.fec_id);
+            header->set_udp_timestamp(input_header.udp_timestamp);
+            header->set_overflow(input_header.overflow);
+        }
+
+        void set_marker_data(const StructData& struct_data, proto::PackedData& output_data)
+        {
+            const auto& input_marker_data = struct_data.marker_data;
+            const auto n_markers = static_cast<int>(input_marker_data.size());
+            auto* vmm_ids = output_data.mutable_marker_vmm_id();
+            auto* timestamp_deltas = output_data.mutable_marker_srs_timestamp_delta();
+            vmm_ids->Reserve(n_markers);
+            timestamp_deltas->Reserve(n_markers);
+
+            auto last_timestamp = uint64_t{};
+            for (const auto& input_data : input_marker_data)
+            {
+                vmm_ids->AddAlreadyReserved(input_data.vmm_id);
+                timestamp_deltas->AddAlreadyReserved(static_cast<int64_t>(input_data.srs_timestamp - last_timestamp));
+                last_timestamp = input_data.srs_timestamp;
+            }
+        }
+
+        void set_hit_data(const StructData& struct_data, proto::PackedData& output_data)
+        {
+            const auto& input_hit_data = struct_data.hit_data;
+            const auto n_hits = static_cast<int>(input_hit_data.size());
+            auto* channel_words = output_data.mutable_hit_channel_vmm();
+            auto* tdcs = output_data.mutable_hit_tdc();
+            auto* offsets = output_data.mutable_hit_offset();
+            auto* adcs = output_data.mutable_hit_adc();
+            auto* bc_ids = output_data.mutable_hit_bc_id();
+            channel_words->Reserve(n_hits);
+            tdcs->Reserve(n_hits);
+            offsets->Reserve(n_hits);
+            adcs->Reserve(n_hits);
+            bc_ids->Reserve(n_hits);
+
+            for (const auto& input_data : input_hit_data)
+            {
+                channel_words->AddAlreadyReserved(internal::pack_channel_word(
+                    input_data.channel_num, input_data.vmm_id, input_data.is_over_threshold));
+                tdcs->AddAlreadyReserved(input_data.tdc);
+                offsets->AddAlreadyReserved(input_data.offset);
+                adcs->AddAlreadyReserved(input_data.adc);
+                bc_ids->AddAlreadyReserved(input_data.bc_id);
+            }
+        }
+
+        void set_cluster_data(const StructData& struct_data, proto::PackedData& output_data)
+        {
+            const auto& input_clusters = struct_data.clusters;
+            const auto n_clusters = static_cast<int>(input_clusters.size());
+            auto* planes = output_data.mutable_cluster_plane();
+            auto* centroids = output_data.mutable_cluster_centroid();
+            auto* charges = output_data.mutable_cluster_charge();
+            auto* sizes = output_data.mutable_cluster_size();
+            auto* time_deltas = output_data.mutable_cluster_time_delta();
+            planes->Reserve(n_clusters);
+            centroids->Reserve(n_clusters);
+            charges->Reserve(n_clusters);
+            sizes->Reserve(n_clusters);
+            time_deltas->Reserve(n_clusters);
+
+            auto last_time = uint64_t{};
+            for (const auto& input_data : input_clusters)
+            {
+                planes->AddAlreadyReserved(input_data.plane);
+                centroids->AddAlreadyReserved(input_data.centroid);
+                charges->AddAlreadyReserved(input_data.charge);
+                sizes->AddAlreadyReserved(input_data.size);
+                time_deltas->AddAlreadyReserved(static_cast<int64_t>(input_data.time - last_time));
+                last_time = input_data.time;
+            }
+        }
+    } // namespace
+
+    void Struct2PackedProtoConverter::convert(const StructData& struct_data, proto::PackedData& output_data)
+    {
+        output_data.set_version(common::PACKED_PROTOBUF_VERSION);
+        set_header(struct_data, output_data);
+        set_marker_data(struct_data, output_data);
+        set_hit_data(struct_data, output_data);
+        set_cluster_data(struct_data, output_data);
+    }
+} // namespace srs::process
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "srs/converters/DataConvertOptions.hpp"
+#include "srs/data/SRSDataStructs.hpp"
+#include "srs/data/message.pb.h"
+#include "srs/utils/CommonConcepts.hpp"
+#include "srs/workflow/BaseTask.hpp"
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace srs::process
+{
+    /**
+     * @brief Converter from the struct data to the column-oriented protobuf message proto::PackedData
+     *
+     * Repeated fields of the message keep their capacity after being cleared. Therefore no memory allocation is
+     * needed once the message of a pipeline has reached the size of the largest frame.
+     */
+    class Struct2PackedProtoConverter
+        : public ConverterTask<DataConvertOptions::structure_to_packed_proto,
+                               const StructData*,
+                               const proto::PackedData*>
+    {
+      public:
+        explicit Struct2PackedProtoConverter(std::size_t n_lines)
+            : ConverterTask{ "Struct to packed proto converter", structure, n_lines }
+        {
+            output_data_.resize(n_lines);
+        }
+
+        [[nodiscard]] auto operator()(std::size_t line_num) const -> OutputType
+        {
+            assert(line_num < get_n_lines());
+            return &output_data_[line_num];
+        }
+
+        auto run(const OutputTo<InputType> auto& prev_data_converter, std::size_t line_number) -> RunResult
+        {
+            assert(line_number < get_n_lines());
+            auto& output_data = output_data_[line_number];
+            output_data.Clear();
+            auto input_data = prev_data_converter(line_number);
+            convert(*input_data, output_data);
+            return this->operator()(line_number);
+        }
+
+        static void convert(const StructData& struct_data, proto::PackedData& output_data);
+
+      private:
+        std::vector<proto::PackedData> output_data_;
+    };
+} // namespace srs::process
@@ -1,12 +1,30 @@
 #include "StructToProtoConverter.hpp"
 #include "srs/data/SRSDataStructs.hpp"
 #include "srs/data/message.pb.h"
+#include "srs/utils/CommonDefinitions.hpp"
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <google/protobuf/arena.h>
+#include <memory>
+#include <new>
 
 namespace srs::process
 {
     namespace
     {
+        // Number of memory blocks requested from the heap by the arenas in the current thread. Each conversion
+        // runs entirely in one thread, which makes the difference before and after a conversion its own count.
+        thread_local std::size_t arena_heap_block_count = 0;
+
+        auto allocate_arena_block(std::size_t size) -> void*
+        {
+            ++arena_heap_block_count;
+            return ::operator new(size);
+        }
+
+        void deallocate_arena_block(void* block, std::size_t size) { ::operator delete(block, size); }
+
         void set_header(const StructData& struct_data, proto::Data& output_data)
         {
             const auto& input_header = struct_data.header;
@@ -21,6 +39,7 @@ namespace srs::process
         void set_marker_data(const StructData& struct_data, proto::Data& output_data)
         {
             const auto& input_marker_data = struct_data.marker_data;
+            output_data.mutable_marker_data()->Reserve(static_cast<int>(input_marker_data.size()));
             for (const auto& input_data : input_marker_data)
             {
                 auto* marker_data = output_data.add_marker_data();
@@ -32,6 +51,7 @@ namespace srs::process
         void set_hit_data(const StructData& struct_data, proto::Data& output_data)
         {
             const auto& input_hit_data = struct_data.hit_data;
+            output_data.mutable_hit_data()->Reserve(static_cast<int>(input_hit_data.size()));
             for (const auto& input_data : input_hit_data)
             {
                 auto* hit_data = output_data.add_hit_data();
@@ -45,12 +65,82 @@ namespace srs::process
             }
         }
 
+        void set_cluster_data(const StructData& struct_data, proto::Data& output_data)
+        {
+            const auto& input_clusters = struct_data.clusters;
+            output_data.mutable_cluster_data()->Reserve(static_cast<int>(input_clusters.size()));
+            for (const auto& input_data : input_clusters)
+            {
+                auto* cluster_data = output_data.add_cluster_data();
+                cluster_data->set_plane(input_data.plane);
+                cluster_data->set_centroid(input_data.centroid);
+                cluster_data->set_charge(input_data.charge);
+                cluster_data->set_size(input_data.size);
+                cluster_data->set_time(input_data.time);
+            }
+        }
+
     } // namespace
 
+    Struct2ProtoConverter::Struct2ProtoConverter(std::size_t n_lines)
+        : ConverterTask{ "Struct to proto converter", structure, n_lines }
+    {
+        arena_initial_blocks_.resize(n_lines);
+        arenas_.reserve(n_lines);
+        output_data_.resize(n_lines, nullptr);
+        arena_stats_.resize(n_lines);
+        block_counts_before_.resize(n_lines);
+
+        for (auto& initial_block : arena_initial_blocks_)
+        {
+            initial_block.resize(common::PROTOBUF_ARENA_INITIAL_BLOCK_SIZE);
+            auto options = google::protobuf::ArenaOptions{};
+            options.initial_block = initial_block.data();
+            options.initial_block_size = initial_block.size();
+            options.block_alloc = &allocate_arena_block;
+            options.block_dealloc = &deallocate_arena_block;
+            arenas_.push_back(std::make_unique<google::protobuf::Arena>(options));
+        }
+    }
+
+    Struct2ProtoConverter::~Struct2ProtoConverter()
+    {
+        // Messages must not outlive their arenas.
+        std::ranges::fill(output_data_, nullptr);
+        if (auto* report = get_report(); report != nullptr)
+        {
+            report->register_arena_result(get_name(), arena_stats_);
+        }
+    }
+
+    auto Struct2ProtoConverter::reset_output(std::size_t line_number) -> proto::Data*
+    {
+        auto& arena = *arenas_[line_number];
+        auto& stat = arena_stats_[line_number];
+        stat.max_bytes_used = std::max(stat.max_bytes_used, static_cast<std::size_t>(arena.SpaceUsed()));
+        arena.Reset();
+
+        block_counts_before_[line_number] = arena_heap_block_count;
+        auto* output_data = google::protobuf::Arena::Create<proto::Data>(&arena);
+        output_data_[line_number] = output_data;
+        return output_data;
+    }
+
+    void Struct2ProtoConverter::update_arena_stat(const StructData& struct_data, std::size_t line_number)
+    {
+        auto& stat = arena_stats_[line_number];
+        ++stat.n_frames;
+        // header + marker data + hit data + cluster data, each of which is a separate heap allocation without an arena
+        stat.n_messages +=
+            1 + struct_data.marker_data.size() + struct_data.hit_data.size() + struct_data.clusters.size();
+        stat.n_heap_blocks += arena_heap_block_count - block_counts_before_[line_number];
+    }
+
     void Struct2ProtoConverter::convert(const StructData& struct_data, proto::Data& output_data)
     {
         set_header(struct_data, output_data);
         set_marker_data(struct_data, output_data);
         set_hit_data(struct_data, output_data);
+        set_cluster_data(struct_data, output_data);
     }
 } // namespace srs::process
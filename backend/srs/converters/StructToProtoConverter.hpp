@@ -3,45 +3,64 @@
 #include "srs/converters/DataConvertOptions.hpp"
 #include "srs/data/SRSDataStructs.hpp"
 #include "srs/data/message.pb.h"
+#include "srs/utils/AppReport.hpp"
 #include "srs/utils/CommonConcepts.hpp"
 #include "srs/workflow/BaseTask.hpp"
 #include <asio/any_io_executor.hpp>
 #include <asio/thread_pool.hpp>
 #include <cassert>
 #include <cstddef>
+#include <google/protobuf/arena.h>
+#include <memory>
 #include <string_view>
 #include <vector>
 
 namespace srs::process
 {
+    /**
+     * @brief Converter from the struct data to the protobuf message
+     *
+     * The protobuf message of each pipeline is allocated on its own arena, which is reset at the beginning of the
+     * next conversion in the same pipeline. Consumers of the message (serializers) always run before that, so the
+     * message and all of its sub-messages are freed at once without any per-message heap allocation.
+     */
     class Struct2ProtoConverter
         : public ConverterTask<DataConvertOptions::structure_to_proto, const StructData*, const proto::Data*>
     {
       public:
-        explicit Struct2ProtoConverter(std::size_t n_lines)
-            : ConverterTask{ "Struct deserializer", structure, n_lines }
-        {
-            output_data_.resize(n_lines);
-        }
+        explicit Struct2ProtoConverter(std::size_t n_lines);
+
+        Struct2ProtoConverter(const Struct2ProtoConverter&) = delete;
+        Struct2ProtoConverter(Struct2ProtoConverter&&) = delete;
+        Struct2ProtoConverter& operator=(const Struct2ProtoConverter&) = delete;
+        Struct2ProtoConverter& operator=(Struct2ProtoConverter&&) = delete;
+        ~Struct2ProtoConverter();
 
         [[nodiscard]] auto operator()(std::size_t line_num) const -> OutputType
         {
             assert(line_num < get_n_lines());
-            return &output_data_[line_num];
+            return output_data_[line_num];
         }
 
         auto run(const OutputTo<InputType> auto& prev_data_converter, std::size_t line_number) -> RunResult
         {
             assert(line_number < get_n_lines());
-            auto& output_data = output_data_[line_number];
-            output_data.Clear();
+            auto* output_data = reset_output(line_number);
             auto input_data = prev_data_converter(line_number);
-            convert(*input_data, output_data);
+            convert(*input_data, *output_data);
+            update_arena_stat(*input_data, line_number);
             return this->operator()(line_number);
         }
 
       private:
-        std::vector<proto::Data> output_data_;
+        std::vector<std::vector<char>> arena_initial_blocks_;
+        std::vector<std::unique_ptr<google::protobuf::Arena>> arenas_;
+        std::vector<proto::Data*> output_data_;
+        std::vector<AppReport::ArenaStat> arena_stats_;
+        std::vector<std::size_t> block_counts_before_;
+
+        auto reset_output(std::size_t line_number) -> proto::Data*;
+        void update_arena_stat(const StructData& struct_data, std::size_t line_number);
         static void convert(const StructData& struct_data, proto::Data& output_data);
     };
 } // namespace srs::process
@@ -22,6 +22,32 @@ namespace srs::process::internal
     constexpr auto SRS_TIMESTAMP_MAX =
         (1ULL << (common::SRS_TIMESTAMP_LOW_BIT_LENGTH + common::SRS_TIMESTAMP_HIGH_BIT_LENGTH)) - 1;
 
+    // Bit layout of the channel word in proto::PackedData
+    constexpr auto PACKED_VMM_ID_BIT_POSITION = CHANNEL_NUM_BIT_LENGTH;
+    constexpr auto PACKED_OVER_THRESHOLD_BIT_POSITION = CHANNEL_NUM_BIT_LENGTH + VMM_ID_BIT_LENGTH;
+
+    constexpr auto pack_channel_word(uint8_t channel_num, uint8_t vmm_id, bool is_over_threshold) -> uint32_t
+    {
+        return (static_cast<uint32_t>(channel_num) & CHANNEL_NUM_BIT_MAX) |
+               ((static_cast<uint32_t>(vmm_id) & VMM_ID_BIT_MAX) << PACKED_VMM_ID_BIT_POSITION) |
+               (static_cast<uint32_t>(is_over_threshold) << PACKED_OVER_THRESHOLD_BIT_POSITION);
+    }
+
+    constexpr auto unpack_channel_num(uint32_t word) -> uint8_t
+    {
+        return static_cast<uint8_t>(word & CHANNEL_NUM_BIT_MAX);
+    }
+
+    constexpr auto unpack_vmm_id(uint32_t word) -> uint8_t
+    {
+        return static_cast<uint8_t>((word >> PACKED_VMM_ID_BIT_POSITION) & VMM_ID_BIT_MAX);
+    }
+
+    constexpr auto unpack_is_over_threshold(uint32_t word) -> bool
+    {
+        return ((word >> PACKED_OVER_THRESHOLD_BIT_POSITION) & 1U) == 1U;
+    }
+
     struct HitDataCompact
     {
         uint16_t : 16;
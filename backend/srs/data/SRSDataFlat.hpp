@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+
+namespace srs
+{
+    /**
+     * @file SRSDataFlat.hpp
+     * @brief Fixed-layout wire format of the struct data
+     *
+     * A message consists of a FlatHeader, followed by FlatHeader::n_markers elements of FlatMarkerData and
+     * FlatHeader::n_hits elements of FlatHitData. All values are little-endian and the arrays are naturally aligned
+     * if the message starts at an 8-byte aligned address. Consumers can therefore use the message in place without any
+     * decoding.
+     */
+
+    constexpr auto FLAT_DATA_MAGIC = uint32_t{ 0x46535253 }; //!< "SRSF" in little-endian
+    constexpr auto FLAT_DATA_VERSION = uint16_t{ 1 };
+
+    struct FlatHeader
+    {
+        uint32_t magic = FLAT_DATA_MAGIC;     //!< Always #FLAT_DATA_MAGIC
+        uint16_t version = FLAT_DATA_VERSION; //!< Version of the layout
+        uint16_t header_size{};               //!< Byte size of the header, where the marker data begins
+        uint32_t frame_counter{};             //!< The counting value for current UDP data frame.
+        uint32_t udp_timestamp{};             //!< UDP timestamp
+        uint32_t overflow{};                  //!< Overflow value
+        uint8_t fec_id{};                     //!< FEC ID
+        std::array<uint8_t, 3> reserved{};
+        uint32_t n_markers{}; //!< Number of marker data
+        uint32_t n_hits{};    //!< Number of hit data
+    };
+
+    struct FlatMarkerData
+    {
+        uint64_t srs_timestamp{}; //!< Timestamp value
+        uint8_t vmm_id{};         //!< VMM ID for the marker data
+        std::array<uint8_t, 7> reserved{};
+    };
+
+    struct FlatHitData
+    {
+        uint16_t adc{};              //!< ADC value
+        uint16_t bc_id{};            //!< BC ID
+        uint8_t channel_num{};       //!< Channel number
+        uint8_t tdc{};               //!< TDC value
+        uint8_t offset{};            //!< Offset value
+        uint8_t vmm_id{};            //!< VMM ID
+        uint8_t is_over_threshold{}; //!< 1 if the hit data is over the threshold, otherwise 0
+        std::array<uint8_t, 3> reserved{};
+    };
+
+    static_assert(std::endian::native == std::endian::little, "Flat data layout requires a little-endian host.");
+    static_assert(sizeof(FlatHeader) == 32 and std::is_trivially_copyable_v<FlatHeader>);
+    static_assert(sizeof(FlatMarkerData) == 16 and std::is_trivially_copyable_v<FlatMarkerData>);
+    static_assert(sizeof(FlatHitData) == 12 and std::is_trivially_copyable_v<FlatHitData>);
+} // namespace srs
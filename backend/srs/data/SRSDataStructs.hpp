@@ -55,13 +55,63 @@ namespace srs
 #endif
     };
 
+    struct EventHitData
+    {
+        uint64_t time{};         //!< Absolute hit time (ps)
+        uint8_t fec_id{};        //!< FEC ID
+        uint8_t vmm_id{};        //!< VMM ID
+        uint8_t channel_num{};   //!< Channel number
+        uint8_t plane = 0xff;    //!< Detector plane. 0xff if not mapped.
+        uint16_t strip = 0xffff; //!< Detector strip. 0xffff if not mapped.
+        uint16_t adc{};          //!< ADC value
+#ifdef HAS_ROOT
+        ClassDefNV(EventHitData, 1);
+#endif
+#ifndef __CLING__
+        auto operator==(const EventHitData&) const -> bool = default;
+#endif
+    };
+
+    struct EventData
+    {
+        uint64_t event_id{};            //!< Event ID in the order of the building
+        uint64_t start_time{};          //!< Time (ps) of the first hit
+        std::vector<EventHitData> hits; //!< Hits from all FECs sorted in time
+#ifdef HAS_ROOT
+        ClassDefNV(EventData, 1);
+#endif
+#ifndef __CLING__
+        auto operator==(const EventData&) const -> bool = default;
+#endif
+    };
+
+    struct ClusterData
+    {
+        uint64_t time{};   //!< Time (ps) of the earliest hit
+        float centroid{};  //!< Strip position weighted with the ADC values
+        uint32_t charge{}; //!< Sum of the ADC values
+        uint16_t size{};   //!< Number of hits
+        uint8_t plane{};   //!< Detector plane
+#ifdef HAS_ROOT
+        ClassDefNV(ClusterData, 1);
+#endif
+#ifndef __CLING__
+        auto operator==(const ClusterData&) const -> bool = default;
+#endif
+    };
+
     struct StructData
     {
         ReceiveDataHeader header{};          //!< Header data
         std::vector<MarkerData> marker_data; //!< Marker data
         std::vector<HitData> hit_data;       //!< Hit data
+        std::vector<uint64_t> hit_time;      //!< Absolute time (ps) of each hit. Empty if not reconstructed.
+        std::vector<uint8_t> hit_plane;      //!< Detector plane of each hit. Empty if no channel mapping.
+        std::vector<uint16_t> hit_strip;     //!< Detector strip of each hit. Empty if no channel mapping.
+        std::vector<ClusterData> clusters;   //!< Strip clusters of the hits. Empty if the clustering is disabled.
+        std::vector<EventData> events;       //!< Events completed by the event builder since the previous frame
 #ifdef HAS_ROOT
-        ClassDefNV(StructData, 1);
+        ClassDefNV(StructData, 5);
 #endif
 #ifndef __CLING__
         auto operator==(const StructData&) const -> bool = default;
@@ -73,5 +123,10 @@ namespace srs
         struct_data.header = ReceiveDataHeader{};
         struct_data.marker_data.clear();
         struct_data.hit_data.clear();
+        struct_data.hit_time.clear();
+        struct_data.hit_plane.clear();
+        struct_data.hit_strip.clear();
+        struct_data.clusters.clear();
+        struct_data.events.clear();
     }
 } // namespace srs
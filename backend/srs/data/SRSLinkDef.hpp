@@ -5,6 +5,12 @@
 #pragma link C++ class srs::HitData+;
 #pragma link C++ class vector<srs::HitData>+;
 #pragma link C++ class vector<srs::MarkerData>+;
+#pragma link C++ class srs::EventHitData+;
+#pragma link C++ class srs::EventData+;
+#pragma link C++ class vector<srs::EventHitData>+;
+#pragma link C++ class vector<srs::EventData>+;
+#pragma link C++ class srs::ClusterData+;
+#pragma link C++ class vector<srs::ClusterData>+;
 #pragma link C++ class srs::StructData+;
 
 #endif
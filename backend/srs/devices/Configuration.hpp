@@ -2,11 +2,22 @@
 
 #include "srs/utils/CommonDefinitions.hpp"
 #include <cstddef>
+#include <cstdint>
+#include <map>
 #include <string>
 #include <vector>
 
 namespace srs
 {
+    /**
+     * @brief Coincidence rule of the software trigger
+     */
+    struct TriggerRule
+    {
+        std::vector<uint16_t> planes; //!< Detector planes that must all have hits
+        uint64_t window_ps = 0;       //!< Maximum time difference (picoseconds) among the hits of the planes
+    };
+
     /**
      * @class Config
      * @brief Main configuration struct
@@ -53,6 +64,311 @@ namespace srs
          */
         std::size_t output_split = 1;
 
+        /**
+         * @brief Compression algorithm of the Protobuf binary outputs (".binpb" and ".pbc").
+         *
+         * Each output file is compressed as a single stream, whose format can be identified from its first bytes.
+         */
+        common::CompressionType proto_compression = common::CompressionType::zstd;
+
+        /**
+         * @brief Compression level of the Protobuf binary outputs. 0 means the default level of the algorithm.
+         */
+        int proto_compression_level = 0;
+
+        /**
+         * @brief Number of the beginning frames used to train a zstd dictionary. 0 disables the dictionary.
+         *
+         * The dictionary is stored at the beginning of the output file in a zstd skippable frame.
+         */
+        std::size_t proto_compression_dict_frames = 0;
+
+        /**
+         * @brief Uncompressed size (bytes) of the zstd blocks of the raw binary outputs (".bin" and ".lmd"). 0 disables
+         * the compression.
+         *
+         * Each block starts with a zstd skippable frame that records the index of its first frame, followed by an
+         * independent zstd frame. Therefore, the output can also be decompressed with "zstd -d".
+         */
+        std::size_t raw_compression_block_size = 0;
+
+        /**
+         * @brief Compression level of the raw binary outputs. 0 means the default level of zstd.
+         */
+        int raw_compression_level = 0;
+
+        /**
+         * @brief Number of worker threads to compress the blocks of each raw binary output.
+         */
+        std::size_t raw_compression_threads = 2;
+
+        /**
+         * @brief Size (bytes) of the aligned buffers for the direct I/O of the uncompressed binary outputs. 0 disables
+         * the direct I/O.
+         *
+         * Full buffers are written by a background thread to the file opened with O_DIRECT, which bypasses the page
+         * cache. A size of a few MB is recommended.
+         */
+        std::size_t direct_io_buffer_size = 0;
+
+        /**
+         * @brief Number of the direct I/O buffers of each binary output, at least 2.
+         */
+        std::size_t direct_io_n_buffers = 2;
+
+        /**
+         * @brief Disk space (bytes) preallocated at once for each binary output with direct I/O. 0 disables the
+         * preallocation.
+         */
+        std::size_t direct_io_preallocation_size = 0;
+
+        /**
+         * @brief Maximal size (bytes) of each output file before a new file is opened. 0 disables the rotation by size.
+         *
+         * Rotated files are named with a file index of 4 digits before the extension, e.g. "output_0.0002.bin". The
+         * old files are closed by a background thread.
+         */
+        std::size_t output_rotation_size = 0;
+
+        /**
+         * @brief Maximal duration (seconds) of each output file before a new file is opened. 0 disables the rotation
+         * by time.
+         */
+        std::size_t output_rotation_time = 0;
+
+        /**
+         * @brief Shell command executed after each output file is closed. Empty string disables it.
+         *
+         * The filename is available as "$1" in the command. If "$1" is not used, the filename is appended to the
+         * command. For example, "rsync -a --remove-source-files \"$1\" backup:/data/" moves the closed files to
+         * another machine.
+         */
+        std::string output_post_close_command;
+
+        /**
+         * @brief Number of frames of each FEC between two entries of the frame index of each uncompressed binary
+         * output. 0 disables the index.
+         *
+         * The index is written to a sidecar file named after the output file with the extension ".idx". It's used by
+         * the readers to seek by frame, time or FEC, or to split the file for parallel processing. See
+         * srs::reader::FrameIndex.
+         */
+        std::size_t frame_index_interval = 1000;
+
+        /**
+         * @brief Number of frames written together as a record batch to each Parquet or Arrow output (".parquet" and
+         * ".arrow").
+         */
+        std::size_t arrow_batch_size = common::DEFAULT_ARROW_BATCH_SIZE;
+
+        /**
+         * @brief Maximal number of frames in a row group of each Parquet output.
+         *
+         * A row group is the unit of the parallel reading of a Parquet file.
+         */
+        std::size_t parquet_row_group_size = common::DEFAULT_PARQUET_ROW_GROUP_SIZE;
+
+        /**
+         * @brief Compression algorithm of the Parquet and Arrow outputs. Arrow outputs don't support gzip.
+         */
+        common::CompressionType arrow_compression = common::CompressionType::zstd;
+
+        /**
+         * @brief Compression level of the Parquet and Arrow outputs. 0 means the default level of the algorithm.
+         */
+        int arrow_compression_level = 0;
+
+        /**
+         * @brief Number of frames in each block of the compact output (".srsc").
+         *
+         * Blocks are decoded independently and are the unit of seeking in the compact file. Larger blocks compress
+         * slightly better. See srs::reader::CompactFile.
+         */
+        std::size_t compact_block_frames = common::DEFAULT_COMPACT_BLOCK_FRAMES;
+
+        /**
+         * @brief Compression algorithm of the ROOT outputs (".root"). gzip is mapped to the ZLIB algorithm of ROOT.
+         */
+        common::CompressionType root_compression = common::CompressionType::zstd;
+
+        /**
+         * @brief Compression level of the ROOT outputs. 0 means the default level of the algorithm.
+         */
+        int root_compression_level = 0;
+
+        /**
+         * @brief Initial size in bytes of the baskets of each branch in the ROOT outputs.
+         */
+        int root_basket_size = common::DEFAULT_ROOT_BASKET_SIZE;
+
+        /**
+         * @brief Split level of the struct data branch in the ROOT outputs.
+         *
+         * With the default value 99, each member of the struct data, e.g. the ADC values of the hits, is stored in a
+         * separate branch, which is compressed better and can be read independently. 0 stores the whole struct in
+         * a single branch.
+         */
+        int root_split_level = common::DEFAULT_ROOT_SPLIT_LEVEL;
+
+        /**
+         * @brief Number of entries in each cluster of the ROOT outputs. 0 means the default of ROOT.
+         *
+         * The baskets of all branches are flushed to the file at the end of each cluster.
+         */
+        int64_t root_cluster_size = 0;
+
+        /**
+         * @brief Number of threads of the ROOT implicit multithreading, which compress the baskets in parallel. 0
+         * disables it.
+         *
+         * The implicit multithreading is a global state of ROOT. It's enabled once by srs::App::init() and shared by
+         * all ROOT outputs.
+         */
+        unsigned root_n_threads = 0;
+
+        /**
+         * @brief Whether the trees of all pipelines (see #output_split) are merged into a single ROOT file.
+         *
+         * Each pipeline fills its tree in memory, which is merged into the output file by ROOT::TBufferMerger in a
+         * separate thread. Otherwise, each pipeline writes to a separate file. The rotation of the merged file is not
+         * supported.
+         */
+        bool root_merge_lines = false;
+
+        /**
+         * @brief Whether the absolute time of each hit is reconstructed and stored in srs::StructData::hit_time.
+         *
+         * Disabled by default, as each frame is then copied before processing and the outputs contain the extra
+         * column. It's enabled automatically by the strip clustering, the event building and the trigger rules.
+         */
+        bool hit_time_reconstruction = false;
+
+        /**
+         * @brief Period (picoseconds) of the BC clock of the VMMs, used for the hit time reconstruction.
+         */
+        uint64_t bc_clock_period_ps = common::DEFAULT_BC_CLOCK_PERIOD_PS;
+
+        /**
+         * @brief File name of the channel mapping. Empty string disables the channel mapping.
+         *
+         * Each line of the file contains 5 integers: FEC ID, VMM ID, channel number, detector plane ID and detector
+         * strip ID. Empty lines and lines starting with "#" are ignored.
+         */
+        std::string channel_mapping_filename;
+
+        /**
+         * @brief Threshold of the zero suppression in the units of the channel noise. 0 disables the zero suppression.
+         *
+         * Hits with the ADC values below "pedestal + zero_suppression_sigma * noise" of their channels are dropped
+         * before any outputs except the raw data outputs.
+         */
+        double zero_suppression_sigma = 0.;
+
+        /**
+         * @brief File name of the pedestal calibration. Empty string enables the online pedestal estimation.
+         *
+         * Each line of the file contains the FEC ID, VMM ID, channel number, pedestal and noise (standard deviation)
+         * in ADC units. Empty lines and lines starting with "#" are ignored.
+         */
+        std::string pedestal_filename;
+
+        /**
+         * @brief Whether the pedestals are subtracted from the ADC values of the hits surviving the zero suppression.
+         */
+        bool pedestal_subtraction = false;
+
+        /**
+         * @brief Time window (picoseconds) of the strip clustering. 0 disables the strip clustering.
+         *
+         * Hits of the same detector plane within the time window are grouped into clusters of neighbouring strips
+         * (srs::StructData::clusters). The strip clustering requires the channel mapping and the hit time
+         * reconstruction, which is enabled automatically.
+         */
+        uint64_t cluster_time_window_ps = 0;
+
+        /**
+         * @brief Maximum difference of the strip IDs between two neighbouring hits of a cluster.
+         */
+        uint16_t cluster_max_strip_gap = common::DEFAULT_CLUSTER_MAX_STRIP_GAP;
+
+        /**
+         * @brief Whether only the clusters are kept in the outputs of the struct data.
+         *
+         * The hits, including their time, plane and strip, are removed from each frame after the strip clustering
+         * and the event building, which reduces the output size. The markers are kept. Ignored if the strip
+         * clustering is disabled or the software trigger is applied to the hits of each frame.
+         */
+        bool cluster_only_output = false;
+
+        /**
+         * @brief Coincidence window (picoseconds) of the event building. 0 disables the event building.
+         *
+         * Hits from all FECs are merged in time and grouped into events (srs::StructData::events). A new event starts
+         * if a hit comes later than the coincidence window after the first hit of the current event. The event
+         * building requires the hit time reconstruction, which is enabled automatically.
+         */
+        uint64_t event_window_ps = 0;
+
+        /**
+         * @brief Width (picoseconds) of the time slices built in parallel. Events are split at the slice boundaries.
+         */
+        uint64_t event_slice_ps = common::DEFAULT_EVENT_SLICE_PS;
+
+        /**
+         * @brief Maximum number of hits waiting for the event building. The oldest time slices are built earlier if
+         * the limit is reached.
+         */
+        std::size_t event_max_pending_hits = common::DEFAULT_EVENT_MAX_PENDING_HITS;
+
+        /**
+         * @brief Maximum time difference (picoseconds) between a hit and the median hit time of its frame for the event
+         * building. 0 disables the check.
+         *
+         * Hits further away are treated as outliers, e.g. from corrupted timestamps, and dropped from the event
+         * building.
+         */
+        uint64_t event_max_hit_spread_ps = common::DEFAULT_EVENT_MAX_HIT_SPREAD_PS;
+
+        /**
+         * @brief Coincidence rules of the software trigger. Empty list disables the software trigger.
+         *
+         * A frame is accepted if any rule is fulfilled, i.e. all planes of the rule have hits within its time window.
+         * If the event building is enabled, the rules are applied to each built event instead and a frame is accepted
+         * if any of its events is accepted. Only the accepted events of the frame are then forwarded without its hits.
+         * Rejected frames and events are dropped from all outputs except the raw data outputs. The software trigger
+         * requires the channel mapping and the hit time reconstruction, which is enabled automatically.
+         */
+        std::vector<TriggerRule> trigger_rules;
+
+        /**
+         * @brief Whether the software trigger also applies to the raw data outputs.
+         *
+         * Ignored if the event building is enabled, as the events of a frame don't come from its raw data.
+         */
+        bool trigger_raw_output = false;
+
+        /**
+         * @brief Filter expressions of the outputs, keyed by the output names given in the command line.
+         *
+         * For example, "adc > 200 && vmm_id in [0, 3]" only keeps the matching hits and "fec_id == 2" only keeps the
+         * frames from FEC 2. See srs::process::FilterExpression for the syntax. Filters of the raw data outputs are
+         * ignored.
+         */
+        std::map<std::string, std::string> output_filters;
+
+        /**
+         * @brief File name to store the frames that fail to be decoded. Empty string disables the quarantine file.
+         *
+         * Frames are stored with the same format as the raw binary outputs (".bin") and can be read with
+         * srs::reader::RawFrame.
+         */
+        std::string quarantine_filename;
+
+        /**
+         * @brief Maximum size (bytes) of the quarantine file. Further bad frames are only counted.
+         */
+        std::size_t quarantine_max_bytes = common::DEFAULT_QUARANTINE_MAX_BYTES;
+
         /**
          * @brief time (milliseconds) to wait after turning off the srs and before stopping data reading
          */
@@ -0,0 +1,388 @@
+#include "FrameMerger.hpp"
+#include "srs/converters/DataConvertOptions.hpp"
+#include "srs/converters/FrameHeaderParser.hpp"
+#include "srs/converters/ProtoDeserializer.hpp"
+#include "srs/readers/ProtoFrameReader.hpp"
+#include "srs/readers/RawFrameReader.hpp"
+#include "srs/sinks/BinaryFileWriter.hpp"
+#include "srs/sinks/DataWriterOptions.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <fmt/format.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <zpp_bits.h>
+
+namespace srs::merger
+{
+    namespace
+    {
+        auto get_convert_mode(const std::string& filename) -> process::DataConvertOptions
+        {
+            const auto [filetype, convert_mode] = get_filetype_from_filename(filename);
+            if (filetype != DataWriterOption::bin)
+            {
+                throw std::runtime_error{ fmt::format("{:?} is not a binary file", filename) };
+            }
+            return convert_mode;
+        }
+    } // namespace
+
+    /**
+     * @brief One input file of the merger
+     *
+     * The frame counters of each FEC are extended to 64 bits with the number of wrap-arounds observed in the file.
+     */
+    class InputFile
+    {
+      public:
+        InputFile(const std::string& filename, process::DataConvertOptions convert_mode, std::size_t n_threads)
+            : filename_{ filename }
+        {
+            if (convert_mode == process::DataConvertOptions::raw_frame)
+            {
+                raw_reader_ = std::make_unique<reader::RawFrame>(filename, n_threads);
+            }
+            else
+            {
+                proto_reader_ = std::make_unique<reader::ProtoFrame>(filename);
+            }
+        }
+
+        //! Returns an empty frame at the end of the file.
+        auto read() -> std::expected<std::string_view, std::string>
+        {
+            auto frame = (raw_reader_ != nullptr) ? raw_reader_->read_one_frame() : proto_reader_->read_one_message();
+            if (not frame.has_value())
+            {
+                return std::unexpected{ fmt::format("Failed to read {:?}: {}", filename_, frame.error()) };
+            }
+            if (frame->empty())
+            {
+                is_finished_ = true;
+                spdlog::debug("Merger: {} frames are read from the file {:?}", n_frames_read_, filename_);
+            }
+            else
+            {
+                ++n_frames_read_;
+            }
+            return frame;
+        }
+
+        auto extend_counter(uint8_t fec_id, uint32_t frame_counter) -> uint64_t
+        {
+            static constexpr auto HALF_RANGE = uint32_t{ 1 } << 31U;
+            auto& last_counter = last_counters_[fec_id];
+            if (not last_counter.has_value())
+            {
+                last_counter = frame_counter;
+                return frame_counter;
+            }
+            const auto last_low = static_cast<uint32_t>(last_counter.value());
+            auto n_wraps = last_counter.value() >> 32U;
+            if (frame_counter < last_low and last_low - frame_counter >= HALF_RANGE)
+            {
+                ++n_wraps;
+            }
+            else if (frame_counter > last_low and frame_counter - last_low > HALF_RANGE and n_wraps > 0)
+            {
+                // Late frame from before the last wrap-around
+                --n_wraps;
+            }
+            const auto counter = (n_wraps << 32U) | frame_counter;
+            last_counter = std::max(last_counter.value(), counter);
+            return counter;
+        }
+
+        //! The largest extended frame counter of the FEC read so far
+        [[nodiscard]] auto get_last_counter(uint8_t fec_id) const -> std::optional<uint64_t>
+        {
+            return last_counters_[fec_id];
+        }
+
+        [[nodiscard]] auto is_finished() const -> bool { return is_finished_; }
+        [[nodiscard]] auto get_n_frames_read() const -> uint64_t { return n_frames_read_; }
+
+      private:
+        std::string filename_;
+        std::unique_ptr<reader::RawFrame> raw_reader_;
+        std::unique_ptr<reader::ProtoFrame> proto_reader_;
+        std::array<std::optional<uint64_t>, std::numeric_limits<uint8_t>::max() + 1> last_counters_{};
+        bool is_finished_ = false;
+        uint64_t n_frames_read_ = 0;
+    };
+
+    void FrameMerger::OutputFrame::set(std::string_view data, const process::FrameHeaderResult& header)
+    {
+        data_ = data;
+        header_ = header;
+        if (convert_mode_ == process::DataConvertOptions::raw_frame)
+        {
+            auto serialize_to = zpp::bits::out{ size_prefix_, zpp::bits::endian::big{}, zpp::bits::no_size{} };
+            serialize_to(static_cast<common::RawDelimSizeType>(data.size())).or_throw();
+            size_prefix_size_ = sizeof(common::RawDelimSizeType);
+            return;
+        }
+        // NOLINTNEXTLINE (cppcoreguidelines-pro-type-reinterpret-cast)
+        auto* prefix_begin = reinterpret_cast<uint8_t*>(size_prefix_.data());
+        const auto* prefix_end = google::protobuf::io::CodedOutputStream::WriteVarint32ToArray(
+            static_cast<uint32_t>(data.size()), prefix_begin);
+        size_prefix_size_ = static_cast<std::size_t>(prefix_end - prefix_begin);
+    }
+
+    FrameMerger::FrameMerger(const std::vector<std::string>& input_filenames,
+                             const std::string& output_filename,
+                             const Options& options)
+        : convert_mode_{ get_convert_mode(output_filename) }
+        , options_{ options }
+        , output_frame_{ convert_mode_ }
+    {
+        if (input_filenames.empty())
+        {
+            throw std::runtime_error{ "No input files to merge" };
+        }
+        input_files_.reserve(input_filenames.size());
+        for (const auto& filename : input_filenames)
+        {
+            if (get_convert_mode(filename) != convert_mode_)
+            {
+                throw std::runtime_error{ fmt::format(
+                    "Input file {:?} has a different type from the output file {:?}", filename, output_filename) };
+            }
+            input_files_.push_back(std::make_unique<InputFile>(filename, convert_mode_, options_.n_threads));
+        }
+        output_file_ = std::make_unique<sink::BinaryFile>(output_filename,
+                                                          convert_mode_,
+                                                          1,
+                                                          options_.compression,
+                                                          sink::DirectFile::Options{},
+                                                          sink::FileRotator::Options{},
+                                                          options_.index_interval);
+    }
+
+    FrameMerger::~FrameMerger() = default;
+
+    auto FrameMerger::run() -> std::expected<void, std::string>
+    {
+        while (true)
+        {
+            if (auto res = write_ready_frames(); not res.has_value())
+            {
+                return res;
+            }
+            const auto oldest_fec = get_oldest_fec();
+            if (oldest_fec.has_value() and buffer_size_ > options_.max_buffer_size)
+            {
+                if (stat_.n_forced_writes == 0)
+                {
+                    spdlog::warn("Merger: buffer size exceeds {} bytes. Frames may be written out of order.",
+                                 options_.max_buffer_size);
+                }
+                ++stat_.n_forced_writes;
+                if (auto res = write_frame(oldest_fec.value()); not res.has_value())
+                {
+                    return res;
+                }
+                continue;
+            }
+            auto* input_file =
+                get_next_input(oldest_fec.has_value() ? &frame_queues_[oldest_fec.value()].top() : nullptr);
+            if (input_file == nullptr)
+            {
+                break;
+            }
+            if (auto res = read_frame(*input_file); not res.has_value())
+            {
+                return res;
+            }
+        }
+        output_file_->close();
+        return {};
+    }
+
+    auto FrameMerger::read_frame(InputFile& input_file) -> std::expected<void, std::string>
+    {
+        const auto data = input_file.read();
+        if (not data.has_value())
+        {
+            return std::unexpected{ data.error() };
+        }
+        if (data->empty())
+        {
+            return {};
+        }
+        ++stat_.n_frames;
+        stat_.n_bytes += data->size();
+
+        const auto header = (convert_mode_ == process::DataConvertOptions::raw_frame)
+                                ? process::parse_frame_header(data.value())
+                                : process::ProtoDeserializer::parse_header(data.value());
+        if (not header.has_value())
+        {
+            ++stat_.n_invalid_frames;
+            return write(data.value(), header);
+        }
+
+        const auto fec_id = header->fec_id;
+        if (not std::ranges::contains(fec_ids_, fec_id))
+        {
+            fec_ids_.push_back(fec_id);
+        }
+        frame_queues_[fec_id].push(Frame{ .data = std::string{ data.value() },
+                                          .header = header.value(),
+                                          .counter = input_file.extend_counter(fec_id, header->frame_counter),
+                                          .sequence = n_frames_read_ });
+        ++n_frames_read_;
+        buffer_size_ += data->size();
+        stat_.max_buffer_size = std::max(stat_.max_buffer_size, buffer_size_);
+        return {};
+    }
+
+    // A frame is ready if no input file can have any unread frame of the same FEC with a smaller frame counter.
+    auto FrameMerger::is_ready(const Frame& frame) const -> bool
+    {
+        return std::ranges::all_of(input_files_,
+                                   [&frame](const auto& input_file)
+                                   {
+                                       if (input_file->is_finished())
+                                       {
+                                           return true;
+                                       }
+                                       const auto last_counter = input_file->get_last_counter(frame.header.fec_id);
+                                       return last_counter.has_value() and last_counter.value() >= frame.counter;
+                                   });
+    }
+
+    auto FrameMerger::write_ready_frames() -> std::expected<void, std::string>
+    {
+        while (true)
+        {
+            auto next_fec = std::optional<uint8_t>{};
+            for (auto fec_id : fec_ids_)
+            {
+                const auto& queue = frame_queues_[fec_id];
+                if (queue.empty() or not is_ready(queue.top()))
+                {
+                    continue;
+                }
+                if (not next_fec.has_value() or queue.top().sequence < frame_queues_[next_fec.value()].top().sequence)
+                {
+                    next_fec = fec_id;
+                }
+            }
+            if (not next_fec.has_value())
+            {
+                return {};
+            }
+            if (auto res = write_frame(next_fec.value()); not res.has_value())
+            {
+                return res;
+            }
+        }
+    }
+
+    auto FrameMerger::write_frame(uint8_t fec_id) -> std::expected<void, std::string>
+    {
+        auto& queue = frame_queues_[fec_id];
+        const auto& frame = queue.top();
+        auto& last_counter = last_written_counters_[fec_id];
+        auto is_duplicate = false;
+        if (last_counter.has_value())
+        {
+            if (frame.counter == last_counter.value())
+            {
+                is_duplicate = true;
+                ++stat_.n_duplicates;
+                spdlog::debug("Merger: duplicated frame {} of FEC {}", frame.header.frame_counter, fec_id);
+            }
+            else if (frame.counter < last_counter.value())
+            {
+                ++stat_.n_out_of_order;
+            }
+            else if (frame.counter > last_counter.value() + 1)
+            {
+                ++stat_.n_gaps;
+                stat_.n_missing_frames += frame.counter - last_counter.value() - 1;
+                spdlog::debug("Merger: {} frames of FEC {} are missing before the frame {}",
+                              frame.counter - last_counter.value() - 1,
+                              fec_id,
+                              frame.header.frame_counter);
+            }
+        }
+        if (not last_counter.has_value() or frame.counter > last_counter.value())
+        {
+            last_counter = frame.counter;
+        }
+
+        auto res = (is_duplicate and options_.drop_duplicates) ? std::expected<void, std::string>{}
+                                                               : write(frame.data, frame.header);
+        buffer_size_ -= frame.data.size();
+        queue.pop();
+        return res;
+    }
+
+    auto FrameMerger::write(std::string_view data, const process::FrameHeaderResult& header)
+        -> std::expected<void, std::string>
+    {
+        output_frame_.set(data, header);
+        if (auto res = output_file_->run(output_frame_, 0); not res.has_value())
+        {
+            return std::unexpected{ std::string{ res.error() } };
+        }
+        return {};
+    }
+
+    auto FrameMerger::get_oldest_fec() const -> std::optional<uint8_t>
+    {
+        auto oldest_fec = std::optional<uint8_t>{};
+        for (auto fec_id : fec_ids_)
+        {
+            const auto& queue = frame_queues_[fec_id];
+            if (not queue.empty() and (not oldest_fec.has_value() or
+                                       queue.top().sequence < frame_queues_[oldest_fec.value()].top().sequence))
+            {
+                oldest_fec = fec_id;
+            }
+        }
+        return oldest_fec;
+    }
+
+    // The oldest waiting frame is unblocked by reading the files that haven't reached its frame counter. Among them,
+    // the file with the fewest frames read is chosen such that all files are read at a similar pace.
+    auto FrameMerger::get_next_input(const Frame* oldest_frame) const -> InputFile*
+    {
+        auto* next_input = static_cast<InputFile*>(nullptr);
+        for (const auto& input_file : input_files_)
+        {
+            if (input_file->is_finished())
+            {
+                continue;
+            }
+            if (oldest_frame != nullptr)
+            {
+                const auto last_counter = input_file->get_last_counter(oldest_frame->header.fec_id);
+                if (last_counter.has_value() and last_counter.value() >= oldest_frame->counter)
+                {
+                    continue;
+                }
+            }
+            if (next_input == nullptr or input_file->get_n_frames_read() < next_input->get_n_frames_read())
+            {
+                next_input = input_file.get();
+            }
+        }
+        return next_input;
+    }
+} // namespace srs::merger
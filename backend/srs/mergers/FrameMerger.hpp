@@ -0,0 +1,160 @@
+#pragma once
+
+#include "srs/converters/DataConvertOptions.hpp"
+#include "srs/converters/FrameHeaderParser.hpp"
+#include "srs/sinks/BinaryFileWriter.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <optional>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace srs::merger
+{
+    class InputFile;
+
+    /**
+     * @brief K-way merge of the binary output files written by multiple pipelines
+     *
+     * With srs::Config::output_split larger than 1, each pipeline writes the frames it receives to its own file. The
+     * frames of each FEC are in the order of their frame counters within each file, but not across the files. The
+     * merger reads all files in a single pass and writes the frames of each FEC in the order of the frame counters
+     * to one output file. Frames of different FECs are written in the order they are read.
+     *
+     * A frame is written once all other files have read past its frame counter. The frames waiting to be written are
+     * kept in memory up to the maximal buffer size, after which the oldest waiting frame is written regardless. Gaps
+     * and duplicates of the frame counters are detected when the frames are written. The wrap-around of the frame
+     * counters is taken into account.
+     *
+     * Both raw (``.bin`` or ``.lmd``) and Protobuf (``.binpb`` or ``.pbc``) files are supported, as long as the
+     * inputs and the output have the same type. Compressed inputs are decompressed transparently. The output is
+     * written by srs::sink::BinaryFile.
+     */
+    class FrameMerger
+    {
+      public:
+        static constexpr auto DEFAULT_MAX_BUFFER_SIZE = std::size_t{ 256 } * 1024 * 1024;
+
+        struct Options
+        {
+            std::size_t max_buffer_size = DEFAULT_MAX_BUFFER_SIZE; //!< Maximal bytes of the frames kept in memory
+            bool drop_duplicates = false;                          //!< Whether the duplicated frames are not written
+            std::size_t n_threads = 1;                             //!< to decompress the raw input blocks
+            sink::BinaryFileCompression compression;               //!< of the output file
+            std::size_t index_interval = 0; //!< of the output file. 0 disables the index.
+        };
+
+        struct Stat
+        {
+            std::size_t n_frames = 0;         //!< Number of frames read from the input files
+            std::size_t n_bytes = 0;          //!< Number of bytes of the frames read from the input files
+            std::size_t n_duplicates = 0;     //!< Frames with the same frame counter as the previous one of the FEC
+            std::size_t n_gaps = 0;           //!< Number of gaps in the frame counters
+            std::size_t n_missing_frames = 0; //!< Number of frames missing in the gaps
+            std::size_t n_out_of_order = 0;   //!< Frames written after a frame with a larger frame counter
+            std::size_t n_invalid_frames = 0; //!< Frames without valid headers, which are written directly
+            std::size_t n_forced_writes = 0;  //!< Frames written due to the full buffer
+            std::size_t max_buffer_size = 0;  //!< Maximal number of bytes kept in memory
+        };
+
+        /**
+         * @brief Constructor that opens all input files and the output file.
+         *
+         * Throws if any file cannot be opened or the files have different types.
+         *
+         * @param input_filenames Files to be merged, e.g. "output_0.bin", "output_1.bin", ...
+         * @param output_filename Merged output file
+         * @param options Merging options
+         */
+        FrameMerger(const std::vector<std::string>& input_filenames,
+                    const std::string& output_filename,
+                    const Options& options);
+
+        FrameMerger(const FrameMerger&) = delete;
+        FrameMerger(FrameMerger&&) = delete;
+        FrameMerger& operator=(const FrameMerger&) = delete;
+        FrameMerger& operator=(FrameMerger&&) = delete;
+        ~FrameMerger();
+
+        //! Merge all frames and close the output file.
+        auto run() -> std::expected<void, std::string>;
+
+        [[nodiscard]] auto get_stat() const -> const Stat& { return stat_; }
+
+      private:
+        static constexpr auto N_FECS = std::size_t{ 256 };
+
+        struct Frame
+        {
+            std::string data;
+            ReceiveDataHeader header;
+            uint64_t counter = 0;  //!< Frame counter extended with the number of wrap-arounds
+            uint64_t sequence = 0; //!< Order in which the frames are read
+        };
+
+        struct LaterFrame
+        {
+            auto operator()(const Frame& left, const Frame& right) const -> bool
+            {
+                return (left.counter == right.counter) ? left.sequence > right.sequence : left.counter > right.counter;
+            }
+        };
+
+        using FrameQueue = std::priority_queue<Frame, std::vector<Frame>, LaterFrame>;
+
+        // Frames of the output file, provided to srs::sink::BinaryFile
+        class OutputFrame
+        {
+          public:
+            explicit OutputFrame(process::DataConvertOptions convert_mode)
+                : convert_mode_{ convert_mode }
+            {
+            }
+
+            void set(std::string_view data, const process::FrameHeaderResult& header);
+
+            [[nodiscard]] auto operator()(std::size_t /*line_number*/) const -> std::string_view { return data_; }
+            [[nodiscard]] auto get_size_prefix(std::size_t /*line_number*/) const -> std::string_view
+            {
+                return std::string_view{ size_prefix_.data(), size_prefix_size_ };
+            }
+            [[nodiscard]] auto get_frame_header(std::size_t /*line_number*/) const -> process::FrameHeaderResult
+            {
+                return header_;
+            }
+
+          private:
+            process::DataConvertOptions convert_mode_;
+            std::string_view data_;
+            process::FrameHeaderResult header_;
+            std::array<char, sizeof(uint64_t)> size_prefix_{};
+            std::size_t size_prefix_size_ = 0;
+        };
+
+        process::DataConvertOptions convert_mode_ = process::DataConvertOptions::raw_frame;
+        Options options_;
+        Stat stat_;
+        std::vector<std::unique_ptr<InputFile>> input_files_;
+        std::unique_ptr<sink::BinaryFile> output_file_;
+        OutputFrame output_frame_;
+        std::array<FrameQueue, N_FECS> frame_queues_;
+        std::array<std::optional<uint64_t>, N_FECS> last_written_counters_;
+        std::vector<uint8_t> fec_ids_;
+        std::size_t buffer_size_ = 0;
+        uint64_t n_frames_read_ = 0;
+
+        auto read_frame(InputFile& input_file) -> std::expected<void, std::string>;
+        auto write_ready_frames() -> std::expected<void, std::string>;
+        auto write_frame(uint8_t fec_id) -> std::expected<void, std::string>;
+        auto write(std::string_view data, const process::FrameHeaderResult& header)
+            -> std::expected<void, std::string>;
+        [[nodiscard]] auto is_ready(const Frame& frame) const -> bool;
+        [[nodiscard]] auto get_oldest_fec() const -> std::optional<uint8_t>;
+        [[nodiscard]] auto get_next_input(const Frame* oldest_frame) const -> InputFile*;
+    };
+} // namespace srs::merger
@@ -0,0 +1,130 @@
+#include "ChannelMapper.hpp"
+#include "srs/data/SRSDataCompact.hpp"
+#include "srs/data/SRSDataStructs.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fmt/format.h>
+#include <fstream>
+#include <ranges>
+#include <spdlog/spdlog.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace srs::process
+{
+    namespace
+    {
+        constexpr auto CHANNELS_PER_FEC = std::size_t{ 1 }
+                                          << (internal::VMM_ID_BIT_LENGTH + internal::CHANNEL_NUM_BIT_LENGTH);
+    } // namespace
+
+    ChannelMapper::ChannelMapper(const std::string& filename)
+    {
+        fec_indices_.fill(NO_FEC_INDEX);
+        auto input_file = std::ifstream{ filename };
+        if (not input_file.is_open())
+        {
+            throw std::runtime_error{ fmt::format("Cannot open the channel mapping file {:?}", filename) };
+        }
+
+        auto line = std::string{};
+        for (auto line_number = 1; std::getline(input_file, line); ++line_number)
+        {
+            auto line_stream = std::istringstream{ line };
+            auto first_char = char{};
+            if (not(line_stream >> first_char) or first_char == '#')
+            {
+                continue;
+            }
+            line_stream.unget();
+
+            auto fec_id = uint32_t{};
+            auto vmm_id = uint32_t{};
+            auto channel_num = uint32_t{};
+            auto plane = uint32_t{};
+            auto strip = uint32_t{};
+            line_stream >> fec_id >> vmm_id >> channel_num >> plane >> strip;
+            if (line_stream.fail() or fec_id >= fec_indices_.size() or vmm_id > internal::VMM_ID_BIT_MAX or
+                channel_num > internal::CHANNEL_NUM_BIT_MAX or plane >= common::UNMAPPED_PLANE_ID or
+                strip >= common::UNMAPPED_STRIP_ID)
+            {
+                throw std::runtime_error{ fmt::format(
+                    "Invalid channel mapping at line {} of the file {:?}: {:?}", line_number, filename, line) };
+            }
+            add_channel(static_cast<uint8_t>(fec_id),
+                        static_cast<uint8_t>(vmm_id),
+                        static_cast<uint8_t>(channel_num),
+                        StripID{ .strip = static_cast<uint16_t>(strip), .plane = static_cast<uint8_t>(plane) });
+        }
+        spdlog::info("Channel mapping: {} channels from {} FECs are loaded from the file {:?}",
+                     n_channels_,
+                     table_.size() / CHANNELS_PER_FEC,
+                     filename);
+    }
+
+    void ChannelMapper::add_channel(uint8_t fec_id, uint8_t vmm_id, uint8_t channel_num, StripID strip_id)
+    {
+        auto& fec_index = fec_indices_[fec_id];
+        if (fec_index == NO_FEC_INDEX)
+        {
+            fec_index = static_cast<uint16_t>(table_.size() / CHANNELS_PER_FEC);
+            table_.resize(table_.size() + CHANNELS_PER_FEC);
+        }
+        auto& entry = table_[(fec_index * CHANNELS_PER_FEC) + get_channel_index(vmm_id, channel_num)];
+        if (entry.plane != common::UNMAPPED_PLANE_ID)
+        {
+            spdlog::warn("Channel mapping: FEC {}, VMM {}, channel {} is mapped more than once. The last one is used.",
+                         fec_id,
+                         vmm_id,
+                         channel_num);
+        }
+        else
+        {
+            ++n_channels_;
+        }
+        entry = strip_id;
+    }
+
+    auto ChannelMapper::get_channel_index(uint8_t vmm_id, uint8_t channel_num) -> std::size_t
+    {
+        return (static_cast<std::size_t>(vmm_id & internal::VMM_ID_BIT_MAX) << internal::CHANNEL_NUM_BIT_LENGTH) |
+               (channel_num & internal::CHANNEL_NUM_BIT_MAX);
+    }
+
+    auto ChannelMapper::get_strip_id(uint8_t fec_id, uint8_t vmm_id, uint8_t channel_num) const -> StripID
+    {
+        const auto fec_index = fec_indices_[fec_id];
+        if (fec_index == NO_FEC_INDEX)
+        {
+            return StripID{};
+        }
+        return table_[(fec_index * CHANNELS_PER_FEC) + get_channel_index(vmm_id, channel_num)];
+    }
+
+    void ChannelMapper::process(StructData& struct_data) const
+    {
+        const auto n_hits = struct_data.hit_data.size();
+        struct_data.hit_plane.resize(n_hits);
+        struct_data.hit_strip.resize(n_hits);
+        const auto fec_index = fec_indices_[struct_data.header.fec_id];
+        if (fec_index == NO_FEC_INDEX)
+        {
+            std::ranges::fill(struct_data.hit_plane, common::UNMAPPED_PLANE_ID);
+            std::ranges::fill(struct_data.hit_strip, common::UNMAPPED_STRIP_ID);
+            return;
+        }
+
+        // All hits of a frame come from the same FEC.
+        const auto* fec_table = &table_[fec_index * CHANNELS_PER_FEC];
+        for (const auto [hit, plane, strip] :
+             std::views::zip(struct_data.hit_data, struct_data.hit_plane, struct_data.hit_strip))
+        {
+            const auto& strip_id = fec_table[get_channel_index(hit.vmm_id, hit.channel_num)];
+            plane = strip_id.plane;
+            strip = strip_id.strip;
+        }
+    }
+} // namespace srs::process
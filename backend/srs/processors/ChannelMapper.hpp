@@ -0,0 +1,56 @@
+#pragma once
+
+#include "srs/data/SRSDataStructs.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace srs::process
+{
+    /**
+     * @brief Mapping from the electronic channels (FEC ID, VMM ID and channel number) to the detector strips
+     *
+     * The mapping file is loaded into a dense lookup table when constructed. Only FECs present in the mapping file
+     * take space in the table, which has 2048 entries of 4 bytes for each FEC. Hits missing in the mapping are
+     * assigned with common::UNMAPPED_PLANE_ID and common::UNMAPPED_STRIP_ID.
+     */
+    class ChannelMapper
+    {
+      public:
+        struct StripID
+        {
+            uint16_t strip = common::UNMAPPED_STRIP_ID;
+            uint8_t plane = common::UNMAPPED_PLANE_ID;
+        };
+
+        /**
+         * @brief Constructor that loads the mapping file.
+         *
+         * Each line of the file contains 5 integers: FEC ID, VMM ID, channel number, plane ID and strip ID. Empty
+         * lines and lines starting with "#" are ignored. Throws std::runtime_error if the file cannot be read or
+         * contains an invalid line.
+         *
+         * @param filename File name of the mapping file
+         */
+        explicit ChannelMapper(const std::string& filename);
+
+        //! Fill StructData::hit_plane and StructData::hit_strip from the hits of the frame
+        void process(StructData& struct_data) const;
+
+        [[nodiscard]] auto get_strip_id(uint8_t fec_id, uint8_t vmm_id, uint8_t channel_num) const -> StripID;
+        [[nodiscard]] auto get_n_channels() const -> std::size_t { return n_channels_; }
+
+      private:
+        // Out of the range of the FEC indices, which go up to 255 if all FEC IDs are mapped.
+        static constexpr auto NO_FEC_INDEX = uint16_t{ 0xffff };
+        std::size_t n_channels_ = 0;
+        std::array<uint16_t, std::size_t{ 1 } << common::FEC_ID_BIT_LENGTH> fec_indices_{};
+        std::vector<StripID> table_;
+
+        void add_channel(uint8_t fec_id, uint8_t vmm_id, uint8_t channel_num, StripID strip_id);
+        static auto get_channel_index(uint8_t vmm_id, uint8_t channel_num) -> std::size_t;
+    };
+} // namespace srs::process
@@ -0,0 +1,207 @@
+#include "EventBuilder.hpp"
+#include "srs/data/SRSDataStructs.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <spdlog/spdlog.h>
+#include <utility>
+#include <vector>
+
+namespace srs::process
+{
+    EventBuilder::EventBuilder(const Options& options)
+        : options_{ options }
+    {
+        options_.slice_ps = std::max(options_.slice_ps, options_.window_ps);
+        spdlog::info("Event building: coincidence window of {} ps with time slices of {} ps",
+                     options_.window_ps,
+                     options_.slice_ps);
+    }
+
+    EventBuilder::~EventBuilder()
+    {
+        spdlog::info("Event building: {} events are built. {} hits arrived too late. {} hits are outliers in time. {} "
+                     "hits are still pending at the end.",
+                     n_events_.load(),
+                     n_late_hits_.load(),
+                     n_outlier_hits_.load(),
+                     n_pending_hits_);
+    }
+
+    void EventBuilder::process(StructData& struct_data)
+    {
+        auto closed_slices = std::vector<Slice>{};
+        add_hits(struct_data, closed_slices);
+
+        // Slices closed by different pipelines are built in parallel.
+        auto events = build_slices(closed_slices);
+
+        auto lock = std::lock_guard{ event_mutex_ };
+        built_events_.insert(
+            built_events_.end(), std::make_move_iterator(events.begin()), std::make_move_iterator(events.end()));
+        struct_data.events = std::move(built_events_);
+        built_events_.clear();
+    }
+
+    auto EventBuilder::flush() -> std::vector<EventData>
+    {
+        auto closed_slices = std::vector<Slice>{};
+        {
+            auto lock = std::lock_guard{ slice_mutex_ };
+            for (auto& [slice_index, slice] : slices_)
+            {
+                closed_slices.push_back(std::move(slice));
+                has_closed_slice_ = true;
+                last_closed_slice_index_ = slice_index;
+            }
+            slices_.clear();
+            n_pending_hits_ = 0;
+        }
+        auto events = build_slices(closed_slices);
+
+        auto lock = std::lock_guard{ event_mutex_ };
+        events.insert(events.begin(),
+                      std::make_move_iterator(built_events_.begin()),
+                      std::make_move_iterator(built_events_.end()));
+        built_events_.clear();
+        return events;
+    }
+
+    auto EventBuilder::build_slices(std::vector<Slice>& slices) -> std::vector<EventData>
+    {
+        auto events = std::vector<EventData>{};
+        for (auto& slice : slices)
+        {
+            auto slice_events = build_events(slice);
+            events.insert(events.end(),
+                          std::make_move_iterator(slice_events.begin()),
+                          std::make_move_iterator(slice_events.end()));
+        }
+        return events;
+    }
+
+    auto EventBuilder::get_median_time(std::span<const uint64_t> hit_times) -> uint64_t
+    {
+        if (hit_times.empty())
+        {
+            return 0;
+        }
+        // The lower median is used, which is the earlier hit if there are only two.
+        auto sorted_times = std::vector<uint64_t>(hit_times.begin(), hit_times.end());
+        const auto median = sorted_times.begin() + static_cast<std::ptrdiff_t>((sorted_times.size() - 1) / 2);
+        std::ranges::nth_element(sorted_times, median);
+        return *median;
+    }
+
+    void EventBuilder::add_hits(const StructData& struct_data, std::vector<Slice>& closed_slices)
+    {
+        const auto fec_id = struct_data.header.fec_id;
+        const auto n_hits = struct_data.hit_data.size();
+        const auto is_mapped = struct_data.hit_plane.size() == n_hits and struct_data.hit_strip.size() == n_hits;
+        const auto reference_time = options_.max_hit_spread_ps > 0 ? get_median_time(struct_data.hit_time) : uint64_t{};
+        auto max_slice_index = std::optional<uint64_t>{};
+
+        auto lock = std::lock_guard{ slice_mutex_ };
+        for (auto idx = std::size_t{}; idx < n_hits; ++idx)
+        {
+            const auto& hit = struct_data.hit_data[idx];
+            const auto time = struct_data.hit_time[idx];
+            const auto time_diff = (time > reference_time) ? time - reference_time : reference_time - time;
+            if (options_.max_hit_spread_ps > 0 and time_diff > options_.max_hit_spread_ps)
+            {
+                ++n_outlier_hits_;
+                continue;
+            }
+            const auto slice_index = time / options_.slice_ps;
+            if (has_closed_slice_ and slice_index <= last_closed_slice_index_)
+            {
+                ++n_late_hits_;
+                continue;
+            }
+            auto& event_hit = slices_[slice_index][fec_id].emplace_back();
+            event_hit.time = time;
+            event_hit.fec_id = fec_id;
+            event_hit.vmm_id = hit.vmm_id;
+            event_hit.channel_num = hit.channel_num;
+            event_hit.adc = hit.adc;
+            if (is_mapped)
+            {
+                event_hit.plane = struct_data.hit_plane[idx];
+                event_hit.strip = struct_data.hit_strip[idx];
+            }
+            ++n_pending_hits_;
+            max_slice_index = std::max(max_slice_index.value_or(slice_index), slice_index);
+        }
+        if (max_slice_index.has_value())
+        {
+            auto& fec_slice_index = fec_slice_indices_[fec_id];
+            fec_slice_index = std::max(fec_slice_index, max_slice_index.value());
+        }
+
+        // Slices are only complete if the slowest FEC has moved beyond them.
+        const auto low_slice_index =
+            fec_slice_indices_.empty() ? uint64_t{} : std::ranges::min(fec_slice_indices_ | std::views::values);
+        while (not slices_.empty() and
+               (slices_.begin()->first + 1 < low_slice_index or n_pending_hits_ > options_.max_pending_hits))
+        {
+            auto node = slices_.extract(slices_.begin());
+            for (const auto& [fec, hits] : node.mapped())
+            {
+                n_pending_hits_ -= hits.size();
+            }
+            has_closed_slice_ = true;
+            last_closed_slice_index_ = node.key();
+            closed_slices.push_back(std::move(node.mapped()));
+        }
+    }
+
+    auto EventBuilder::build_events(Slice& slice) -> std::vector<EventData>
+    {
+        // Hits of the same FEC may come from different pipelines and are not ordered.
+        auto runs = std::vector<std::span<const EventHitData>>{};
+        runs.reserve(slice.size());
+        for (auto& [fec, hits] : slice)
+        {
+            std::ranges::sort(hits, std::less{}, &EventHitData::time);
+            runs.emplace_back(hits);
+        }
+
+        // k-way merge with a min-heap on the time of the first remaining hit of each FEC
+        auto heap_compare = [](const std::span<const EventHitData>& left, const std::span<const EventHitData>& right)
+        { return left.front().time > right.front().time; };
+        std::ranges::make_heap(runs, heap_compare);
+
+        auto events = std::vector<EventData>{};
+        while (not runs.empty())
+        {
+            std::ranges::pop_heap(runs, heap_compare);
+            auto& run = runs.back();
+            const auto& hit = run.front();
+            if (events.empty() or hit.time - events.back().start_time > options_.window_ps)
+            {
+                auto& event = events.emplace_back();
+                event.event_id = n_events_++;
+                event.start_time = hit.time;
+            }
+            events.back().hits.push_back(hit);
+
+            run = run.subspan(1);
+            if (run.empty())
+            {
+                runs.pop_back();
+            }
+            else
+            {
+                std::ranges::push_heap(runs, heap_compare);
+            }
+        }
+        return events;
+    }
+} // namespace srs::process
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "srs/data/SRSDataStructs.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace srs::process
+{
+    /**
+     * @brief Event building of the hits from all FECs and pipelines
+     *
+     * Hits are collected into time slices, shared by all pipelines. Each FEC has its own progress, i.e. the latest
+     * slice of its hits. A slice is closed once all FECs have moved two slices further, or earlier if the number of
+     * pending hits exceeds the limit. The hits of a closed slice are sorted for each FEC and combined with a k-way
+     * merge, then grouped into events with the coincidence window. Different slices are built in parallel by the
+     * pipelines that close them. The built events are attached to the next frames going through any pipeline.
+     *
+     * Hits arriving after their slice was closed are dropped and counted. Hits further than Options::max_hit_spread_ps
+     * from the median hit time of their frame are outliers, e.g. from a corrupted timestamp, which are dropped and
+     * counted as well, such that they don't close the slices of the other hits. The median is used such that a single
+     * corrupted timestamp, even an early one, doesn't turn the other hits into outliers. Events are split at the slice
+     * boundaries, so the slice width should be much larger than the coincidence window.
+     */
+    class EventBuilder
+    {
+      public:
+        struct Options
+        {
+            uint64_t window_ps = 0;
+            uint64_t slice_ps = common::DEFAULT_EVENT_SLICE_PS;
+            std::size_t max_pending_hits = common::DEFAULT_EVENT_MAX_PENDING_HITS;
+            uint64_t max_hit_spread_ps = common::DEFAULT_EVENT_MAX_HIT_SPREAD_PS; //!< 0 disables the outlier check
+        };
+
+        explicit EventBuilder(const Options& options);
+        EventBuilder(const EventBuilder&) = delete;
+        EventBuilder(EventBuilder&&) = delete;
+        EventBuilder& operator=(const EventBuilder&) = delete;
+        EventBuilder& operator=(EventBuilder&&) = delete;
+        ~EventBuilder();
+
+        //! Add the hits of the frame, which must have the hit time, and attach the built events to it. Thread safe.
+        void process(StructData& struct_data);
+
+        //! Build all pending slices at the end of the run. Returns their events and the events not attached yet.
+        auto flush() -> std::vector<EventData>;
+
+        [[nodiscard]] auto get_n_events() const -> uint64_t { return n_events_.load(); }
+        [[nodiscard]] auto get_n_late_hits() const -> uint64_t { return n_late_hits_.load(); }
+        [[nodiscard]] auto get_n_outlier_hits() const -> uint64_t { return n_outlier_hits_.load(); }
+
+      private:
+        // Hits of each FEC in a time slice
+        using Slice = std::map<uint8_t, std::vector<EventHitData>>;
+
+        Options options_;
+        std::mutex slice_mutex_;
+        std::map<uint64_t, Slice> slices_;
+        std::size_t n_pending_hits_ = 0;
+        // Latest slice index of the hits from each FEC
+        std::map<uint8_t, uint64_t> fec_slice_indices_;
+        bool has_closed_slice_ = false;
+        uint64_t last_closed_slice_index_ = 0;
+
+        std::mutex event_mutex_;
+        std::vector<EventData> built_events_;
+
+        std::atomic<uint64_t> n_events_ = 0;
+        std::atomic<uint64_t> n_late_hits_ = 0;
+        std::atomic<uint64_t> n_outlier_hits_ = 0;
+
+        static auto get_median_time(std::span<const uint64_t> hit_times) -> uint64_t;
+        void add_hits(const StructData& struct_data, std::vector<Slice>& closed_slices);
+        auto build_events(Slice& slice) -> std::vector<EventData>;
+        auto build_slices(std::vector<Slice>& slices) -> std::vector<EventData>;
+    };
+} // namespace srs::process
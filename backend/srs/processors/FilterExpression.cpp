@@ -0,0 +1,454 @@
+#include "FilterExpression.hpp"
+#include "srs/data/SRSDataStructs.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <fmt/format.h>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace srs::process
+{
+    namespace
+    {
+        using ValueType = FilterExpression::ValueType;
+        using Mask = std::vector<uint8_t>;
+
+        enum class FieldId : uint8_t
+        {
+            fec_id,
+            frame_counter,
+            udp_timestamp,
+            overflow,
+            n_hits,
+            is_over_threshold,
+            channel_num,
+            tdc,
+            offset,
+            vmm_id,
+            adc,
+            bc_id,
+            time,
+            plane,
+            strip
+        };
+
+        struct FieldInfo
+        {
+            std::string_view name;
+            FieldId id = FieldId::fec_id;
+            bool is_hit_level = false;
+        };
+
+        constexpr auto FIELDS = std::array{
+            FieldInfo{ .name = "fec_id", .id = FieldId::fec_id, .is_hit_level = false },
+            FieldInfo{ .name = "frame_counter", .id = FieldId::frame_counter, .is_hit_level = false },
+            FieldInfo{ .name = "udp_timestamp", .id = FieldId::udp_timestamp, .is_hit_level = false },
+            FieldInfo{ .name = "overflow", .id = FieldId::overflow, .is_hit_level = false },
+            FieldInfo{ .name = "n_hits", .id = FieldId::n_hits, .is_hit_level = false },
+            FieldInfo{ .name = "is_over_threshold", .id = FieldId::is_over_threshold, .is_hit_level = true },
+            FieldInfo{ .name = "channel_num", .id = FieldId::channel_num, .is_hit_level = true },
+            FieldInfo{ .name = "tdc", .id = FieldId::tdc, .is_hit_level = true },
+            FieldInfo{ .name = "offset", .id = FieldId::offset, .is_hit_level = true },
+            FieldInfo{ .name = "vmm_id", .id = FieldId::vmm_id, .is_hit_level = true },
+            FieldInfo{ .name = "adc", .id = FieldId::adc, .is_hit_level = true },
+            FieldInfo{ .name = "bc_id", .id = FieldId::bc_id, .is_hit_level = true },
+            FieldInfo{ .name = "time", .id = FieldId::time, .is_hit_level = true },
+            FieldInfo{ .name = "plane", .id = FieldId::plane, .is_hit_level = true },
+            FieldInfo{ .name = "strip", .id = FieldId::strip, .is_hit_level = true },
+        };
+
+        enum class CompareOp : uint8_t
+        {
+            equal,
+            not_equal,
+            less,
+            less_equal,
+            greater,
+            greater_equal
+        };
+
+        auto get_frame_value(FieldId field, const StructData& struct_data) -> ValueType
+        {
+            switch (field)
+            {
+                case FieldId::fec_id:
+                    return struct_data.header.fec_id;
+                case FieldId::frame_counter:
+                    return struct_data.header.frame_counter;
+                case FieldId::udp_timestamp:
+                    return struct_data.header.udp_timestamp;
+                case FieldId::overflow:
+                    return struct_data.header.overflow;
+                case FieldId::n_hits:
+                    return struct_data.hit_data.size();
+                default:
+                    return 0;
+            }
+        }
+
+        // Optional columns are shorter than the hits if the corresponding processing stage is disabled.
+        template <typename T>
+        void load_optional_column(const std::vector<T>& input, ValueType default_value, std::vector<ValueType>& column)
+        {
+            const auto n_values = std::min(input.size(), column.size());
+            std::ranges::copy(input.begin(), input.begin() + static_cast<std::ptrdiff_t>(n_values), column.begin());
+            std::fill(column.begin() + static_cast<std::ptrdiff_t>(n_values), column.end(), default_value);
+        }
+
+        void load_hit_column(FieldId field, const StructData& struct_data, std::vector<ValueType>& column)
+        {
+            const auto& hits = struct_data.hit_data;
+            column.resize(hits.size());
+            auto load = [&hits, &column](auto getter) { std::ranges::transform(hits, column.begin(), getter); };
+            switch (field)
+            {
+                case FieldId::is_over_threshold:
+                    load([](const HitData& hit) -> ValueType { return hit.is_over_threshold ? 1U : 0U; });
+                    break;
+                case FieldId::channel_num:
+                    load([](const HitData& hit) -> ValueType { return hit.channel_num; });
+                    break;
+                case FieldId::tdc:
+                    load([](const HitData& hit) -> ValueType { return hit.tdc; });
+                    break;
+                case FieldId::offset:
+                    load([](const HitData& hit) -> ValueType { return hit.offset; });
+                    break;
+                case FieldId::vmm_id:
+                    load([](const HitData& hit) -> ValueType { return hit.vmm_id; });
+                    break;
+                case FieldId::adc:
+                    load([](const HitData& hit) -> ValueType { return hit.adc; });
+                    break;
+                case FieldId::bc_id:
+                    load([](const HitData& hit) -> ValueType { return hit.bc_id; });
+                    break;
+                case FieldId::time:
+                    load_optional_column(struct_data.hit_time, ValueType{}, column);
+                    break;
+                case FieldId::plane:
+                    load_optional_column(struct_data.hit_plane, common::UNMAPPED_PLANE_ID, column);
+                    break;
+                case FieldId::strip:
+                    load_optional_column(struct_data.hit_strip, common::UNMAPPED_STRIP_ID, column);
+                    break;
+                default:
+                    std::ranges::fill(column, get_frame_value(field, struct_data));
+                    break;
+            }
+        }
+
+        template <typename Compare>
+        void compare_column(std::span<const ValueType> column, ValueType value, Mask& mask)
+        {
+            std::ranges::transform(column,
+                                   mask.begin(),
+                                   [value](ValueType element) -> uint8_t { return Compare{}(element, value) ? 1 : 0; });
+        }
+
+        void compare_column(CompareOp compare_op, std::span<const ValueType> column, ValueType value, Mask& mask)
+        {
+            switch (compare_op)
+            {
+                case CompareOp::equal:
+                    compare_column<std::equal_to<>>(column, value, mask);
+                    break;
+                case CompareOp::not_equal:
+                    compare_column<std::not_equal_to<>>(column, value, mask);
+                    break;
+                case CompareOp::less:
+                    compare_column<std::less<>>(column, value, mask);
+                    break;
+                case CompareOp::less_equal:
+                    compare_column<std::less_equal<>>(column, value, mask);
+                    break;
+                case CompareOp::greater:
+                    compare_column<std::greater<>>(column, value, mask);
+                    break;
+                case CompareOp::greater_equal:
+                    compare_column<std::greater_equal<>>(column, value, mask);
+                    break;
+            }
+        }
+    } // namespace
+
+    // Recursive descent parser emitting the program in postfix order
+    class FilterExpression::Parser
+    {
+      public:
+        Parser(std::string_view expression, FilterExpression& filter_expression)
+            : expression_{ expression }
+            , filter_expression_{ &filter_expression }
+        {
+        }
+
+        void parse()
+        {
+            parse_or();
+            skip_spaces();
+            if (position_ != expression_.size())
+            {
+                throw_error("unexpected characters");
+            }
+        }
+
+      private:
+        std::string_view expression_;
+        std::size_t position_ = 0;
+        FilterExpression* filter_expression_ = nullptr;
+
+        [[noreturn]] void throw_error(std::string_view message) const
+        {
+            throw std::runtime_error{ fmt::format(
+                "Invalid filter expression {:?} at position {}: {}", expression_, position_, message) };
+        }
+
+        void emit(OpCode op_code) { filter_expression_->program_.push_back(Instruction{ .op_code = op_code }); }
+
+        void skip_spaces()
+        {
+            while (position_ < expression_.size() and
+                   std::isspace(static_cast<unsigned char>(expression_[position_])) != 0)
+            {
+                ++position_;
+            }
+        }
+
+        auto consume(std::string_view token) -> bool
+        {
+            skip_spaces();
+            if (expression_.substr(position_).starts_with(token))
+            {
+                position_ += token.size();
+                return true;
+            }
+            return false;
+        }
+
+        void expect(std::string_view token)
+        {
+            if (not consume(token))
+            {
+                throw_error(fmt::format("{:?} is expected", token));
+            }
+        }
+
+        void parse_or()
+        {
+            parse_and();
+            while (consume("||"))
+            {
+                parse_and();
+                emit(OpCode::logical_or);
+            }
+        }
+
+        void parse_and()
+        {
+            parse_unary();
+            while (consume("&&"))
+            {
+                parse_unary();
+                emit(OpCode::logical_and);
+            }
+        }
+
+        void parse_unary()
+        {
+            if (consume("!"))
+            {
+                parse_unary();
+                emit(OpCode::logical_not);
+                return;
+            }
+            if (consume("("))
+            {
+                parse_or();
+                expect(")");
+                return;
+            }
+            parse_comparison();
+        }
+
+        void parse_comparison()
+        {
+            const auto& field = parse_field();
+            filter_expression_->is_hit_level_ |= field.is_hit_level;
+            auto instruction = Instruction{ .field = static_cast<uint8_t>(field.id) };
+            if (consume("in"))
+            {
+                expect("[");
+                auto values = std::vector<ValueType>{ parse_value() };
+                while (consume(","))
+                {
+                    values.push_back(parse_value());
+                }
+                expect("]");
+                std::ranges::sort(values);
+                auto& value_sets = filter_expression_->value_sets_;
+                instruction.op_code = OpCode::contain;
+                instruction.value = value_sets.size();
+                value_sets.push_back(std::move(values));
+            }
+            else
+            {
+                instruction.op_code = OpCode::compare;
+                instruction.compare_op = static_cast<uint8_t>(parse_operator());
+                instruction.value = parse_value();
+            }
+            filter_expression_->program_.push_back(instruction);
+        }
+
+        auto parse_field() -> const FieldInfo&
+        {
+            skip_spaces();
+            const auto name_begin = position_;
+            while (position_ < expression_.size() and
+                   (std::isalnum(static_cast<unsigned char>(expression_[position_])) != 0 or
+                    expression_[position_] == '_'))
+            {
+                ++position_;
+            }
+            const auto name = expression_.substr(name_begin, position_ - name_begin);
+            if (name.empty())
+            {
+                throw_error("field name is expected");
+            }
+            const auto* field = std::ranges::find(FIELDS, name, &FieldInfo::name);
+            if (field == FIELDS.end())
+            {
+                position_ = name_begin;
+                throw_error(fmt::format("unknown field {:?}", name));
+            }
+            return *field;
+        }
+
+        auto parse_operator() -> CompareOp
+        {
+            // Two-character operators must be checked first.
+            using namespace std::string_view_literals;
+            static constexpr auto operators = std::array{ std::pair{ "=="sv, CompareOp::equal },
+                                                          std::pair{ "!="sv, CompareOp::not_equal },
+                                                          std::pair{ "<="sv, CompareOp::less_equal },
+                                                          std::pair{ ">="sv, CompareOp::greater_equal },
+                                                          std::pair{ "<"sv, CompareOp::less },
+                                                          std::pair{ ">"sv, CompareOp::greater } };
+            for (const auto& [token, compare_op] : operators)
+            {
+                if (consume(token))
+                {
+                    return compare_op;
+                }
+            }
+            throw_error("comparison operator is expected");
+        }
+
+        auto parse_value() -> ValueType
+        {
+            skip_spaces();
+            auto value = ValueType{};
+            const auto* begin = expression_.data() + position_;
+            const auto* end = expression_.data() + expression_.size();
+            const auto [last, error] = std::from_chars(begin, end, value);
+            if (error != std::errc{})
+            {
+                throw_error("unsigned integer is expected");
+            }
+            position_ += static_cast<std::size_t>(last - begin);
+            return value;
+        }
+    };
+
+    FilterExpression::FilterExpression(std::string_view expression)
+        : expression_{ expression }
+    {
+        auto parser = Parser{ expression_, *this };
+        parser.parse();
+    }
+
+    auto FilterExpression::evaluate(const StructData& struct_data, Buffers& buffers) const -> std::span<const uint8_t>
+    {
+        const auto n_rows = is_hit_level_ ? struct_data.hit_data.size() : std::size_t{ 1 };
+        auto& masks = buffers.masks;
+        auto& column = buffers.column;
+        auto stack_size = std::size_t{};
+        for (const auto& instruction : program_)
+        {
+            switch (instruction.op_code)
+            {
+                case OpCode::compare:
+                case OpCode::contain:
+                {
+                    if (masks.size() <= stack_size)
+                    {
+                        masks.emplace_back();
+                    }
+                    auto& mask = masks[stack_size++];
+                    mask.resize(n_rows);
+                    const auto field = static_cast<FieldId>(instruction.field);
+                    if (is_hit_level_)
+                    {
+                        load_hit_column(field, struct_data, column);
+                    }
+                    else
+                    {
+                        column.assign(1, get_frame_value(field, struct_data));
+                    }
+                    if (instruction.op_code == OpCode::compare)
+                    {
+                        compare_column(
+                            static_cast<CompareOp>(instruction.compare_op), column, instruction.value, mask);
+                    }
+                    else
+                    {
+                        const auto& values = value_sets_[instruction.value];
+                        std::ranges::transform(column,
+                                               mask.begin(),
+                                               [&values](ValueType element) -> uint8_t
+                                               { return std::ranges::binary_search(values, element) ? 1 : 0; });
+                    }
+                    break;
+                }
+                case OpCode::logical_and:
+                case OpCode::logical_or:
+                {
+                    assert(stack_size >= 2);
+                    const auto& right = masks[--stack_size];
+                    auto& left = masks[stack_size - 1];
+                    if (instruction.op_code == OpCode::logical_and)
+                    {
+                        std::ranges::transform(
+                            left, right, left.begin(), [](uint8_t lhs, uint8_t rhs) -> uint8_t { return lhs & rhs; });
+                    }
+                    else
+                    {
+                        std::ranges::transform(
+                            left, right, left.begin(), [](uint8_t lhs, uint8_t rhs) -> uint8_t { return lhs | rhs; });
+                    }
+                    break;
+                }
+                case OpCode::logical_not:
+                {
+                    assert(stack_size >= 1);
+                    auto& operand = masks[stack_size - 1];
+                    std::ranges::transform(
+                        operand, operand.begin(), [](uint8_t element) -> uint8_t { return element ^ uint8_t{ 1 }; });
+                    break;
+                }
+            }
+        }
+        assert(stack_size == 1);
+        return masks.front();
+    }
+} // namespace srs::process
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "srs/data/SRSDataStructs.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace srs::process
+{
+    /**
+     * @brief Filter expression on the header and hit fields of the struct data, compiled once from its text
+     *
+     * The grammar of the expression is:
+     *
+     *     expression := and_expr ("||" and_expr)*
+     *     and_expr   := unary ("&&" unary)*
+     *     unary      := "!" unary | "(" expression ")" | field op integer | field "in" "[" integer ("," integer)* "]"
+     *     op         := "==" | "!=" | "<" | "<=" | ">" | ">="
+     *
+     * Frame fields are fec_id, frame_counter, udp_timestamp, overflow and n_hits. Hit fields are is_over_threshold,
+     * channel_num, tdc, offset, vmm_id, adc, bc_id, time, plane and strip. The fields time, plane and strip are only
+     * available if the hit time reconstruction or the channel mapping is enabled.
+     *
+     * The expression is compiled into a flat program in postfix order, in which each comparison refers to its field
+     * by an index. The program is evaluated for all hits of a frame at once: each comparison loads the column of its
+     * field and compares it in a tight loop, and the logical operators combine the resulting masks element-wise. An
+     * expression containing any hit field is a hit-level expression, whose result has one entry for each hit. The
+     * frame fields are the same for all hits of a frame.
+     */
+    class FilterExpression
+    {
+      public:
+        using ValueType = uint64_t;
+
+        //! Buffers of the evaluation, reused for all frames by a single thread
+        struct Buffers
+        {
+            std::vector<std::vector<uint8_t>> masks;
+            std::vector<ValueType> column;
+        };
+
+        /**
+         * @brief Constructor that parses and compiles the expression.
+         *
+         * Throws std::runtime_error if the expression is invalid.
+         *
+         * @param expression Text of the filter expression
+         */
+        explicit FilterExpression(std::string_view expression);
+
+        //! Whether the expression contains any hit field
+        [[nodiscard]] auto is_hit_level() const -> bool { return is_hit_level_; }
+        [[nodiscard]] auto get_expression() const -> const std::string& { return expression_; }
+
+        /**
+         * @brief Evaluate the expression on a frame.
+         *
+         * @param struct_data Frame to be evaluated
+         * @param buffers Buffers of the calling thread, which own the returned mask
+         * @return One entry (0 or 1) for each hit if the expression is hit-level, otherwise a single entry
+         */
+        [[nodiscard]] auto evaluate(const StructData& struct_data, Buffers& buffers) const
+            -> std::span<const uint8_t>;
+
+      private:
+        enum class OpCode : uint8_t
+        {
+            compare,
+            contain,
+            logical_and,
+            logical_or,
+            logical_not
+        };
+
+        struct Instruction
+        {
+            OpCode op_code = OpCode::compare;
+            uint8_t field = 0;      // index in the field table
+            uint8_t compare_op = 0; // comparison operator
+            ValueType value = 0;    // value of the comparison, or index of the value set of "in"
+        };
+
+        class Parser;
+
+        std::string expression_;
+        bool is_hit_level_ = false;
+        std::vector<Instruction> program_;
+        std::vector<std::vector<ValueType>> value_sets_; // sorted
+    };
+} // namespace srs::process
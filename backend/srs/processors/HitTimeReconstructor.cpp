@@ -0,0 +1,91 @@
+#include "HitTimeReconstructor.hpp"
+#include "srs/data/SRSDataCompact.hpp"
+#include "srs/data/SRSDataStructs.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <vector>
+
+namespace srs::process
+{
+    namespace
+    {
+        constexpr auto VMM_INDEX_SIZE = std::size_t{ 1 } << (common::FEC_ID_BIT_LENGTH + internal::VMM_ID_BIT_LENGTH);
+        constexpr auto SRS_TIMESTAMP_RANGE = internal::SRS_TIMESTAMP_MAX + 1;
+        constexpr auto N_VMMS_PER_FEC = std::size_t{ internal::VMM_ID_BIT_MAX } + 1;
+    } // namespace
+
+    HitTimeReconstructor::HitTimeReconstructor(uint64_t bc_clock_period_ps)
+        : bc_clock_period_ps_{ bc_clock_period_ps }
+        , marker_timestamps_(VMM_INDEX_SIZE)
+    {
+    }
+
+    auto HitTimeReconstructor::get_vmm_index(uint8_t fec_id, uint8_t vmm_id) -> std::size_t
+    {
+        return (static_cast<std::size_t>(fec_id) << internal::VMM_ID_BIT_LENGTH) | (vmm_id & internal::VMM_ID_BIT_MAX);
+    }
+
+    auto HitTimeReconstructor::unwrap_timestamp(uint64_t last_timestamp, uint64_t timestamp) -> uint64_t
+    {
+        auto unwrapped = (last_timestamp & ~internal::SRS_TIMESTAMP_MAX) | (timestamp & internal::SRS_TIMESTAMP_MAX);
+        // A timestamp far behind the last one means the 42-bit counter rolled over.
+        if (unwrapped + (SRS_TIMESTAMP_RANGE / 2) < last_timestamp)
+        {
+            unwrapped += SRS_TIMESTAMP_RANGE;
+        }
+        return unwrapped;
+    }
+
+    auto HitTimeReconstructor::update_marker(std::size_t vmm_index, uint64_t timestamp) -> uint64_t
+    {
+        auto& marker_timestamp = marker_timestamps_[vmm_index];
+        auto last_timestamp = marker_timestamp.load(std::memory_order_relaxed);
+        auto unwrapped = unwrap_timestamp(last_timestamp, timestamp);
+        // Only the latest marker is kept if a delayed frame from another pipeline comes later.
+        while (unwrapped > last_timestamp and
+               not marker_timestamp.compare_exchange_weak(last_timestamp, unwrapped, std::memory_order_relaxed))
+        {
+            unwrapped = unwrap_timestamp(last_timestamp, timestamp);
+        }
+        return unwrapped;
+    }
+
+    void HitTimeReconstructor::process(StructData& struct_data)
+    {
+        const auto fec_id = struct_data.header.fec_id;
+
+        // Markers of the frame itself take precedence over the shared ones for the hits of the same frame.
+        auto frame_markers = std::array<uint64_t, N_VMMS_PER_FEC>{};
+        auto frame_marker_mask = uint32_t{};
+        for (const auto& marker : struct_data.marker_data)
+        {
+            const auto vmm_id = marker.vmm_id & internal::VMM_ID_BIT_MAX;
+            frame_markers[vmm_id] = update_marker(get_vmm_index(fec_id, marker.vmm_id), marker.srs_timestamp);
+            frame_marker_mask |= uint32_t{ 1 } << vmm_id;
+        }
+        for (auto vmm_id : std::views::iota(std::size_t{ 0 }, N_VMMS_PER_FEC))
+        {
+            if ((frame_marker_mask & (uint32_t{ 1 } << vmm_id)) == 0)
+            {
+                frame_markers[vmm_id] = marker_timestamps_[get_vmm_index(fec_id, static_cast<uint8_t>(vmm_id))].load(
+                    std::memory_order_relaxed);
+            }
+        }
+
+        // No dependency between hits, such that the loop can be vectorised.
+        struct_data.hit_time.resize(struct_data.hit_data.size());
+        std::ranges::transform(struct_data.hit_data,
+                               struct_data.hit_time.begin(),
+                               [this, &frame_markers](const HitData& hit) -> uint64_t
+                               {
+                                   const auto bc_clock_count = frame_markers[hit.vmm_id & internal::VMM_ID_BIT_MAX] +
+                                                               (hit.offset * common::BC_ID_PERIOD) + hit.bc_id;
+                                   return bc_clock_count * bc_clock_period_ps_;
+                               });
+    }
+} // namespace srs::process
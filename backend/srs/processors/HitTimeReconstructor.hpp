@@ -0,0 +1,39 @@
+#pragma once
+
+#include "srs/data/SRSDataStructs.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace srs::process
+{
+    /**
+     * @brief Reconstruction of the absolute time of each hit
+     *
+     * The time of a hit is the SRS timestamp of the last marker from the same FEC and VMM, shifted by the offset (in
+     * the units of 4096 BC clock cycles) and the BC ID of the hit. As the order between the markers and the hits is
+     * not preserved in StructData, markers of a frame are always applied before its hits. The 42-bit SRS timestamps
+     * are unwrapped when they roll over.
+     *
+     * Frames of the same FEC can be processed by any pipeline. Therefore, the markers are kept in a table shared by
+     * all pipelines, which only moves forward in time, such that a delayed frame never replaces a later marker.
+     */
+    class HitTimeReconstructor
+    {
+      public:
+        explicit HitTimeReconstructor(uint64_t bc_clock_period_ps);
+
+        //! Fill StructData::hit_time from the markers and hits of the frame. Thread-safe.
+        void process(StructData& struct_data);
+
+      private:
+        uint64_t bc_clock_period_ps_ = 0;
+        // Unwrapped timestamps of the last markers, indexed by the FEC ID and VMM ID
+        std::vector<std::atomic<uint64_t>> marker_timestamps_;
+
+        static auto get_vmm_index(uint8_t fec_id, uint8_t vmm_id) -> std::size_t;
+        static auto unwrap_timestamp(uint64_t last_timestamp, uint64_t timestamp) -> uint64_t;
+        auto update_marker(std::size_t vmm_index, uint64_t timestamp) -> uint64_t;
+    };
+} // namespace srs::process
@@ -0,0 +1,107 @@
+#include "StripClusterer.hpp"
+#include "srs/data/SRSDataStructs.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <spdlog/spdlog.h>
+#include <tuple>
+#include <vector>
+
+namespace srs::process
+{
+    StripClusterer::StripClusterer(std::size_t n_lines, const Options& options)
+        : options_{ options }
+    {
+        hit_buffers_.resize(n_lines);
+        spdlog::info("Strip clustering: time window of {} ps with the maximum strip gap of {}{}",
+                     options_.time_window_ps,
+                     options_.max_strip_gap,
+                     options_.is_hit_dropped ? ". Only the clusters are kept in the outputs." : "");
+    }
+
+    void StripClusterer::process(StructData& struct_data, std::size_t line_number)
+    {
+        struct_data.clusters.clear();
+        const auto n_hits = struct_data.hit_data.size();
+        if (struct_data.hit_time.size() != n_hits or struct_data.hit_plane.size() != n_hits or
+            struct_data.hit_strip.size() != n_hits)
+        {
+            return;
+        }
+
+        auto& hits = hit_buffers_[line_number];
+        hits.clear();
+        hits.reserve(n_hits);
+        for (auto idx = std::size_t{}; idx < n_hits; ++idx)
+        {
+            const auto plane = struct_data.hit_plane[idx];
+            const auto strip = struct_data.hit_strip[idx];
+            if (plane == common::UNMAPPED_PLANE_ID or strip == common::UNMAPPED_STRIP_ID)
+            {
+                continue;
+            }
+            hits.push_back(ClusterHit{ .time = struct_data.hit_time[idx],
+                                       .strip = strip,
+                                       .adc = struct_data.hit_data[idx].adc,
+                                       .plane = plane });
+        }
+
+        std::ranges::sort(hits,
+                          [](const ClusterHit& left, const ClusterHit& right)
+                          { return std::tie(left.plane, left.time) < std::tie(right.plane, right.time); });
+
+        auto remaining = std::span{ hits };
+        while (not remaining.empty())
+        {
+            const auto& first_hit = remaining.front();
+            const auto group_end = std::ranges::find_if(
+                remaining,
+                [&first_hit, this](const ClusterHit& hit)
+                { return hit.plane != first_hit.plane or hit.time - first_hit.time > options_.time_window_ps; });
+            const auto group_size = static_cast<std::size_t>(group_end - remaining.begin());
+            add_clusters(remaining.first(group_size), struct_data.clusters);
+            remaining = remaining.subspan(group_size);
+        }
+    }
+
+    void StripClusterer::add_clusters(std::span<ClusterHit> hits, std::vector<ClusterData>& clusters) const
+    {
+        std::ranges::sort(hits,
+                          [](const ClusterHit& left, const ClusterHit& right)
+                          { return std::tie(left.strip, left.time) < std::tie(right.strip, right.time); });
+
+        auto cluster_begin = std::size_t{};
+        for (auto idx = std::size_t{ 1 }; idx <= hits.size(); ++idx)
+        {
+            if (idx == hits.size() or hits[idx].strip - hits[idx - 1].strip > options_.max_strip_gap)
+            {
+                clusters.push_back(make_cluster(hits.subspan(cluster_begin, idx - cluster_begin)));
+                cluster_begin = idx;
+            }
+        }
+    }
+
+    auto StripClusterer::make_cluster(std::span<const ClusterHit> hits) -> ClusterData
+    {
+        auto cluster = ClusterData{};
+        cluster.time = hits.front().time;
+        cluster.size = static_cast<uint16_t>(hits.size());
+        cluster.plane = hits.front().plane;
+        auto weighted_strip_sum = 0.;
+        auto strip_sum = 0.;
+        for (const auto& hit : hits)
+        {
+            cluster.time = std::min(cluster.time, hit.time);
+            cluster.charge += hit.adc;
+            weighted_strip_sum += static_cast<double>(hit.strip) * hit.adc;
+            strip_sum += hit.strip;
+        }
+        // Hits without any charge after the pedestal subtraction have the same weights.
+        cluster.centroid = (cluster.charge > 0)
+                               ? static_cast<float>(weighted_strip_sum / static_cast<double>(cluster.charge))
+                               : static_cast<float>(strip_sum / static_cast<double>(hits.size()));
+        return cluster;
+    }
+} // namespace srs::process
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "srs/data/SRSDataStructs.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace srs::process
+{
+    /**
+     * @brief Clustering of the hits on neighbouring strips of the same detector plane
+     *
+     * The mapped hits of a frame are gathered into a compact buffer and sorted by the plane and the time. Hits of the
+     * same plane are grouped in time if they come within the time window after the first hit of the group. Each time
+     * group is then sorted by the strip and split wherever the gap between two adjacent strips is larger than the
+     * maximum strip gap. Hits missing in the channel mapping are ignored.
+     *
+     * The clustering only works on the hits of one frame, such that clusters spanning two frames are split.
+     *
+     * If Options::is_hit_dropped is true, only the clusters are kept in the outputs. The hits are removed by
+     * StructProcessor after all stages that need them.
+     */
+    class StripClusterer
+    {
+      public:
+        struct Options
+        {
+            uint64_t time_window_ps = 0;
+            uint16_t max_strip_gap = common::DEFAULT_CLUSTER_MAX_STRIP_GAP;
+            bool is_hit_dropped = false; //!< whether the hits are removed from the outputs once clustered
+        };
+
+        StripClusterer(std::size_t n_lines, const Options& options);
+
+        //! Fill StructData::clusters from the hits of the frame, which must have the hit time and the strip IDs
+        void process(StructData& struct_data, std::size_t line_number);
+
+        [[nodiscard]] auto is_hit_dropped() const -> bool { return options_.is_hit_dropped; }
+
+      private:
+        struct ClusterHit
+        {
+            uint64_t time = 0;
+            uint16_t strip = 0;
+            uint16_t adc = 0;
+            uint8_t plane = 0;
+        };
+
+        Options options_;
+        // Buffers of the compact hits reused by each pipeline
+        std::vector<std::vector<ClusterHit>> hit_buffers_;
+
+        void add_clusters(std::span<ClusterHit> hits, std::vector<ClusterData>& clusters) const;
+        static auto make_cluster(std::span<const ClusterHit> hits) -> ClusterData;
+    };
+} // namespace srs::process
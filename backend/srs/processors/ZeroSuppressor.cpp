@@ -0,0 +1,183 @@
+#include "ZeroSuppressor.hpp"
+#include "srs/data/SRSDataCompact.hpp"
+#include "srs/data/SRSDataStructs.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fmt/format.h>
+#include <fstream>
+#include <spdlog/spdlog.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace srs::process
+{
+    namespace
+    {
+        constexpr auto CHANNELS_PER_FEC = std::size_t{ 1 }
+                                          << (internal::VMM_ID_BIT_LENGTH + internal::CHANNEL_NUM_BIT_LENGTH);
+        // Out of the range of the FEC indices, which go up to 255 if all FEC IDs are present.
+        constexpr auto NO_FEC_INDEX = uint16_t{ 0xffff };
+        constexpr auto MOVING_AVERAGE_WEIGHT = 1.F / static_cast<float>(common::PEDESTAL_WARM_UP_SAMPLES);
+    } // namespace
+
+    ZeroSuppressor::ChannelTable::ChannelTable() { fec_indices.fill(NO_FEC_INDEX); }
+
+    auto ZeroSuppressor::ChannelTable::find_fec_channels(uint8_t fec_id) -> ChannelStat*
+    {
+        const auto fec_index = fec_indices[fec_id];
+        return (fec_index == NO_FEC_INDEX) ? nullptr : &channels[fec_index * CHANNELS_PER_FEC];
+    }
+
+    // New FECs are added to the table.
+    auto ZeroSuppressor::ChannelTable::get_fec_channels(uint8_t fec_id) -> ChannelStat*
+    {
+        auto& fec_index = fec_indices[fec_id];
+        if (fec_index == NO_FEC_INDEX)
+        {
+            fec_index = static_cast<uint16_t>(channels.size() / CHANNELS_PER_FEC);
+            channels.resize(channels.size() + CHANNELS_PER_FEC);
+        }
+        return &channels[fec_index * CHANNELS_PER_FEC];
+    }
+
+    ZeroSuppressor::ZeroSuppressor(std::size_t n_lines, const Options& options)
+        : options_{ options }
+        , is_calibrated_{ not options.pedestal_filename.empty() }
+    {
+        // The calibrated estimates are never changed and therefore shared by all pipelines.
+        channel_tables_.resize(is_calibrated_ ? 1 : n_lines);
+        if (is_calibrated_)
+        {
+            load_calibration(options_.pedestal_filename);
+        }
+        spdlog::info("Zero suppression: hits below {} sigma of the noise are removed with {} pedestals",
+                     options_.n_sigma,
+                     is_calibrated_ ? "calibrated" : "online estimated");
+    }
+
+    void ZeroSuppressor::load_calibration(const std::string& filename)
+    {
+        auto input_file = std::ifstream{ filename };
+        if (not input_file.is_open())
+        {
+            throw std::runtime_error{ fmt::format("Cannot open the pedestal calibration file {:?}", filename) };
+        }
+
+        auto& channel_table = channel_tables_.front();
+        auto n_channels = std::size_t{};
+        auto line = std::string{};
+        for (auto line_number = 1; std::getline(input_file, line); ++line_number)
+        {
+            auto line_stream = std::istringstream{ line };
+            auto first_char = char{};
+            if (not(line_stream >> first_char) or first_char == '#')
+            {
+                continue;
+            }
+            line_stream.unget();
+
+            auto fec_id = uint32_t{};
+            auto vmm_id = uint32_t{};
+            auto channel_num = uint32_t{};
+            auto pedestal = 0.F;
+            auto noise = 0.F;
+            line_stream >> fec_id >> vmm_id >> channel_num >> pedestal >> noise;
+            if (line_stream.fail() or fec_id >= channel_table.fec_indices.size() or
+                vmm_id > internal::VMM_ID_BIT_MAX or channel_num > internal::CHANNEL_NUM_BIT_MAX or noise < 0.F)
+            {
+                throw std::runtime_error{ fmt::format(
+                    "Invalid pedestal calibration at line {} of the file {:?}: {:?}", line_number, filename, line) };
+            }
+            auto* fec_channels = channel_table.get_fec_channels(static_cast<uint8_t>(fec_id));
+            fec_channels[get_channel_index(static_cast<uint8_t>(vmm_id), static_cast<uint8_t>(channel_num))] =
+                ChannelStat{ .pedestal = pedestal,
+                             .variance = noise * noise,
+                             .n_samples = common::PEDESTAL_WARM_UP_SAMPLES };
+            ++n_channels;
+        }
+        spdlog::info("Zero suppression: pedestals of {} channels are loaded from the file {:?}", n_channels, filename);
+    }
+
+    auto ZeroSuppressor::get_channel_index(uint8_t vmm_id, uint8_t channel_num) -> std::size_t
+    {
+        return (static_cast<std::size_t>(vmm_id & internal::VMM_ID_BIT_MAX) << internal::CHANNEL_NUM_BIT_LENGTH) |
+               (channel_num & internal::CHANNEL_NUM_BIT_MAX);
+    }
+
+    void ZeroSuppressor::update_estimates(ChannelStat& stat, uint16_t adc)
+    {
+        const auto delta = static_cast<float>(adc) - stat.pedestal;
+        if (stat.n_samples < common::PEDESTAL_WARM_UP_SAMPLES)
+        {
+            // Welford's algorithm for the population variance
+            ++stat.n_samples;
+            const auto weight = 1.F / static_cast<float>(stat.n_samples);
+            stat.pedestal += delta * weight;
+            stat.variance += ((delta * (static_cast<float>(adc) - stat.pedestal)) - stat.variance) * weight;
+            return;
+        }
+        stat.pedestal += delta * MOVING_AVERAGE_WEIGHT;
+        stat.variance = (1.F - MOVING_AVERAGE_WEIGHT) * (stat.variance + (MOVING_AVERAGE_WEIGHT * delta * delta));
+    }
+
+    auto ZeroSuppressor::check_is_suppressed(ChannelStat& stat, uint16_t adc) const -> bool
+    {
+        if (stat.n_samples < common::PEDESTAL_WARM_UP_SAMPLES)
+        {
+            // Channels missing in the calibration file are never suppressed.
+            if (not is_calibrated_)
+            {
+                update_estimates(stat, adc);
+            }
+            return false;
+        }
+        const auto threshold =
+            static_cast<double>(stat.pedestal) + (options_.n_sigma * std::sqrt(static_cast<double>(stat.variance)));
+        if (static_cast<double>(adc) >= threshold)
+        {
+            return false;
+        }
+        if (not is_calibrated_)
+        {
+            update_estimates(stat, adc);
+        }
+        return true;
+    }
+
+    auto ZeroSuppressor::process(StructData& struct_data, std::size_t line_number) -> std::size_t
+    {
+        const auto fec_id = struct_data.header.fec_id;
+        auto* fec_channels = is_calibrated_ ? channel_tables_.front().find_fec_channels(fec_id)
+                                            : channel_tables_[line_number].get_fec_channels(fec_id);
+        if (fec_channels == nullptr)
+        {
+            return 0;
+        }
+        auto& hits = struct_data.hit_data;
+
+        // Surviving hits are moved to the front in their original order.
+        auto n_kept = std::size_t{};
+        for (auto& hit : hits)
+        {
+            auto& stat = fec_channels[get_channel_index(hit.vmm_id, hit.channel_num)];
+            if (check_is_suppressed(stat, hit.adc))
+            {
+                continue;
+            }
+            if (options_.is_pedestal_subtracted)
+            {
+                const auto adc = std::max(std::lround(static_cast<float>(hit.adc) - stat.pedestal), 0L);
+                hit.adc = static_cast<uint16_t>(adc);
+            }
+            hits[n_kept] = hit;
+            ++n_kept;
+        }
+        const auto n_suppressed = hits.size() - n_kept;
+        hits.resize(n_kept);
+        return n_suppressed;
+    }
+} // namespace srs::process
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "srs/data/SRSDataStructs.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace srs::process
+{
+    /**
+     * @brief Pedestal subtraction and zero suppression of the hits
+     *
+     * Each channel has an estimate of its pedestal and noise (standard deviation of the ADC values). Hits with ADC
+     * values below "pedestal + n_sigma * noise" are removed from the struct data.
+     *
+     * The estimates are either loaded from a calibration file or updated online from the hit stream of each pipeline.
+     * In the online mode, all hits of a channel are kept and used for the estimation until the channel has
+     * common::PEDESTAL_WARM_UP_SAMPLES hits. Afterwards, only the suppressed hits update the estimates with an
+     * exponential moving average, such that the signals don't bias the pedestal.
+     */
+    class ZeroSuppressor
+    {
+      public:
+        struct Options
+        {
+            double n_sigma = 0.;
+            std::string pedestal_filename; //!< empty for the online estimation
+            bool is_pedestal_subtracted = false;
+        };
+
+        /**
+         * @brief Constructor. Throws std::runtime_error if the calibration file cannot be read or contains an invalid
+         * line.
+         *
+         * @param n_lines Number of pipelines
+         * @param options Options of the zero suppression
+         */
+        ZeroSuppressor(std::size_t n_lines, const Options& options);
+
+        //! Remove the hits below the thresholds. Returns the number of removed hits.
+        auto process(StructData& struct_data, std::size_t line_number) -> std::size_t;
+
+      private:
+        struct ChannelStat
+        {
+            float pedestal = 0.F;
+            float variance = 0.F;
+            uint32_t n_samples = 0;
+        };
+
+        // Channel estimates of the FECs in the order of their appearance
+        struct ChannelTable
+        {
+            std::array<uint16_t, std::size_t{ 1 } << common::FEC_ID_BIT_LENGTH> fec_indices{};
+            std::vector<ChannelStat> channels;
+
+            ChannelTable();
+            auto find_fec_channels(uint8_t fec_id) -> ChannelStat*;
+            auto get_fec_channels(uint8_t fec_id) -> ChannelStat*;
+        };
+
+        Options options_;
+        bool is_calibrated_ = false;
+        std::vector<ChannelTable> channel_tables_;
+
+        void load_calibration(const std::string& filename);
+        auto check_is_suppressed(ChannelStat& stat, uint16_t adc) const -> bool;
+        static void update_estimates(ChannelStat& stat, uint16_t adc);
+        static auto get_channel_index(uint8_t vmm_id, uint8_t channel_num) -> std::size_t;
+    };
+} // namespace srs::process
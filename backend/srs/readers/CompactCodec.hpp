@@ -0,0 +1,371 @@
+#pragma once
+
+#include "srs/data/SRSDataCompact.hpp"
+#include "srs/data/SRSDataStructs.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace srs::reader::internal
+{
+    // Bit lengths of the prefixes of the variable-length values, which store the bit widths of the values
+    constexpr auto VAR_32_LENGTH_BITS = 6U;
+    constexpr auto VAR_64_LENGTH_BITS = 7U;
+    constexpr auto FEC_ID_BITS = 8U;
+    constexpr auto VMM_TAG_BITS = static_cast<unsigned>(common::VMM_TAG.size() * common::BYTE_BIT_LENGTH);
+    constexpr auto N_FECS = std::size_t{ 1 } << FEC_ID_BITS;
+
+    // Positions of the fixed-width values of a hit, which are written and read as one value
+    constexpr auto HIT_TDC_POSITION = process::internal::CHANNEL_NUM_BIT_LENGTH;
+    constexpr auto HIT_ADC_POSITION = HIT_TDC_POSITION + process::internal::TDC_BIT_LENGTH;
+    constexpr auto HIT_BC_ID_POSITION = HIT_ADC_POSITION + process::internal::ADC_BIT_LENGTH;
+    constexpr auto HIT_OVER_THRESHOLD_POSITION = HIT_BC_ID_POSITION + process::internal::BC_ID_BIT_LENGTH;
+    constexpr auto HIT_FIXED_BITS = HIT_OVER_THRESHOLD_POSITION + 1U;
+
+    constexpr auto get_bit_mask(unsigned n_bits) -> uint64_t
+    {
+        return (n_bits >= 64U) ? ~uint64_t{} : (uint64_t{ 1 } << n_bits) - 1;
+    }
+
+    constexpr auto zigzag_encode(uint64_t value) -> uint64_t
+    {
+        return (value << 1U) ^ (uint64_t{} - (value >> 63U));
+    }
+
+    constexpr auto zigzag_decode(uint64_t value) -> uint64_t
+    {
+        return (value >> 1U) ^ (uint64_t{} - (value & 1U));
+    }
+
+    constexpr auto pack_hit_values(const HitData& hit) -> uint64_t
+    {
+        return (uint64_t{ hit.channel_num } & get_bit_mask(process::internal::CHANNEL_NUM_BIT_LENGTH)) |
+               (uint64_t{ hit.tdc } << HIT_TDC_POSITION) |
+               ((uint64_t{ hit.adc } & get_bit_mask(process::internal::ADC_BIT_LENGTH)) << HIT_ADC_POSITION) |
+               ((uint64_t{ hit.bc_id } & get_bit_mask(process::internal::BC_ID_BIT_LENGTH)) << HIT_BC_ID_POSITION) |
+               (static_cast<uint64_t>(hit.is_over_threshold) << HIT_OVER_THRESHOLD_POSITION);
+    }
+
+    constexpr void unpack_hit_values(uint64_t value, HitData& hit)
+    {
+        hit.channel_num = static_cast<uint8_t>(value & get_bit_mask(process::internal::CHANNEL_NUM_BIT_LENGTH));
+        hit.tdc = static_cast<uint8_t>(value >> HIT_TDC_POSITION);
+        hit.adc = static_cast<uint16_t>((value >> HIT_ADC_POSITION) & get_bit_mask(process::internal::ADC_BIT_LENGTH));
+        hit.bc_id =
+            static_cast<uint16_t>((value >> HIT_BC_ID_POSITION) & get_bit_mask(process::internal::BC_ID_BIT_LENGTH));
+        hit.is_over_threshold = ((value >> HIT_OVER_THRESHOLD_POSITION) & 1U) == 1U;
+    }
+
+    // Writes values of arbitrary bit lengths into 64-bit words, starting from the least significant bits
+    class BitWriter
+    {
+      public:
+        void write(uint64_t value, unsigned n_bits)
+        {
+            assert(n_bits <= 64U);
+            value &= get_bit_mask(n_bits);
+            if (n_buffer_bits_ + n_bits >= 64U)
+            {
+                words_.push_back(buffer_ | (value << n_buffer_bits_));
+                buffer_ = (n_buffer_bits_ == 0) ? 0 : (value >> (64U - n_buffer_bits_));
+                n_buffer_bits_ = n_buffer_bits_ + n_bits - 64U;
+                return;
+            }
+            buffer_ |= value << n_buffer_bits_;
+            n_buffer_bits_ += n_bits;
+        }
+
+        // The bit width of the value is written first with length_bits bits.
+        void write_var(uint64_t value, unsigned length_bits)
+        {
+            const auto width = static_cast<unsigned>(std::bit_width(value));
+            write(width, length_bits);
+            write(value, width);
+        }
+
+        //! Pad the last word and return all words.
+        auto finish() -> std::span<const uint64_t>
+        {
+            if (n_buffer_bits_ > 0)
+            {
+                words_.push_back(buffer_);
+                buffer_ = 0;
+                n_buffer_bits_ = 0;
+            }
+            return words_;
+        }
+
+        void clear()
+        {
+            words_.clear();
+            buffer_ = 0;
+            n_buffer_bits_ = 0;
+        }
+
+      private:
+        std::vector<uint64_t> words_;
+        uint64_t buffer_ = 0;
+        unsigned n_buffer_bits_ = 0;
+    };
+
+    // Reads the values written by BitWriter. Reading past the end returns 0 and sets the overrun flag.
+    class BitReader
+    {
+      public:
+        void reset(std::span<const uint64_t> words)
+        {
+            words_ = words;
+            bit_position_ = 0;
+            is_overrun_ = false;
+        }
+
+        auto read(unsigned n_bits) -> uint64_t
+        {
+            assert(n_bits <= 64U);
+            if (n_bits == 0)
+            {
+                return 0;
+            }
+            const auto word_idx = bit_position_ / 64U;
+            const auto shift = static_cast<unsigned>(bit_position_ % 64U);
+            const auto is_split = shift + n_bits > 64U;
+            if (word_idx + (is_split ? 1U : 0U) >= words_.size())
+            {
+                is_overrun_ = true;
+                return 0;
+            }
+            auto value = words_[word_idx] >> shift;
+            if (is_split)
+            {
+                value |= words_[word_idx + 1] << (64U - shift);
+            }
+            bit_position_ += n_bits;
+            return value & get_bit_mask(n_bits);
+        }
+
+        auto read_var(unsigned length_bits) -> uint64_t
+        {
+            const auto width = static_cast<unsigned>(read(length_bits));
+            if (width > 64U)
+            {
+                is_overrun_ = true;
+                return 0;
+            }
+            return read(width);
+        }
+
+        [[nodiscard]] auto is_overrun() const -> bool { return is_overrun_; }
+
+      private:
+        std::span<const uint64_t> words_;
+        std::size_t bit_position_ = 0;
+        bool is_overrun_ = false;
+    };
+
+    /*
+     * Layout of each frame in a block:
+     *
+     * - FEC ID (8 bits)
+     * - frame counter and UDP timestamp, as differences to the previous frame of the same FEC in the block
+     * - overflow, number of markers and number of hits
+     * - 1 bit whether the VMM tag is "VM3", followed by the tag (24 bits) if not
+     * - markers: VMM ID (5 bits) and the timestamp as the zigzag-encoded difference to the previous marker of the
+     *   same FEC in the block
+     * - hits: VMM ID and offset (1 bit whether each is the same as the previous hit, followed by the value if not),
+     *   channel number (6 bits), TDC (8 bits), ADC (10 bits), BC ID (12 bits) and the over-threshold flag (1 bit)
+     *
+     * Counts and differences are written with their bit widths as the prefixes of VAR_32_LENGTH_BITS bits, or
+     * VAR_64_LENGTH_BITS bits for 64-bit values.
+     */
+    class CompactFrameEncoder
+    {
+      public:
+        void encode(const StructData& struct_data)
+        {
+            const auto& header = struct_data.header;
+            bit_writer_.write(header.fec_id, FEC_ID_BITS);
+            auto& last_frame_counter = last_frame_counters_[header.fec_id];
+            auto& last_udp_timestamp = last_udp_timestamps_[header.fec_id];
+            bit_writer_.write_var(static_cast<uint32_t>(header.frame_counter - last_frame_counter), VAR_32_LENGTH_BITS);
+            bit_writer_.write_var(static_cast<uint32_t>(header.udp_timestamp - last_udp_timestamp), VAR_32_LENGTH_BITS);
+            last_frame_counter = header.frame_counter;
+            last_udp_timestamp = header.udp_timestamp;
+            bit_writer_.write_var(header.overflow, VAR_32_LENGTH_BITS);
+            bit_writer_.write_var(struct_data.marker_data.size(), VAR_32_LENGTH_BITS);
+            bit_writer_.write_var(struct_data.hit_data.size(), VAR_32_LENGTH_BITS);
+            const auto is_default_tag = header.vmm_tag == common::VMM_TAG;
+            bit_writer_.write(static_cast<uint64_t>(is_default_tag), 1);
+            if (not is_default_tag)
+            {
+                bit_writer_.write(std::bit_cast<uint32_t>(std::array{ header.vmm_tag[0],
+                                                                      header.vmm_tag[1],
+                                                                      header.vmm_tag[2],
+                                                                      char{} }),
+                                  VMM_TAG_BITS);
+            }
+
+            auto& last_timestamp = last_marker_timestamps_[header.fec_id];
+            for (const auto& marker : struct_data.marker_data)
+            {
+                bit_writer_.write(marker.vmm_id, process::internal::VMM_ID_BIT_LENGTH);
+                bit_writer_.write_var(zigzag_encode(marker.srs_timestamp - last_timestamp), VAR_64_LENGTH_BITS);
+                last_timestamp = marker.srs_timestamp;
+            }
+
+            auto last_vmm_id = uint8_t{};
+            auto last_offset = uint8_t{};
+            for (const auto& hit : struct_data.hit_data)
+            {
+                write_if_changed(hit.vmm_id, last_vmm_id, process::internal::VMM_ID_BIT_LENGTH);
+                write_if_changed(hit.offset, last_offset, process::internal::OFFSET_BIT_LENGTH);
+                bit_writer_.write(pack_hit_values(hit), HIT_FIXED_BITS);
+            }
+            ++n_frames_;
+        }
+
+        //! Number of frames in the current block
+        [[nodiscard]] auto get_n_frames() const -> uint32_t { return n_frames_; }
+
+        //! Finish the current block and return its payload, which is valid until the next call of encode().
+        auto finish_block() -> std::span<const uint64_t>
+        {
+            const auto words = bit_writer_.finish();
+            last_frame_counters_.fill(0);
+            last_udp_timestamps_.fill(0);
+            last_marker_timestamps_.fill(0);
+            n_frames_ = 0;
+            is_finished_ = true;
+            return words;
+        }
+
+        //! Clear the payload of the finished block.
+        void clear()
+        {
+            if (is_finished_)
+            {
+                bit_writer_.clear();
+                is_finished_ = false;
+            }
+        }
+
+      private:
+        BitWriter bit_writer_;
+        std::array<uint32_t, N_FECS> last_frame_counters_{};
+        std::array<uint32_t, N_FECS> last_udp_timestamps_{};
+        std::array<uint64_t, N_FECS> last_marker_timestamps_{};
+        uint32_t n_frames_ = 0;
+        bool is_finished_ = false;
+
+        void write_if_changed(uint8_t value, uint8_t& last_value, unsigned n_bits)
+        {
+            const auto is_same = value == last_value;
+            bit_writer_.write(static_cast<uint64_t>(is_same), 1);
+            if (not is_same)
+            {
+                bit_writer_.write(value, n_bits);
+                last_value = value;
+            }
+        }
+    };
+
+    // Decoder of the frames written by CompactFrameEncoder
+    class CompactFrameDecoder
+    {
+      public:
+        //! Resize the payload buffer of the next block, which is then filled by the caller.
+        auto get_block_buffer(std::size_t n_words) -> std::span<uint64_t>
+        {
+            block_words_.resize(n_words);
+            return block_words_;
+        }
+
+        //! Start decoding the block in the payload buffer.
+        void start_block(uint32_t n_frames)
+        {
+            bit_reader_.reset(block_words_);
+            last_frame_counters_.fill(0);
+            last_udp_timestamps_.fill(0);
+            last_marker_timestamps_.fill(0);
+            n_remaining_frames_ = n_frames;
+        }
+
+        [[nodiscard]] auto get_n_remaining_frames() const -> uint32_t { return n_remaining_frames_; }
+
+        //! Decode the next frame of the block. Returns false if the block is corrupted.
+        auto decode(StructData& struct_data) -> bool
+        {
+            assert(n_remaining_frames_ > 0);
+            --n_remaining_frames_;
+            reset_struct_data(struct_data);
+
+            auto& header = struct_data.header;
+            header.fec_id = static_cast<uint8_t>(bit_reader_.read(FEC_ID_BITS));
+            auto& last_frame_counter = last_frame_counters_[header.fec_id];
+            auto& last_udp_timestamp = last_udp_timestamps_[header.fec_id];
+            header.frame_counter = last_frame_counter + static_cast<uint32_t>(bit_reader_.read_var(VAR_32_LENGTH_BITS));
+            header.udp_timestamp = last_udp_timestamp + static_cast<uint32_t>(bit_reader_.read_var(VAR_32_LENGTH_BITS));
+            last_frame_counter = header.frame_counter;
+            last_udp_timestamp = header.udp_timestamp;
+            header.overflow = static_cast<uint32_t>(bit_reader_.read_var(VAR_32_LENGTH_BITS));
+            const auto n_markers = bit_reader_.read_var(VAR_32_LENGTH_BITS);
+            const auto n_hits = bit_reader_.read_var(VAR_32_LENGTH_BITS);
+            if (bit_reader_.read(1) == 1)
+            {
+                header.vmm_tag = common::VMM_TAG;
+            }
+            else
+            {
+                const auto tag_word = static_cast<uint32_t>(bit_reader_.read(VMM_TAG_BITS));
+                const auto tag = std::bit_cast<std::array<char, sizeof(uint32_t)>>(tag_word);
+                header.vmm_tag = std::array{ tag[0], tag[1], tag[2] };
+            }
+            // Each marker or hit takes at least 12 bits.
+            if (bit_reader_.is_overrun() or n_markers + n_hits > block_words_.size() * 64U / 12U)
+            {
+                return false;
+            }
+
+            struct_data.marker_data.resize(n_markers);
+            auto& last_timestamp = last_marker_timestamps_[header.fec_id];
+            for (auto& marker : struct_data.marker_data)
+            {
+                marker.vmm_id = static_cast<uint8_t>(bit_reader_.read(process::internal::VMM_ID_BIT_LENGTH));
+                marker.srs_timestamp = last_timestamp + zigzag_decode(bit_reader_.read_var(VAR_64_LENGTH_BITS));
+                last_timestamp = marker.srs_timestamp;
+            }
+
+            struct_data.hit_data.resize(n_hits);
+            auto last_vmm_id = uint8_t{};
+            auto last_offset = uint8_t{};
+            for (auto& hit : struct_data.hit_data)
+            {
+                hit.vmm_id = read_if_changed(last_vmm_id, process::internal::VMM_ID_BIT_LENGTH);
+                hit.offset = read_if_changed(last_offset, process::internal::OFFSET_BIT_LENGTH);
+                unpack_hit_values(bit_reader_.read(HIT_FIXED_BITS), hit);
+            }
+            return not bit_reader_.is_overrun();
+        }
+
+      private:
+        std::vector<uint64_t> block_words_;
+        BitReader bit_reader_;
+        std::array<uint32_t, N_FECS> last_frame_counters_{};
+        std::array<uint32_t, N_FECS> last_udp_timestamps_{};
+        std::array<uint64_t, N_FECS> last_marker_timestamps_{};
+        uint32_t n_remaining_frames_ = 0;
+
+        auto read_if_changed(uint8_t& last_value, unsigned n_bits) -> uint8_t
+        {
+            if (bit_reader_.read(1) == 0)
+            {
+                last_value = static_cast<uint8_t>(bit_reader_.read(n_bits));
+            }
+            return last_value;
+        }
+    };
+} // namespace srs::reader::internal
@@ -0,0 +1,198 @@
+#include "srs/readers/CompactFileReader.hpp"
+#include "srs/data/SRSDataStructs.hpp"
+#include "srs/readers/CompactCodec.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <fmt/format.h>
+#include <fstream>
+#include <ios>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <zpp_bits.h>
+
+namespace srs::reader
+{
+    CompactFile::CompactFile(const std::string& filename)
+        : input_filename_{ filename }
+        , input_file_{ filename, std::ios::binary }
+        , decoder_{ std::make_unique<internal::CompactFrameDecoder>() }
+    {
+        if (not input_file_.is_open())
+        {
+            throw std::runtime_error{ fmt::format("Cannot open the file {:?}", input_filename_) };
+        }
+        auto magic = std::array<char, MAGIC.size()>{};
+        input_file_.read(magic.data(), magic.size());
+        if (not input_file_.good() or magic != MAGIC)
+        {
+            throw std::runtime_error{ fmt::format("{:?} is not a valid compact file", input_filename_) };
+        }
+        if (not load_index())
+        {
+            scan_blocks();
+        }
+    }
+
+    CompactFile::CompactFile(CompactFile&&) noexcept = default;
+    CompactFile& CompactFile::operator=(CompactFile&&) noexcept = default;
+    CompactFile::~CompactFile() = default;
+
+    auto CompactFile::load_index() -> bool
+    {
+        const auto file_size = std::filesystem::file_size(input_filename_);
+        if (file_size < MAGIC.size() + FOOTER_SIZE)
+        {
+            return false;
+        }
+
+        auto footer = std::array<char, FOOTER_SIZE>{};
+        input_file_.seekg(static_cast<std::streamoff>(file_size - FOOTER_SIZE));
+        input_file_.read(footer.data(), footer.size());
+        if (not input_file_.good() or not std::ranges::equal(std::span{ footer }.last(INDEX_MAGIC.size()), INDEX_MAGIC))
+        {
+            input_file_.clear();
+            return false;
+        }
+        auto index_offset = uint64_t{};
+        zpp::bits::in{ footer }(index_offset).or_throw();
+        const auto index_end = file_size - FOOTER_SIZE;
+        if (index_offset < MAGIC.size() or index_offset > index_end or
+            (index_end - index_offset) % INDEX_ENTRY_SIZE != 0)
+        {
+            return false;
+        }
+
+        auto index_data = std::vector<char>(index_end - index_offset);
+        input_file_.seekg(static_cast<std::streamoff>(index_offset));
+        input_file_.read(index_data.data(), static_cast<std::streamsize>(index_data.size()));
+        if (not input_file_.good())
+        {
+            input_file_.clear();
+            return false;
+        }
+        auto deserialize_from = zpp::bits::in{ index_data };
+        blocks_.resize(index_data.size() / INDEX_ENTRY_SIZE);
+        for (auto& block : blocks_)
+        {
+            deserialize_from(block.offset, block.first_frame, block.n_frames).or_throw();
+        }
+        return true;
+    }
+
+    void CompactFile::scan_blocks()
+    {
+        // An incomplete block at the end is ignored, e.g. if the file is still being written.
+        const auto file_size = std::filesystem::file_size(input_filename_);
+        auto offset = uint64_t{ MAGIC.size() };
+        auto n_frames = uint64_t{};
+        auto block_header = std::array<char, BLOCK_HEADER_SIZE>{};
+        input_file_.seekg(static_cast<std::streamoff>(offset));
+        while (offset + BLOCK_HEADER_SIZE <= file_size)
+        {
+            input_file_.read(block_header.data(), block_header.size());
+            auto payload_size = uint32_t{};
+            auto block_n_frames = uint32_t{};
+            zpp::bits::in{ block_header }(payload_size, block_n_frames).or_throw();
+            if (not input_file_.good() or payload_size % sizeof(uint64_t) != 0 or
+                offset + BLOCK_HEADER_SIZE + payload_size > file_size)
+            {
+                break;
+            }
+            blocks_.push_back(
+                CompactBlockEntry{ .offset = offset, .first_frame = n_frames, .n_frames = block_n_frames });
+            n_frames += block_n_frames;
+            offset += BLOCK_HEADER_SIZE + payload_size;
+            input_file_.seekg(static_cast<std::streamoff>(offset));
+        }
+        input_file_.clear();
+    }
+
+    auto CompactFile::load_block(std::size_t block_idx) -> std::expected<void, std::string>
+    {
+        const auto& block = blocks_[block_idx];
+        auto block_header = std::array<char, BLOCK_HEADER_SIZE>{};
+        input_file_.seekg(static_cast<std::streamoff>(block.offset));
+        input_file_.read(block_header.data(), block_header.size());
+        auto payload_size = uint32_t{};
+        auto n_frames = uint32_t{};
+        zpp::bits::in{ block_header }(payload_size, n_frames).or_throw();
+        if (not input_file_.good() or n_frames != block.n_frames or payload_size % sizeof(uint64_t) != 0)
+        {
+            input_file_.clear();
+            return std::unexpected{ fmt::format(
+                "Invalid header of the block {} at the offset {} in {:?}", block_idx, block.offset, input_filename_) };
+        }
+
+        auto payload = decoder_->get_block_buffer(payload_size / sizeof(uint64_t));
+        input_file_.read(reinterpret_cast<char*>(payload.data()), static_cast<std::streamsize>(payload.size_bytes()));
+        if (not input_file_.good())
+        {
+            input_file_.clear();
+            return std::unexpected{ fmt::format("Cannot read the block {} from {:?}", block_idx, input_filename_) };
+        }
+        decoder_->start_block(n_frames);
+        next_block_ = block_idx + 1;
+        return {};
+    }
+
+    auto CompactFile::read_one_frame(StructData& struct_data) -> std::expected<bool, std::string>
+    {
+        while (decoder_->get_n_remaining_frames() == 0)
+        {
+            if (next_block_ >= blocks_.size())
+            {
+                return false;
+            }
+            if (auto res = load_block(next_block_); not res.has_value())
+            {
+                return std::unexpected{ std::move(res.error()) };
+            }
+        }
+        if (not decoder_->decode(struct_data))
+        {
+            // The rest of the block cannot be decoded anymore.
+            decoder_->start_block(0);
+            return std::unexpected{ fmt::format("Block {} of {:?} is corrupted", next_block_ - 1, input_filename_) };
+        }
+        return true;
+    }
+
+    auto CompactFile::read_one_frame() -> std::expected<const StructData*, std::string>
+    {
+        return read_one_frame(data_).transform([this](bool has_frame) -> const StructData*
+                                               { return has_frame ? &data_ : nullptr; });
+    }
+
+    auto CompactFile::seek_frame(uint64_t frame_number) -> std::expected<void, std::string>
+    {
+        if (frame_number >= get_n_frames())
+        {
+            return std::unexpected{ fmt::format(
+                "Frame {} is out of range. {:?} has {} frames", frame_number, input_filename_, get_n_frames()) };
+        }
+        const auto iter = std::ranges::upper_bound(blocks_, frame_number, {}, &CompactBlockEntry::first_frame);
+        const auto block_idx = static_cast<std::size_t>(std::distance(blocks_.begin(), iter) - 1);
+        if (auto res = load_block(block_idx); not res.has_value())
+        {
+            return res;
+        }
+        for (auto frame_idx = blocks_[block_idx].first_frame; frame_idx < frame_number; ++frame_idx)
+        {
+            if (not decoder_->decode(data_))
+            {
+                decoder_->start_block(0);
+                return std::unexpected{ fmt::format("Block {} of {:?} is corrupted", block_idx, input_filename_) };
+            }
+        }
+        return {};
+    }
+} // namespace srs::reader
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "srs/data/SRSDataStructs.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace srs::reader
+{
+    namespace internal
+    {
+        class CompactFrameDecoder;
+    } // namespace internal
+
+    //! Block recorded in the block index of a compact file
+    struct CompactBlockEntry
+    {
+        uint64_t offset{};      //!< Byte offset of the block header in the file
+        uint64_t first_frame{}; //!< Position of the first frame of the block in the file, starting from 0
+        uint32_t n_frames{};    //!< Number of frames in the block
+    };
+
+    /**
+     * \brief Reader of the compact struct output file (``.srsc``)
+     *
+     * The file starts with 8 bytes of the magic string "SRSCMP01", followed by the blocks of frames. Each block has a
+     * header with the payload size in bytes and the number of frames as two 4-byte integers. The payload is a sequence
+     * of 64-bit words, in which the values of the struct data are bit-packed with their true bit widths. The frame
+     * counters, UDP timestamps and marker timestamps are stored as differences, which are reset at the beginning of
+     * each block. Therefore, every block can be decoded independently.
+     *
+     * The file ends with the block index, i.e. one entry of 20 bytes per block (see srs::reader::CompactBlockEntry),
+     * and a footer with the byte offset of the index as an 8-byte integer and the magic string "SRSCIDX1". If the
+     * footer is missing, e.g. the file is still being written, the blocks are found by their headers. All integers
+     * are in little endian.
+     *
+     * The hit time, plane and strip, the clusters and the events are not stored.
+     */
+    class CompactFile
+    {
+      public:
+        static constexpr auto MAGIC = std::array{ 'S', 'R', 'S', 'C', 'M', 'P', '0', '1' };
+        static constexpr auto INDEX_MAGIC = std::array{ 'S', 'R', 'S', 'C', 'I', 'D', 'X', '1' };
+        static constexpr auto BLOCK_HEADER_SIZE = 2 * sizeof(uint32_t);
+        static constexpr auto INDEX_ENTRY_SIZE = (2 * sizeof(uint64_t)) + sizeof(uint32_t);
+        static constexpr auto FOOTER_SIZE = sizeof(uint64_t) + INDEX_MAGIC.size();
+
+        /**
+         * \brief Constructor that opens a compact file and loads its block index.
+         *
+         * Throws if the file cannot be opened or is not a compact file.
+         *
+         * @param filename The file name of the compact file
+         */
+        explicit CompactFile(const std::string& filename);
+
+        //! Deleted copy constructor
+        CompactFile(const CompactFile&) = delete;
+
+        //! Deleted copy assignment
+        CompactFile& operator=(const CompactFile&) = delete;
+
+        //! Default move constructor
+        CompactFile(CompactFile&&) noexcept;
+
+        //! Default move assignment
+        CompactFile& operator=(CompactFile&&) noexcept;
+
+        //! Default destructor
+        ~CompactFile();
+
+        /**
+         * \brief Read the next frame to a struct (inout).
+         *
+         * @param struct_data The struct data to store the frame.
+         * @return false if the end of the file is reached, or an error message if the block is corrupted.
+         */
+        auto read_one_frame(StructData& struct_data) -> std::expected<bool, std::string>;
+
+        /**
+         * \brief Read the next frame to a struct, owned by CompactFile.
+         *
+         * @return The pointer to the internal struct data, nullptr if the end of the file is reached, or an error
+         * message if the block is corrupted.
+         */
+        auto read_one_frame() -> std::expected<const StructData*, std::string>;
+
+        /**
+         * \brief Move to the frame with the given frame number.
+         *
+         * The block containing the frame is found in the block index and the frames before it in the block are
+         * decoded and skipped.
+         *
+         * @param frame_number Position of the frame in the file, starting from 0
+         */
+        auto seek_frame(uint64_t frame_number) -> std::expected<void, std::string>;
+
+        //! Blocks of the file
+        [[nodiscard]] auto get_blocks() const -> std::span<const CompactBlockEntry> { return blocks_; }
+
+        //! Total number of frames in the file
+        [[nodiscard]] auto get_n_frames() const -> uint64_t
+        {
+            return blocks_.empty() ? 0 : blocks_.back().first_frame + blocks_.back().n_frames;
+        }
+
+      private:
+        std::string input_filename_;                             //!< Input file name
+        std::ifstream input_file_;                               //!< Input file handler
+        std::vector<CompactBlockEntry> blocks_;                  //!< Block index
+        std::unique_ptr<internal::CompactFrameDecoder> decoder_; //!< Decoder of the current block
+        std::size_t next_block_ = 0;                             //!< Index of the next block to be loaded
+        StructData data_;                                        //!< Output of \ref read_one_frame()
+
+        auto load_index() -> bool;
+        void scan_blocks();
+        auto load_block(std::size_t block_idx) -> std::expected<void, std::string>;
+    };
+} // namespace srs::reader
@@ -0,0 +1,103 @@
+#include "srs/readers/FlatMsgReader.hpp"
+#include "srs/data/SRSDataFlat.hpp"
+#include "srs/data/SRSDataStructs.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <fmt/format.h>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace srs::reader
+{
+    auto FlatMsg::view(std::string_view msg) -> std::expected<View, std::string>
+    {
+        if (msg.size() < sizeof(FlatHeader))
+        {
+            return std::unexpected{ fmt::format("Message size {} is smaller than the header size {}",
+                                                msg.size(),
+                                                sizeof(FlatHeader)) };
+        }
+        if (reinterpret_cast<std::uintptr_t>(msg.data()) % alignof(FlatMarkerData) != 0)
+        {
+            return std::unexpected{ std::string{ "Message is not aligned to 8 bytes" } };
+        }
+
+        const auto* header = reinterpret_cast<const FlatHeader*>(msg.data());
+        if (header->magic != FLAT_DATA_MAGIC)
+        {
+            return std::unexpected{ fmt::format("Invalid magic number {:#x}", header->magic) };
+        }
+        if (header->version != FLAT_DATA_VERSION)
+        {
+            return std::unexpected{ fmt::format(
+                "Unsupported version {}. Version {} is expected.", header->version, FLAT_DATA_VERSION) };
+        }
+        if (header->header_size < sizeof(FlatHeader) or header->header_size % alignof(FlatMarkerData) != 0)
+        {
+            return std::unexpected{ fmt::format("Invalid header size {}", header->header_size) };
+        }
+
+        const auto marker_bytes = std::size_t{ header->n_markers } * sizeof(FlatMarkerData);
+        const auto hit_bytes = std::size_t{ header->n_hits } * sizeof(FlatHitData);
+        if (msg.size() != header->header_size + marker_bytes + hit_bytes)
+        {
+            return std::unexpected{ fmt::format("Message size {} doesn't match {} markers and {} hits",
+                                                msg.size(),
+                                                header->n_markers,
+                                                header->n_hits) };
+        }
+
+        const auto* marker_begin = msg.data() + header->header_size;
+        const auto* hit_begin = marker_begin + marker_bytes;
+        return View{ .header = header,
+                     .marker_data = std::span{ reinterpret_cast<const FlatMarkerData*>(marker_begin),
+                                               header->n_markers },
+                     .hit_data = std::span{ reinterpret_cast<const FlatHitData*>(hit_begin), header->n_hits } };
+    }
+
+    auto FlatMsg::convert(std::string_view msg, StructData& struct_data) -> std::expected<void, std::string>
+    {
+        return view(msg).transform(
+            [&struct_data](const View& msg_view) -> void
+            {
+                reset_struct_data(struct_data);
+
+                const auto& flat_header = *msg_view.header;
+                auto& header = struct_data.header;
+                header.frame_counter = flat_header.frame_counter;
+                header.vmm_tag = std::array{ 'V', 'M', '3' };
+                header.fec_id = flat_header.fec_id;
+                header.udp_timestamp = flat_header.udp_timestamp;
+                header.overflow = flat_header.overflow;
+
+                struct_data.marker_data.reserve(msg_view.marker_data.size());
+                for (const auto& flat_marker : msg_view.marker_data)
+                {
+                    auto& marker_data = struct_data.marker_data.emplace_back();
+                    marker_data.vmm_id = flat_marker.vmm_id;
+                    marker_data.srs_timestamp = flat_marker.srs_timestamp;
+                }
+
+                struct_data.hit_data.reserve(msg_view.hit_data.size());
+                for (const auto& flat_hit : msg_view.hit_data)
+                {
+                    auto& hit_data = struct_data.hit_data.emplace_back();
+                    hit_data.is_over_threshold = flat_hit.is_over_threshold != 0;
+                    hit_data.channel_num = flat_hit.channel_num;
+                    hit_data.tdc = flat_hit.tdc;
+                    hit_data.offset = flat_hit.offset;
+                    hit_data.vmm_id = flat_hit.vmm_id;
+                    hit_data.adc = flat_hit.adc;
+                    hit_data.bc_id = flat_hit.bc_id;
+                }
+            });
+    }
+
+    auto FlatMsg::convert(std::string_view msg) -> std::expected<const StructData*, std::string>
+    {
+        return convert(msg, data_).transform([this]() -> const StructData* { return &data_; });
+    }
+} // namespace srs::reader
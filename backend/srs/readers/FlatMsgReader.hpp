@@ -0,0 +1,57 @@
+#pragma once
+
+#include "srs/data/SRSDataFlat.hpp"
+#include "srs/data/SRSDataStructs.hpp"
+#include <expected>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace srs::reader
+{
+    class FlatMsg
+    {
+      public:
+        //! Non-owning view to a message in the fixed-layout wire format.
+        struct View
+        {
+            const FlatHeader* header = nullptr;          //!< Header of the message
+            std::span<const FlatMarkerData> marker_data; //!< Marker data
+            std::span<const FlatHitData> hit_data;       //!< Hit data
+        };
+
+        //! Default constructor. No memory allocation.
+        FlatMsg() = default;
+
+        /**
+         * \brief Map the binary data onto the fixed-layout structs without any copy.
+         *
+         * The binary data must stay alive as long as the returned view is used. Its address must be aligned to 8
+         * bytes, which is always the case for the buffers allocated by \a new or \a malloc.
+         *
+         * @param msg The input binary data.
+         * @return The view to the binary data, or an error message if the data is not a valid message.
+         */
+        static auto view(std::string_view msg) -> std::expected<View, std::string>;
+
+        /**
+         * \brief Convert binary data to a struct (inout).
+         *
+         * @param msg The input binary data.
+         * @param struct_data The struct data to store the binary data.
+         * @return An error message if the data is not a valid message.
+         */
+        static auto convert(std::string_view msg, StructData& struct_data) -> std::expected<void, std::string>;
+
+        /**
+         * \brief Convert binary data to a struct, owned by FlatMsg.
+         *
+         * @param msg The input binary data.
+         * @return The pointer to the internal struct data, or an error message if the data is not a valid message.
+         */
+        auto convert(std::string_view msg) -> std::expected<const StructData*, std::string>;
+
+      private:
+        StructData data_;
+    };
+} // namespace srs::reader
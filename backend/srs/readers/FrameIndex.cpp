@@ -0,0 +1,117 @@
+#include "srs/readers/FrameIndex.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fmt/format.h>
+#include <fstream>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <zpp_bits.h>
+
+namespace srs::reader
+{
+    FrameIndex::FrameIndex(const std::string& data_filename)
+    {
+        const auto index_filename = get_index_filename(data_filename);
+        auto index_file = std::ifstream{ index_filename, std::ios::binary };
+        if (not index_file.is_open())
+        {
+            throw std::runtime_error{ fmt::format("Cannot open the index file {:?}", index_filename) };
+        }
+        auto index_data = std::vector<char>{ std::istreambuf_iterator<char>{ index_file },
+                                             std::istreambuf_iterator<char>{} };
+        if (index_data.size() < HEADER_SIZE or
+            not std::ranges::equal(std::span{ index_data }.first(MAGIC.size()), MAGIC))
+        {
+            throw std::runtime_error{ fmt::format("{:?} is not a valid index file", index_filename) };
+        }
+
+        auto deserialize_from = zpp::bits::in{ index_data };
+        deserialize_from.position() = MAGIC.size();
+        auto interval = uint32_t{};
+        deserialize_from(interval).or_throw();
+        interval_ = interval;
+
+        // An incomplete entry at the end is ignored, e.g. if the data file is still being written.
+        const auto n_entries = (index_data.size() - HEADER_SIZE) / ENTRY_SIZE;
+        entries_.resize(n_entries);
+        for (auto& entry : entries_)
+        {
+            deserialize_from(entry.offset, entry.frame_number, entry.frame_counter, entry.udp_timestamp, entry.fec_id)
+                .or_throw();
+        }
+        data_size_ = std::filesystem::file_size(data_filename);
+    }
+
+    auto FrameIndex::get_index_filename(std::string_view data_filename) -> std::string
+    {
+        return fmt::format("{}.idx", data_filename);
+    }
+
+    auto FrameIndex::find_frame(uint64_t frame_number) const -> const FrameIndexEntry*
+    {
+        const auto iter = std::ranges::upper_bound(entries_, frame_number, {}, &FrameIndexEntry::frame_number);
+        return (iter == entries_.begin()) ? nullptr : &*std::prev(iter);
+    }
+
+    auto FrameIndex::find_time(uint8_t fec_id, uint32_t udp_timestamp) const -> const FrameIndexEntry*
+    {
+        const auto* found_entry = static_cast<const FrameIndexEntry*>(nullptr);
+        for (const auto& entry : entries_)
+        {
+            if (entry.fec_id != fec_id)
+            {
+                continue;
+            }
+            if (entry.udp_timestamp >= udp_timestamp)
+            {
+                break;
+            }
+            found_entry = &entry;
+        }
+        return found_entry;
+    }
+
+    auto FrameIndex::find_fec(uint8_t fec_id) const -> const FrameIndexEntry*
+    {
+        const auto iter = std::ranges::find(entries_, fec_id, &FrameIndexEntry::fec_id);
+        return (iter == entries_.end()) ? nullptr : &*iter;
+    }
+
+    auto FrameIndex::split(std::size_t n_ranges) const -> std::vector<FrameByteRange>
+    {
+        auto ranges = std::vector<FrameByteRange>{};
+        if (n_ranges == 0)
+        {
+            return ranges;
+        }
+        ranges.reserve(n_ranges);
+        auto current_range = FrameByteRange{};
+        for (auto range_idx : std::views::iota(std::size_t{ 1 }, n_ranges))
+        {
+            const auto split_point = data_size_ * range_idx / n_ranges;
+            auto iter = std::ranges::lower_bound(entries_, split_point, {}, &FrameIndexEntry::offset);
+            if (iter != entries_.begin() and
+                (iter == entries_.end() or split_point - std::prev(iter)->offset < iter->offset - split_point))
+            {
+                --iter;
+            }
+            if (iter == entries_.end() or iter->offset <= current_range.begin or iter->offset >= data_size_)
+            {
+                continue;
+            }
+            current_range.end = iter->offset;
+            ranges.push_back(current_range);
+            current_range = FrameByteRange{ .begin = iter->offset, .end = 0, .first_frame = iter->frame_number };
+        }
+        current_range.end = data_size_;
+        ranges.push_back(current_range);
+        return ranges;
+    }
+} // namespace srs::reader
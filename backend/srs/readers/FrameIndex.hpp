@@ -0,0 +1,108 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace srs::reader
+{
+    //! Frame recorded in the index file
+    struct FrameIndexEntry
+    {
+        uint64_t offset{};        //!< Byte offset of the frame, including its size prefix, in the data file
+        uint64_t frame_number{};  //!< Position of the frame in the data file, starting from 0
+        uint32_t frame_counter{}; //!< Frame counter from the frame header
+        uint32_t udp_timestamp{}; //!< UDP timestamp from the frame header
+        uint8_t fec_id{};         //!< FEC ID from the frame header
+    };
+
+    //! Byte range of the data file, which starts and ends at the frame boundaries
+    struct FrameByteRange
+    {
+        uint64_t begin{};       //!< Offset of the first frame
+        uint64_t end{};         //!< Offset after the last frame
+        uint64_t first_frame{}; //!< Frame number of the first frame
+    };
+
+    /**
+     * \brief Index of the frames in an uncompressed binary output file (``.bin``, ``.binpb`` or ``.pbc``)
+     *
+     * The index is written to a sidecar file, whose name is the name of the data file followed by ".idx", if
+     * srs::Config::frame_index_interval is not 0. It starts with 8 bytes of the magic string "SRSIDX01" and the index
+     * interval as a 4-byte integer, followed by one entry of 25 bytes for the first frame of each FEC and then for
+     * every interval frames of the same FEC. All integers are in little endian.
+     *
+     * The position found in the index is the closest indexed frame before the requested one. Readers then skip the
+     * remaining frames to reach the requested frame (see srs::reader::RawFrame::seek_frame).
+     */
+    class FrameIndex
+    {
+      public:
+        static constexpr auto MAGIC = std::array{ 'S', 'R', 'S', 'I', 'D', 'X', '0', '1' };
+        static constexpr auto HEADER_SIZE = MAGIC.size() + sizeof(uint32_t);
+        static constexpr auto ENTRY_SIZE = (2 * sizeof(uint64_t)) + (2 * sizeof(uint32_t)) + sizeof(uint8_t);
+
+        /**
+         * \brief Constructor that loads the index of a data file.
+         *
+         * Throws if the index file cannot be read.
+         *
+         * @param data_filename The file name of the data file, not of the index file
+         */
+        explicit FrameIndex(const std::string& data_filename);
+
+        //! Name of the index file of a data file
+        static auto get_index_filename(std::string_view data_filename) -> std::string;
+
+        //! Number of frames of a FEC between two entries of the FEC
+        [[nodiscard]] auto get_interval() const -> std::size_t { return interval_; }
+
+        //! Size of the data file when the index is loaded
+        [[nodiscard]] auto get_data_size() const -> uint64_t { return data_size_; }
+
+        [[nodiscard]] auto get_entries() const -> std::span<const FrameIndexEntry> { return entries_; }
+
+        /**
+         * \brief Find the last entry at or before the frame number.
+         *
+         * @return nullptr if no such entry exists. Reading from the beginning of the file is required then.
+         */
+        [[nodiscard]] auto find_frame(uint64_t frame_number) const -> const FrameIndexEntry*;
+
+        /**
+         * \brief Find the last entry of the FEC with a UDP timestamp earlier than the given timestamp.
+         *
+         * The first frame of the FEC at or after the timestamp is located after the entry. The timestamps of each FEC
+         * are assumed to be increasing in the file.
+         *
+         * @return nullptr if no such entry exists. Reading from the beginning of the file is required then.
+         */
+        [[nodiscard]] auto find_time(uint8_t fec_id, uint32_t udp_timestamp) const -> const FrameIndexEntry*;
+
+        /**
+         * \brief Find the first entry of the FEC, which is the first frame of the FEC in the data file.
+         *
+         * @return nullptr if the FEC doesn't exist in the index.
+         */
+        [[nodiscard]] auto find_fec(uint8_t fec_id) const -> const FrameIndexEntry*;
+
+        /**
+         * \brief Split the data file into byte ranges of similar sizes for parallel processing.
+         *
+         * The ranges are split at the indexed frames, which are closest to the even split points. Fewer ranges are
+         * returned if the index doesn't have enough entries.
+         *
+         * @param n_ranges Requested number of ranges
+         */
+        [[nodiscard]] auto split(std::size_t n_ranges) const -> std::vector<FrameByteRange>;
+
+      private:
+        std::size_t interval_ = 0;
+        uint64_t data_size_ = 0;
+        std::vector<FrameIndexEntry> entries_;
+    };
+} // namespace srs::reader
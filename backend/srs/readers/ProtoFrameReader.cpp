@@ -0,0 +1,430 @@
+#include "srs/readers/ProtoFrameReader.hpp"
+#include "srs/data/SRSDataStructs.hpp"
+#include "srs/readers/FrameIndex.hpp"
+#include "srs/readers/ProtoMsgReader.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <fmt/format.h>
+#include <fstream>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/gzip_stream.h>
+#include <google/protobuf/io/zero_copy_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <ios>
+#include <lz4frame.h>
+#include <magic_enum/magic_enum.hpp>
+#include <memory>
+#include <ranges>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <zstd.h>
+
+namespace srs::reader
+{
+    namespace
+    {
+        namespace io = google::protobuf::io;
+
+        constexpr auto GZIP_MAGIC = std::array<unsigned char, 2>{ 0x1f, 0x8b };
+        constexpr auto ZSTD_SKIPPABLE_MAGIC_MASK = 0xFFFFFFF0U;
+
+        auto decode_uint32_le(const std::array<char, sizeof(uint32_t)>& bytes) -> uint32_t
+        {
+            auto value = uint32_t{};
+            for (const auto byte : bytes | std::views::reverse)
+            {
+                value = (value << common::BYTE_BIT_LENGTH) | static_cast<unsigned char>(byte);
+            }
+            return value;
+        }
+
+        // Decompressed stream, which pulls the compressed data from a zero-copy stream.
+        class DecompressInputStream : public io::CopyingInputStream
+        {
+          public:
+            explicit DecompressInputStream(io::ZeroCopyInputStream* input)
+                : input_{ input }
+            {
+            }
+
+            [[nodiscard]] auto get_error() const -> const std::string& { return error_; }
+
+          protected:
+            // Returns false if no more compressed data is available.
+            auto fetch_input() -> bool
+            {
+                const void* data = nullptr;
+                auto size = 0;
+                while (input_buffer_.empty())
+                {
+                    if (not input_->Next(&data, &size))
+                    {
+                        return false;
+                    }
+                    input_buffer_ = std::string_view{ static_cast<const char*>(data), static_cast<std::size_t>(size) };
+                }
+                return true;
+            }
+
+            auto fail(std::string message) -> int
+            {
+                error_ = std::move(message);
+                return -1;
+            }
+
+            //! Compressed data that haven't been consumed by the decompressor
+            auto get_input_buffer() -> std::string_view& { return input_buffer_; }
+
+          private:
+            io::ZeroCopyInputStream* input_ = nullptr;
+            std::string_view input_buffer_;
+            std::string error_;
+        };
+
+        class ZstdInputStream : public DecompressInputStream
+        {
+          public:
+            ZstdInputStream(io::ZeroCopyInputStream* input, const std::vector<char>& dictionary)
+                : DecompressInputStream{ input }
+                , context_{ ZSTD_createDCtx() }
+            {
+                if (context_ == nullptr)
+                {
+                    throw std::runtime_error{ "Cannot create the zstd decompression context" };
+                }
+                if (not dictionary.empty())
+                {
+                    ZSTD_DCtx_loadDictionary(context_.get(), dictionary.data(), dictionary.size());
+                }
+            }
+
+            auto Read(void* buffer, int size) -> int override
+            {
+                auto output = ZSTD_outBuffer{ .dst = buffer, .size = static_cast<std::size_t>(size), .pos = 0 };
+                while (output.pos == 0)
+                {
+                    if (not fetch_input())
+                    {
+                        return 0;
+                    }
+                    auto& input_buffer = get_input_buffer();
+                    auto input = ZSTD_inBuffer{ .src = input_buffer.data(), .size = input_buffer.size(), .pos = 0 };
+                    const auto res = ZSTD_decompressStream(context_.get(), &output, &input);
+                    if (ZSTD_isError(res) != 0U)
+                    {
+                        return fail(fmt::format("zstd decompression error: {}", ZSTD_getErrorName(res)));
+                    }
+                    input_buffer.remove_prefix(input.pos);
+                }
+                return static_cast<int>(output.pos);
+            }
+
+          private:
+            struct ContextDeleter
+            {
+                void operator()(ZSTD_DCtx* context) const { ZSTD_freeDCtx(context); }
+            };
+            std::unique_ptr<ZSTD_DCtx, ContextDeleter> context_;
+        };
+
+        class Lz4InputStream : public DecompressInputStream
+        {
+          public:
+            explicit Lz4InputStream(io::ZeroCopyInputStream* input)
+                : DecompressInputStream{ input }
+            {
+                auto* context = static_cast<LZ4F_dctx*>(nullptr);
+                if (LZ4F_isError(LZ4F_createDecompressionContext(&context, LZ4F_VERSION)) != 0U)
+                {
+                    throw std::runtime_error{ "Cannot create the lz4 decompression context" };
+                }
+                context_.reset(context);
+            }
+
+            auto Read(void* buffer, int size) -> int override
+            {
+                auto output_size = std::size_t{};
+                while (output_size == 0)
+                {
+                    if (not fetch_input())
+                    {
+                        return 0;
+                    }
+                    auto& input_buffer = get_input_buffer();
+                    output_size = static_cast<std::size_t>(size);
+                    auto input_size = input_buffer.size();
+                    const auto res = LZ4F_decompress(
+                        context_.get(), buffer, &output_size, input_buffer.data(), &input_size, nullptr);
+                    if (LZ4F_isError(res) != 0U)
+                    {
+                        return fail(fmt::format("lz4 decompression error: {}", LZ4F_getErrorName(res)));
+                    }
+                    input_buffer.remove_prefix(input_size);
+                }
+                return static_cast<int>(output_size);
+            }
+
+          private:
+            struct ContextDeleter
+            {
+                void operator()(LZ4F_dctx* context) const { LZ4F_freeDecompressionContext(context); }
+            };
+            std::unique_ptr<LZ4F_dctx, ContextDeleter> context_;
+        };
+    } // namespace
+
+    struct ProtoFrame::Impl
+    {
+        std::string filename;
+        std::ifstream input_file;
+        common::CompressionType compression = common::CompressionType::none;
+        std::vector<char> zstd_dictionary;
+        std::unique_ptr<io::IstreamInputStream> file_input;
+        std::unique_ptr<io::ZeroCopyInputStream> frame_input;
+        DecompressInputStream* decompressor = nullptr; // owned by frame_input
+        std::string frame_buffer;
+        ProtoMsg proto_reader;
+        uint64_t offset = 0; // only for uncompressed files
+
+        explicit Impl(const std::string& input_filename)
+            : filename{ input_filename }
+            , input_file{ input_filename, std::ios::binary }
+        {
+            if (input_file.fail())
+            {
+                throw std::runtime_error{ fmt::format("Cannot open the file {:?}", filename) };
+            }
+            detect_compression();
+            spdlog::debug("Open the Protobuf binary file {:?} with the compression {}",
+                          filename,
+                          magic_enum::enum_name(compression));
+            file_input = std::make_unique<io::IstreamInputStream>(&input_file);
+            create_frame_input();
+        }
+
+        void detect_compression()
+        {
+            auto magic_bytes = std::array<char, sizeof(uint32_t)>{};
+            const auto read_size =
+                input_file.read(magic_bytes.data(), static_cast<std::streamsize>(magic_bytes.size())).gcount();
+            input_file.clear();
+            input_file.seekg(0, std::ios::beg);
+            if (read_size < static_cast<std::streamsize>(magic_bytes.size()))
+            {
+                return;
+            }
+
+            const auto magic = decode_uint32_le(magic_bytes);
+            if (static_cast<unsigned char>(magic_bytes[0]) == GZIP_MAGIC[0] and
+                static_cast<unsigned char>(magic_bytes[1]) == GZIP_MAGIC[1])
+            {
+                compression = common::CompressionType::gzip;
+            }
+            else if (magic == ZSTD_MAGICNUMBER)
+            {
+                compression = common::CompressionType::zstd;
+            }
+            else if ((magic & ZSTD_SKIPPABLE_MAGIC_MASK) == ZSTD_MAGIC_SKIPPABLE_START)
+            {
+                compression = common::CompressionType::zstd;
+                read_zstd_dictionary();
+            }
+            else if (magic == LZ4F_MAGICNUMBER)
+            {
+                compression = common::CompressionType::lz4;
+            }
+        }
+
+        // The skippable frame is consumed here, such that the decompression starts from the zstd frame afterwards.
+        void read_zstd_dictionary()
+        {
+            auto header = std::array<char, sizeof(uint32_t)>{};
+            // magic number followed by the frame size
+            input_file.read(header.data(), static_cast<std::streamsize>(header.size()));
+            input_file.read(header.data(), static_cast<std::streamsize>(header.size()));
+            zstd_dictionary.resize(decode_uint32_le(header));
+            input_file.read(zstd_dictionary.data(), static_cast<std::streamsize>(zstd_dictionary.size()));
+            if (input_file.fail())
+            {
+                throw std::runtime_error{ fmt::format("Cannot read the zstd dictionary from the file {:?}", filename) };
+            }
+            spdlog::debug("Load the zstd dictionary of {} bytes from the file {:?}", zstd_dictionary.size(), filename);
+        }
+
+        void create_frame_input()
+        {
+            using enum common::CompressionType;
+            switch (compression)
+            {
+                case gzip:
+                    frame_input = std::make_unique<io::GzipInputStream>(file_input.get(), io::GzipInputStream::GZIP);
+                    return;
+                case zstd:
+                {
+                    auto decoder = std::make_unique<ZstdInputStream>(file_input.get(), zstd_dictionary);
+                    decompressor = decoder.get();
+                    auto adaptor = std::make_unique<io::CopyingInputStreamAdaptor>(decoder.release());
+                    adaptor->SetOwnsCopyingStream(true);
+                    frame_input = std::move(adaptor);
+                    return;
+                }
+                case lz4:
+                {
+                    auto decoder = std::make_unique<Lz4InputStream>(file_input.get());
+                    decompressor = decoder.get();
+                    auto adaptor = std::make_unique<io::CopyingInputStreamAdaptor>(decoder.release());
+                    adaptor->SetOwnsCopyingStream(true);
+                    frame_input = std::move(adaptor);
+                    return;
+                }
+                case none:
+                    return;
+            }
+        }
+
+        auto get_frame_input() -> io::ZeroCopyInputStream*
+        {
+            return (frame_input == nullptr) ? file_input.get() : frame_input.get();
+        }
+    };
+
+    ProtoFrame::ProtoFrame(const std::string& filename)
+        : impl_{ std::make_unique<Impl>(filename) }
+    {
+    }
+
+    ProtoFrame::ProtoFrame(ProtoFrame&&) noexcept = default;
+    ProtoFrame& ProtoFrame::operator=(ProtoFrame&&) noexcept = default;
+    ProtoFrame::~ProtoFrame() = default;
+
+    auto ProtoFrame::read_one_message() -> std::expected<std::string_view, std::string>
+    {
+        // The coded stream returns the unused bytes to the underlying stream when it goes out of scope.
+        auto coded_input = io::CodedInputStream{ impl_->get_frame_input() };
+        auto size = uint32_t{};
+        if (not coded_input.ReadVarint32(&size))
+        {
+            if (impl_->decompressor != nullptr and not impl_->decompressor->get_error().empty())
+            {
+                return std::unexpected{ fmt::format(
+                    "Failed to read the file {:?}: {}", impl_->filename, impl_->decompressor->get_error()) };
+            }
+            return std::string_view{};
+        }
+        if (not coded_input.ReadString(&impl_->frame_buffer, static_cast<int>(size)))
+        {
+            return std::unexpected{ fmt::format(
+                "Incomplete frame with {} bytes at the end of the file {:?}", size, impl_->filename) };
+        }
+        impl_->offset += io::CodedOutputStream::VarintSize32(size) + size;
+        return impl_->frame_buffer;
+    }
+
+    auto ProtoFrame::read_one_frame() -> std::expected<const StructData*, std::string>
+    {
+        auto message = read_one_message();
+        if (not message.has_value())
+        {
+            return std::unexpected{ std::move(message.error()) };
+        }
+        if (message->empty())
+        {
+            return nullptr;
+        }
+        return &impl_->proto_reader.convert(message.value());
+    }
+
+    auto ProtoFrame::get_offset() const -> uint64_t { return impl_->offset; }
+
+    auto ProtoFrame::seek(uint64_t offset) -> std::expected<void, std::string>
+    {
+        if (impl_->compression != common::CompressionType::none)
+        {
+            return std::unexpected{ fmt::format("Cannot seek in the compressed file {:?}", impl_->filename) };
+        }
+        // The input stream buffers the data read from the file, which is discarded by recreating it.
+        impl_->file_input.reset();
+        impl_->input_file.clear();
+        impl_->input_file.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+        if (impl_->input_file.fail())
+        {
+            return std::unexpected{ fmt::format("Cannot seek to {} in the file {:?}", offset, impl_->filename) };
+        }
+        impl_->file_input = std::make_unique<io::IstreamInputStream>(&impl_->input_file);
+        impl_->offset = offset;
+        return {};
+    }
+
+    auto ProtoFrame::seek_frame(const FrameIndex& index, uint64_t frame_number) -> std::expected<void, std::string>
+    {
+        const auto* entry = index.find_frame(frame_number);
+        if (auto res = seek((entry == nullptr) ? 0 : entry->offset); not res.has_value())
+        {
+            return res;
+        }
+        for (auto current_frame = (entry == nullptr) ? 0 : entry->frame_number; current_frame < frame_number;
+             ++current_frame)
+        {
+            auto frame = read_one_frame();
+            if (not frame.has_value())
+            {
+                return std::unexpected{ frame.error() };
+            }
+            if (frame.value() == nullptr)
+            {
+                return std::unexpected{ fmt::format(
+                    "Frame {} is beyond the end of the file {:?}", frame_number, impl_->filename) };
+            }
+        }
+        return {};
+    }
+
+    auto ProtoFrame::seek_time(const FrameIndex& index, uint8_t fec_id, uint32_t udp_timestamp)
+        -> std::expected<void, std::string>
+    {
+        const auto* entry = index.find_time(fec_id, udp_timestamp);
+        if (auto res = seek((entry == nullptr) ? 0 : entry->offset); not res.has_value())
+        {
+            return res;
+        }
+        while (true)
+        {
+            const auto frame_offset = impl_->offset;
+            auto frame = read_one_frame();
+            if (not frame.has_value())
+            {
+                return std::unexpected{ frame.error() };
+            }
+            if (frame.value() == nullptr)
+            {
+                return std::unexpected{ fmt::format("No frame of FEC {} at or after the timestamp {} in the file {:?}",
+                                                    fec_id,
+                                                    udp_timestamp,
+                                                    impl_->filename) };
+            }
+            const auto& header = frame.value()->header;
+            if (header.fec_id == fec_id and header.udp_timestamp >= udp_timestamp)
+            {
+                return seek(frame_offset);
+            }
+        }
+    }
+
+    auto ProtoFrame::seek_fec(const FrameIndex& index, uint8_t fec_id) -> std::expected<void, std::string>
+    {
+        const auto* entry = index.find_fec(fec_id);
+        if (entry == nullptr)
+        {
+            return std::unexpected{ fmt::format("FEC {} isn't found in the index of {:?}", fec_id, impl_->filename) };
+        }
+        return seek(entry->offset);
+    }
+} // namespace srs::reader
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "srs/data/SRSDataStructs.hpp"
+#include "srs/readers/FrameIndex.hpp"
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace srs::reader
+{
+    class ProtoFrame
+    {
+      public:
+        /**
+         * \brief Constructor that opens a Protobuf binary file (``.binpb`` or ``.pbc``) with the given filename.
+         *
+         * The compression type of the file (none, gzip, zstd or lz4) is determined from its first bytes. If the file
+         * is compressed with zstd and a dictionary, the dictionary is loaded from the skippable frame at the beginning
+         * of the file.
+         *
+         * @param filename The file name of the input binary
+         */
+        explicit ProtoFrame(const std::string& filename);
+
+        //! Deleted copy constructor
+        ProtoFrame(const ProtoFrame&) = delete;
+
+        //! Deleted copy assignment
+        ProtoFrame& operator=(const ProtoFrame&) = delete;
+
+        //! Default move constructor
+        ProtoFrame(ProtoFrame&&) noexcept;
+
+        //! Default move assignment
+        ProtoFrame& operator=(ProtoFrame&&) noexcept;
+
+        //! Default destructor
+        ~ProtoFrame();
+
+        /**
+         * \brief Read one frame from the file and convert it to the C++ struct.
+         *
+         * Both proto::Data and proto::PackedData messages are accepted.
+         *
+         * @return The pointer to the internal struct data, which is valid until the next read. nullptr if the end of
+         * the file is reached.
+         */
+        auto read_one_frame() -> std::expected<const StructData*, std::string>;
+
+        /**
+         * \brief Read one serialized message from the file without any conversion.
+         *
+         * @return Non-owning serialized message, which is valid until the next read. Empty if the end of the file is
+         * reached.
+         */
+        auto read_one_message() -> std::expected<std::string_view, std::string>;
+
+        //! Byte offset of the next frame read by \ref read_one_frame() in an uncompressed file
+        [[nodiscard]] auto get_offset() const -> uint64_t;
+
+        /**
+         * \brief Move to the frame at the byte offset of an uncompressed file.
+         *
+         * @param offset Byte offset of a frame, e.g. from srs::reader::FrameIndex or srs::reader::FrameByteRange
+         */
+        auto seek(uint64_t offset) -> std::expected<void, std::string>;
+
+        //! Move to the frame with the given frame number of an uncompressed file, see RawFrame::seek_frame.
+        auto seek_frame(const FrameIndex& index, uint64_t frame_number) -> std::expected<void, std::string>;
+
+        //! Move to the first frame of the FEC at or after the UDP timestamp, see RawFrame::seek_time.
+        auto seek_time(const FrameIndex& index, uint8_t fec_id, uint32_t udp_timestamp)
+            -> std::expected<void, std::string>;
+
+        //! Move to the first frame of the FEC, which is always recorded in the index.
+        auto seek_fec(const FrameIndex& index, uint8_t fec_id) -> std::expected<void, std::string>;
+
+      private:
+        struct Impl;
+        std::unique_ptr<Impl> impl_;
+    };
+} // namespace srs::reader
@@ -17,12 +17,23 @@ namespace srs::reader
 
     void ProtoMsg::convert(std::string_view msg, StructData& struct_data)
     {
+        if (process::ProtoDeserializer::is_packed(msg))
+        {
+            const auto& prot_struct = proto_deserializer_->convert_packed(msg);
+            process::Proto2StructConverter::convert(prot_struct, struct_data);
+            return;
+        }
         const auto& prot_struct = proto_deserializer_->convert(msg);
         process::Proto2StructConverter::convert(prot_struct, struct_data);
     }
 
     auto ProtoMsg::convert(std::string_view msg) -> const StructData&
     {
+        if (process::ProtoDeserializer::is_packed(msg))
+        {
+            const auto& prot_struct = proto_deserializer_->convert_packed(msg);
+            return proto_to_struct_converter_->convert(prot_struct);
+        }
         const auto& prot_struct = proto_deserializer_->convert(msg);
         return proto_to_struct_converter_->convert(prot_struct);
     }
@@ -40,6 +40,9 @@ namespace srs
             /**
              * Convert binary data to a struct (inout).
              *
+             * Both proto::Data and the column-oriented proto::PackedData messages are accepted. The schema is
+             * determined from the first byte of the message.
+             *
              * @param msg The input binary data.
              * @param struct_data The struct data to store the deserialized binary data.
              */
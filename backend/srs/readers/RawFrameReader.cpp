@@ -1,23 +1,249 @@
 #include "srs/readers/RawFrameReader.hpp"
+#include "srs/converters/FrameHeaderParser.hpp"
+#include "srs/readers/FrameIndex.hpp"
 #include "srs/utils/CommonDefinitions.hpp"
+#include <algorithm>
 #include <array>
+#include <asio/post.hpp>
+#include <asio/thread_pool.hpp>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <expected>
 #include <fmt/format.h>
 #include <fstream>
+#include <future>
 #include <ios>
+#include <memory>
+#include <optional>
+#include <span>
 #include <spdlog/spdlog.h>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 #include <zpp_bits.h>
+#include <zstd.h>
 
 namespace srs::reader
 {
+    /**
+     * @brief Decoder of the raw binary file compressed in zstd blocks
+     *
+     * Compressed blocks are read ahead from the file and decompressed on a thread pool, while the frames are taken
+     * from the oldest decompressed block.
+     */
+    class RawBlockDecoder
+    {
+      public:
+        explicit RawBlockDecoder(std::size_t n_threads)
+            : thread_pool_{ n_threads }
+            , max_pending_blocks_{ common::RAW_BLOCK_MAX_PENDING_PER_THREAD * n_threads }
+        {
+        }
+
+        auto read_one_frame(std::vector<char>& binary_data, std::ifstream& input_file)
+            -> std::expected<std::size_t, std::string>
+        {
+            while (position_ >= current_block_.data.size())
+            {
+                if (auto res = read_ahead(input_file); not res.has_value())
+                {
+                    return std::unexpected{ std::move(res.error()) };
+                }
+                if (pending_blocks_.empty())
+                {
+                    binary_data.clear();
+                    return 0;
+                }
+                if (auto res = take_block(); not res.has_value())
+                {
+                    return std::unexpected{ std::move(res.error()) };
+                }
+            }
+            return extract_frame(binary_data);
+        }
+
+        void reset()
+        {
+            pending_blocks_.clear();
+            current_block_ = Block{};
+            position_ = 0;
+            n_frames_read_ = 0;
+            is_input_end_ = false;
+        }
+
+      private:
+        struct Block
+        {
+            uint64_t first_frame_index = 0;
+            uint32_t n_frames = 0;
+            std::vector<char> data;
+            std::string error;
+        };
+
+        asio::thread_pool thread_pool_;
+        std::size_t max_pending_blocks_ = 1;
+        std::deque<std::future<Block>> pending_blocks_;
+        Block current_block_;
+        std::size_t position_ = 0;
+        uint64_t n_frames_read_ = 0;
+        bool is_input_end_ = false;
+
+        auto read_ahead(std::ifstream& input_file) -> std::expected<void, std::string>
+        {
+            while (not is_input_end_ and pending_blocks_.size() < max_pending_blocks_)
+            {
+                auto block = read_compressed_block(input_file);
+                if (not block.has_value())
+                {
+                    return std::unexpected{ std::move(block.error()) };
+                }
+                if (not block->has_value())
+                {
+                    is_input_end_ = true;
+                    break;
+                }
+                auto task = std::packaged_task<Block()>{ [block = std::move(block->value())]() mutable
+                                                         { return decompress(std::move(block)); } };
+                pending_blocks_.push_back(task.get_future());
+                asio::post(thread_pool_, std::move(task));
+            }
+            return {};
+        }
+
+        auto take_block() -> std::expected<void, std::string>
+        {
+            current_block_ = pending_blocks_.front().get();
+            pending_blocks_.pop_front();
+            position_ = 0;
+            if (not current_block_.error.empty())
+            {
+                return std::unexpected{ std::move(current_block_.error) };
+            }
+            if (current_block_.first_frame_index != n_frames_read_)
+            {
+                spdlog::warn("Compressed raw file: block starts at frame {} while {} frames have been read",
+                             current_block_.first_frame_index,
+                             n_frames_read_);
+                n_frames_read_ = current_block_.first_frame_index;
+            }
+            return {};
+        }
 
-    RawFrame::RawFrame(const std::string& filename)
+        auto extract_frame(std::vector<char>& binary_data) -> std::expected<std::size_t, std::string>
+        {
+            auto remaining = std::span{ current_block_.data }.subspan(position_);
+            auto size_buffer = std::array<char, sizeof(common::RawDelimSizeType)>{};
+            auto size = common::RawDelimSizeType{};
+            if (remaining.size() < size_buffer.size())
+            {
+                return std::unexpected{ fmt::format("Truncated frame size in the block starting at frame {}",
+                                                    current_block_.first_frame_index) };
+            }
+            std::ranges::copy(remaining.first(size_buffer.size()), size_buffer.begin());
+            auto deserialize_to = zpp::bits::in{ size_buffer, zpp::bits::endian::big{} };
+            deserialize_to(size).or_throw();
+            remaining = remaining.subspan(sizeof(size));
+            if (remaining.size() < size)
+            {
+                return std::unexpected{ fmt::format("Frame {} with {} bytes exceeds the block starting at frame {}",
+                                                    n_frames_read_,
+                                                    size,
+                                                    current_block_.first_frame_index) };
+            }
+            binary_data.assign(remaining.begin(), remaining.begin() + size);
+            position_ += sizeof(size) + size;
+            ++n_frames_read_;
+            return size;
+        }
+
+        // Returns std::nullopt at the end of the file. Skippable frames that are not block headers are ignored.
+        static auto read_compressed_block(std::ifstream& input_file)
+            -> std::expected<std::optional<Block>, std::string>
+        {
+            while (true)
+            {
+                auto frame_header = std::array<char, sizeof(uint32_t) * 2>{};
+                input_file.read(frame_header.data(), static_cast<std::streamsize>(frame_header.size()));
+                const auto read_size = input_file.gcount();
+                if (read_size == 0)
+                {
+                    return std::nullopt;
+                }
+                if (read_size != static_cast<std::streamsize>(frame_header.size()))
+                {
+                    return std::unexpected{ std::string{ "Truncated block header at the end of the file" } };
+                }
+                auto magic = uint32_t{};
+                auto frame_size = uint32_t{};
+                auto deserialize_to = zpp::bits::in{ frame_header, zpp::bits::endian::little{} };
+                deserialize_to(magic, frame_size).or_throw();
+
+                if ((magic & ZSTD_MAGIC_SKIPPABLE_MASK) != ZSTD_MAGIC_SKIPPABLE_START)
+                {
+                    return std::unexpected{ fmt::format("Unexpected block magic number {:#010x}", magic) };
+                }
+                if (magic != common::RAW_BLOCK_SKIPPABLE_MAGIC or frame_size != common::RAW_BLOCK_METADATA_SIZE)
+                {
+                    input_file.seekg(frame_size, std::ios::cur);
+                    continue;
+                }
+
+                auto metadata = std::array<char, common::RAW_BLOCK_METADATA_SIZE>{};
+                input_file.read(metadata.data(), static_cast<std::streamsize>(metadata.size()));
+                auto block = Block{};
+                auto compressed_size = uint32_t{};
+                auto deserialize_metadata = zpp::bits::in{ metadata, zpp::bits::endian::little{} };
+                deserialize_metadata(block.first_frame_index, block.n_frames, compressed_size).or_throw();
+
+                block.data.resize(compressed_size);
+                input_file.read(block.data.data(), static_cast<std::streamsize>(compressed_size));
+                if (input_file.gcount() != static_cast<std::streamsize>(compressed_size))
+                {
+                    return std::unexpected{ fmt::format("Truncated block starting at frame {}",
+                                                        block.first_frame_index) };
+                }
+                return block;
+            }
+        }
+
+        // Executed in the worker threads. Each thread keeps its own decompression context.
+        static auto decompress(Block block) -> Block
+        {
+            struct ContextDeleter
+            {
+                void operator()(ZSTD_DCtx* context) const { ZSTD_freeDCtx(context); }
+            };
+            thread_local auto context = std::unique_ptr<ZSTD_DCtx, ContextDeleter>{ ZSTD_createDCtx() };
+
+            const auto content_size = ZSTD_getFrameContentSize(block.data.data(), block.data.size());
+            if (content_size == ZSTD_CONTENTSIZE_ERROR or content_size == ZSTD_CONTENTSIZE_UNKNOWN)
+            {
+                block.error = fmt::format("Invalid zstd frame in the block starting at frame {}",
+                                          block.first_frame_index);
+                return block;
+            }
+            auto output = std::vector<char>(content_size);
+            const auto size = ZSTD_decompressDCtx(
+                context.get(), output.data(), output.size(), block.data.data(), block.data.size());
+            if (ZSTD_isError(size) != 0U)
+            {
+                block.error = fmt::format("Failed to decompress the block starting at frame {}: {}",
+                                          block.first_frame_index,
+                                          ZSTD_getErrorName(size));
+                return block;
+            }
+            output.resize(size);
+            block.data = std::move(output);
+            return block;
+        }
+    };
+
+    RawFrame::RawFrame() = default;
+
+    RawFrame::RawFrame(const std::string& filename, std::size_t n_threads)
         : input_filename_{ filename }
         , input_file_{ filename, std::ios::binary }
     {
@@ -25,9 +251,23 @@ namespace srs::reader
         {
             throw std::runtime_error{ fmt::format("Cannot open the file {:?}", input_filename_) };
         }
-        spdlog::debug("Open the binary file {:?}", input_filename_);
+
+        // Only the first byte is checked without any seeking, such that FIFO files can still be used. The first byte of
+        // an uncompressed file is the most significant byte of the frame size, which must be 0 for any UDP frame.
+        static constexpr auto BLOCK_MAGIC_FIRST_BYTE = static_cast<int>(common::RAW_BLOCK_SKIPPABLE_MAGIC & 0xffU);
+        if (input_file_.peek() == BLOCK_MAGIC_FIRST_BYTE)
+        {
+            block_decoder_ = std::make_unique<RawBlockDecoder>(std::max(n_threads, std::size_t{ 1 }));
+        }
+        input_file_.clear();
+        spdlog::debug(
+            "Open the binary file {:?}{}", input_filename_, is_compressed() ? " compressed in zstd blocks" : "");
     }
 
+    RawFrame::RawFrame(RawFrame&&) noexcept = default;
+    RawFrame& RawFrame::operator=(RawFrame&&) noexcept = default;
+    RawFrame::~RawFrame() = default;
+
     auto RawFrame::read_one_frame(std::vector<char>& binary_data, std::ifstream& input_file)
         -> std::expected<std::size_t, std::string>
     {
@@ -62,15 +302,106 @@ namespace srs::reader
     {
         input_file_.clear();
         input_file_.seekg(0, std::ios::beg);
+        offset_ = 0;
+        if (block_decoder_ != nullptr)
+        {
+            block_decoder_->reset();
+        }
     }
 
     auto RawFrame::read_one_frame() -> std::expected<std::string_view, std::string>
     {
-        auto res = read_one_frame(input_buffer_, input_file_);
+        auto res = (block_decoder_ != nullptr) ? block_decoder_->read_one_frame(input_buffer_, input_file_)
+                                               : read_one_frame(input_buffer_, input_file_);
         if (res.has_value())
         {
+            if (block_decoder_ == nullptr and res.value() > 0)
+            {
+                offset_ += sizeof(common::RawDelimSizeType) + res.value();
+            }
             return std::string_view{ input_buffer_.data(), input_buffer_.size() };
         }
         return std::unexpected{ res.error() };
     }
+
+    auto RawFrame::seek(uint64_t offset) -> std::expected<void, std::string>
+    {
+        if (block_decoder_ != nullptr)
+        {
+            return std::unexpected{ fmt::format("Cannot seek in the compressed file {:?}", input_filename_) };
+        }
+        input_file_.clear();
+        input_file_.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+        if (input_file_.fail())
+        {
+            return std::unexpected{ fmt::format("Cannot seek to {} in the file {:?}", offset, input_filename_) };
+        }
+        offset_ = offset;
+        return {};
+    }
+
+    auto RawFrame::seek_frame(const FrameIndex& index, uint64_t frame_number) -> std::expected<void, std::string>
+    {
+        const auto* entry = index.find_frame(frame_number);
+        if (auto res = seek((entry == nullptr) ? 0 : entry->offset); not res.has_value())
+        {
+            return res;
+        }
+        for (auto current_frame = (entry == nullptr) ? 0 : entry->frame_number; current_frame < frame_number;
+             ++current_frame)
+        {
+            auto frame = read_one_frame();
+            if (not frame.has_value())
+            {
+                return std::unexpected{ frame.error() };
+            }
+            if (frame->empty())
+            {
+                return std::unexpected{ fmt::format(
+                    "Frame {} is beyond the end of the file {:?}", frame_number, input_filename_) };
+            }
+        }
+        return {};
+    }
+
+    auto RawFrame::seek_time(const FrameIndex& index, uint8_t fec_id, uint32_t udp_timestamp)
+        -> std::expected<void, std::string>
+    {
+        const auto* entry = index.find_time(fec_id, udp_timestamp);
+        if (auto res = seek((entry == nullptr) ? 0 : entry->offset); not res.has_value())
+        {
+            return res;
+        }
+        while (true)
+        {
+            const auto frame_offset = offset_;
+            auto frame = read_one_frame();
+            if (not frame.has_value())
+            {
+                return std::unexpected{ frame.error() };
+            }
+            if (frame->empty())
+            {
+                return std::unexpected{ fmt::format("No frame of FEC {} at or after the timestamp {} in the file {:?}",
+                                                    fec_id,
+                                                    udp_timestamp,
+                                                    input_filename_) };
+            }
+            const auto header = process::parse_frame_header(frame.value());
+            if (header.has_value() and header->fec_id == fec_id and header->udp_timestamp >= udp_timestamp)
+            {
+                return seek(frame_offset);
+            }
+        }
+    }
+
+    auto RawFrame::seek_fec(const FrameIndex& index, uint8_t fec_id) -> std::expected<void, std::string>
+    {
+        const auto* entry = index.find_fec(fec_id);
+        if (entry == nullptr)
+        {
+            return std::unexpected{ fmt::format("FEC {} isn't found in the index of {:?}", fec_id, input_filename_) };
+        }
+        return seek(entry->offset);
+    }
 } // namespace srs::reader
@@ -1,27 +1,52 @@
 #pragma once
 
+#include "srs/readers/FrameIndex.hpp"
 #include <cstddef>
+#include <cstdint>
 #include <expected>
 #include <fstream>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <vector>
 
 namespace srs::reader
 {
+    class RawBlockDecoder;
+
     class RawFrame
     {
       public:
         //! Default Constructor. No memory allocation.
-        explicit RawFrame() = default;
+        explicit RawFrame();
 
         /**
          * \brief Constructor that opens a file with the given filename.
          *
+         * If the file is compressed in zstd blocks (see srs::Config::raw_compression_block_size), the blocks are
+         * decompressed transparently by \ref read_one_frame(). Multiple blocks are decompressed in parallel if
+         * \a n_threads is larger than 1.
+         *
          * @param filename The file name of the input binary
+         * @param n_threads Number of threads to decompress the blocks of a compressed file
          *
          */
-        explicit RawFrame(const std::string& filename);
+        explicit RawFrame(const std::string& filename, std::size_t n_threads = 1);
+
+        //! Deleted copy constructor
+        RawFrame(const RawFrame&) = delete;
+
+        //! Deleted copy assignment
+        RawFrame& operator=(const RawFrame&) = delete;
+
+        //! Default move constructor
+        RawFrame(RawFrame&&) noexcept;
+
+        //! Default move assignment
+        RawFrame& operator=(RawFrame&&) noexcept;
+
+        //! Default destructor
+        ~RawFrame();
 
         /**
          *
@@ -32,6 +57,8 @@ namespace srs::reader
          * \a size value, which is read from the binary file in the beginning. The vector is then set with \a size bytes
          * of data from the file.
          *
+         * Only uncompressed files are supported with the external file handler.
+         *
          * @param binary_data The vector of chars to be filled.
          * @param input_file Input file handler.
          * @return The amount of bytes read from the binary file. If the binary input file is not open, return 0.
@@ -55,11 +82,51 @@ namespace srs::reader
         //! Getter to the internal binary data used by the member function \ref read_one_frame().
         auto get_binary_data() const -> const auto& { return input_buffer_; }
 
+        //! Check whether the input file is compressed in zstd blocks.
+        [[nodiscard]] auto is_compressed() const -> bool { return block_decoder_ != nullptr; }
+
         void reset();
 
+        //! Byte offset of the next frame read by \ref read_one_frame() in an uncompressed file
+        [[nodiscard]] auto get_offset() const -> uint64_t { return offset_; }
+
+        /**
+         * \brief Move to the frame at the byte offset of an uncompressed file.
+         *
+         * @param offset Byte offset of a frame, e.g. from srs::reader::FrameIndex or srs::reader::FrameByteRange
+         */
+        auto seek(uint64_t offset) -> std::expected<void, std::string>;
+
+        /**
+         * \brief Move to the frame with the given frame number of an uncompressed file.
+         *
+         * The reading starts from the closest indexed frame and the frames in between are skipped.
+         *
+         * @param index Index of the file
+         * @param frame_number Position of the frame in the file, starting from 0
+         */
+        auto seek_frame(const FrameIndex& index, uint64_t frame_number) -> std::expected<void, std::string>;
+
+        /**
+         * \brief Move to the first frame of the FEC with a UDP timestamp at or after the given one.
+         *
+         * The reading starts from the closest indexed frame and the frame headers in between are checked.
+         *
+         * @param index Index of the file
+         * @param fec_id FEC ID
+         * @param udp_timestamp UDP timestamp
+         */
+        auto seek_time(const FrameIndex& index, uint8_t fec_id, uint32_t udp_timestamp)
+            -> std::expected<void, std::string>;
+
+        //! Move to the first frame of the FEC, which is always recorded in the index.
+        auto seek_fec(const FrameIndex& index, uint8_t fec_id) -> std::expected<void, std::string>;
+
       private:
-        std::string input_filename_;     //!< Input binary file name.
-        std::ifstream input_file_;       //!< Input binary file handler
-        std::vector<char> input_buffer_; //!< internal binary data buffer
+        std::string input_filename_;                     //!< Input binary file name.
+        std::ifstream input_file_;                       //!< Input binary file handler
+        std::vector<char> input_buffer_;                 //!< internal binary data buffer
+        std::unique_ptr<RawBlockDecoder> block_decoder_; //!< decoder of the zstd blocks if compressed
+        uint64_t offset_ = 0;                            //!< byte offset of the next frame if uncompressed
     };
 } // namespace srs::reader
@@ -0,0 +1,504 @@
+#ifdef HAS_ARROW
+#include "ArrowFileWriter.hpp"
+#include "FileRotator.hpp"
+#include "srs/converters/DataConvertOptions.hpp"
+#include "srs/data/SRSDataStructs.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
+#include "srs/workflow/BaseTask.hpp"
+#include <algorithm>
+#include <arrow/api.h>
+#include <arrow/io/file.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/util/compression.h>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <initializer_list>
+#include <memory>
+#include <parquet/arrow/writer.h>
+#include <parquet/properties.h>
+#include <ranges>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace srs::sink
+{
+    namespace
+    {
+        // Order of the columns in the schema
+        enum Column : uint8_t
+        {
+            frame_counter,
+            fec_id,
+            udp_timestamp,
+            overflow,
+            markers,
+            hits,
+            hit_time,
+            hit_plane,
+            hit_strip,
+            clusters,
+        };
+
+        // Columns with monotonic values, for which the delta encoding is much more efficient than the dictionary
+        constexpr auto DELTA_ENCODED_COLUMNS = std::array{
+            "frame_counter",
+            "udp_timestamp",
+            "markers.list.element.srs_timestamp",
+            "hit_time.list.element",
+            "clusters.list.element.time",
+        };
+
+        auto make_schema() -> std::shared_ptr<arrow::Schema>
+        {
+            auto marker_type = arrow::struct_({ arrow::field("vmm_id", arrow::uint8(), false),
+                                                arrow::field("srs_timestamp", arrow::uint64(), false) });
+            auto hit_type = arrow::struct_({ arrow::field("is_over_threshold", arrow::boolean(), false),
+                                             arrow::field("channel_num", arrow::uint8(), false),
+                                             arrow::field("tdc", arrow::uint8(), false),
+                                             arrow::field("offset", arrow::uint8(), false),
+                                             arrow::field("vmm_id", arrow::uint8(), false),
+                                             arrow::field("adc", arrow::uint16(), false),
+                                             arrow::field("bc_id", arrow::uint16(), false) });
+            auto cluster_type = arrow::struct_({ arrow::field("time", arrow::uint64(), false),
+                                                 arrow::field("centroid", arrow::float32(), false),
+                                                 arrow::field("charge", arrow::uint32(), false),
+                                                 arrow::field("size", arrow::uint16(), false),
+                                                 arrow::field("plane", arrow::uint8(), false) });
+            return arrow::schema({ arrow::field("frame_counter", arrow::uint32(), false),
+                                   arrow::field("fec_id", arrow::uint8(), false),
+                                   arrow::field("udp_timestamp", arrow::uint32(), false),
+                                   arrow::field("overflow", arrow::uint32(), false),
+                                   arrow::field("markers", arrow::list(marker_type), false),
+                                   arrow::field("hits", arrow::list(hit_type), false),
+                                   arrow::field("hit_time", arrow::list(arrow::uint64()), false),
+                                   arrow::field("hit_plane", arrow::list(arrow::uint8()), false),
+                                   arrow::field("hit_strip", arrow::list(arrow::uint16()), false),
+                                   arrow::field("clusters", arrow::list(cluster_type), false) });
+        }
+
+        auto get_arrow_compression(common::CompressionType compression, bool is_parquet) -> arrow::Compression::type
+        {
+            switch (compression)
+            {
+                case common::CompressionType::none:
+                    return arrow::Compression::UNCOMPRESSED;
+                case common::CompressionType::gzip:
+                    return arrow::Compression::GZIP;
+                case common::CompressionType::zstd:
+                    return arrow::Compression::ZSTD;
+                case common::CompressionType::lz4:
+                    // Arrow IPC only supports the LZ4 frame format.
+                    return is_parquet ? arrow::Compression::LZ4 : arrow::Compression::LZ4_FRAME;
+            }
+            return arrow::Compression::UNCOMPRESSED;
+        }
+
+        auto get_parquet_properties(const ArrowFile::Options& options) -> std::shared_ptr<parquet::WriterProperties>
+        {
+            auto builder = parquet::WriterProperties::Builder{};
+            builder.enable_dictionary()
+                ->max_row_group_length(static_cast<int64_t>(options.row_group_size))
+                ->compression(get_arrow_compression(options.compression, true));
+            if (options.compression_level != 0)
+            {
+                builder.compression_level(options.compression_level);
+            }
+            for (const auto* column : DELTA_ENCODED_COLUMNS)
+            {
+                builder.disable_dictionary(column)->encoding(column, parquet::Encoding::DELTA_BINARY_PACKED);
+            }
+            return builder.build();
+        }
+
+        template <typename Builder>
+        auto get_child(arrow::StructBuilder* parent, int index) -> Builder*
+        {
+            return static_cast<Builder*>(parent->field_builder(index));
+        }
+
+        auto reserve(int64_t size, std::initializer_list<arrow::ArrayBuilder*> builders) -> arrow::Status
+        {
+            for (auto* builder : builders)
+            {
+                ARROW_RETURN_NOT_OK(builder->Reserve(size));
+            }
+            return arrow::Status::OK();
+        }
+
+        template <typename ValueBuilder, typename ValueType>
+        auto append_list(arrow::ListBuilder& list_builder, const std::vector<ValueType>& values) -> arrow::Status
+        {
+            ARROW_RETURN_NOT_OK(list_builder.Append());
+            return static_cast<ValueBuilder*>(list_builder.value_builder())
+                ->AppendValues(values.data(), static_cast<int64_t>(values.size()));
+        }
+
+        void check_status(const arrow::Status& status, std::string_view filename)
+        {
+            if (not status.ok())
+            {
+                spdlog::critical("ArrowWriter: error occurred with the file {:?}: {}", filename, status.ToString());
+                throw std::runtime_error("Error occurred with ArrowWriter");
+            }
+        }
+    } // namespace
+
+    namespace internal
+    {
+        // Column builders and the file writer of the current file of one line
+        class ArrowLineWriter
+        {
+          public:
+            ArrowLineWriter(bool is_parquet, const ArrowFile::Options& options)
+                : is_parquet_{ is_parquet }
+                , options_{ options }
+            {
+            }
+
+            auto open(const std::string& filename) -> arrow::Status;
+            auto append(const StructData& data_struct) -> arrow::Status;
+            //! Write the pending frames and close the file. Returns the file size.
+            auto close() -> arrow::Result<int64_t>;
+
+            [[nodiscard]] auto get_filename() const -> const std::string& { return filename_; }
+            [[nodiscard]] auto get_n_frames() const -> std::size_t { return n_frames_; }
+            //! Bytes written to the file, excluding the pending frames
+            [[nodiscard]] auto get_file_size() const -> std::size_t { return file_size_; }
+
+          private:
+            bool is_parquet_ = true;
+            ArrowFile::Options options_;
+            std::string filename_;
+            std::size_t n_frames_ = 0;
+            std::size_t n_pending_frames_ = 0;
+            std::size_t file_size_ = 0;
+            std::shared_ptr<arrow::io::FileOutputStream> output_stream_;
+            std::unique_ptr<parquet::arrow::FileWriter> parquet_writer_;
+            std::shared_ptr<arrow::ipc::RecordBatchWriter> ipc_writer_;
+            std::unique_ptr<arrow::RecordBatchBuilder> batch_builder_;
+
+            // Builders owned by the batch builder
+            arrow::UInt32Builder* frame_counter_ = nullptr;
+            arrow::UInt8Builder* fec_id_ = nullptr;
+            arrow::UInt32Builder* udp_timestamp_ = nullptr;
+            arrow::UInt32Builder* overflow_ = nullptr;
+            arrow::ListBuilder* markers_ = nullptr;
+            arrow::StructBuilder* marker_struct_ = nullptr;
+            arrow::UInt8Builder* marker_vmm_id_ = nullptr;
+            arrow::UInt64Builder* marker_srs_timestamp_ = nullptr;
+            arrow::ListBuilder* hits_ = nullptr;
+            arrow::StructBuilder* hit_struct_ = nullptr;
+            arrow::BooleanBuilder* hit_is_over_threshold_ = nullptr;
+            arrow::UInt8Builder* hit_channel_num_ = nullptr;
+            arrow::UInt8Builder* hit_tdc_ = nullptr;
+            arrow::UInt8Builder* hit_offset_ = nullptr;
+            arrow::UInt8Builder* hit_vmm_id_ = nullptr;
+            arrow::UInt16Builder* hit_adc_ = nullptr;
+            arrow::UInt16Builder* hit_bc_id_ = nullptr;
+            arrow::ListBuilder* hit_time_ = nullptr;
+            arrow::ListBuilder* hit_plane_ = nullptr;
+            arrow::ListBuilder* hit_strip_ = nullptr;
+            arrow::ListBuilder* clusters_ = nullptr;
+            arrow::StructBuilder* cluster_struct_ = nullptr;
+            arrow::UInt64Builder* cluster_time_ = nullptr;
+            arrow::FloatBuilder* cluster_centroid_ = nullptr;
+            arrow::UInt32Builder* cluster_charge_ = nullptr;
+            arrow::UInt16Builder* cluster_size_ = nullptr;
+            arrow::UInt8Builder* cluster_plane_ = nullptr;
+
+            void set_builders();
+            auto append_markers(const std::vector<MarkerData>& markers) -> arrow::Status;
+            auto append_hits(const std::vector<HitData>& hits) -> arrow::Status;
+            auto append_clusters(const std::vector<ClusterData>& clusters) -> arrow::Status;
+            auto write_batch() -> arrow::Status;
+        };
+
+        auto ArrowLineWriter::open(const std::string& filename) -> arrow::Status
+        {
+            filename_ = filename;
+            const auto schema = make_schema();
+            ARROW_ASSIGN_OR_RAISE(batch_builder_,
+                                  arrow::RecordBatchBuilder::Make(
+                                      schema, arrow::default_memory_pool(), static_cast<int64_t>(options_.batch_size)));
+            set_builders();
+            ARROW_ASSIGN_OR_RAISE(output_stream_, arrow::io::FileOutputStream::Open(filename));
+            if (is_parquet_)
+            {
+                ARROW_ASSIGN_OR_RAISE(parquet_writer_,
+                                      parquet::arrow::FileWriter::Open(*schema,
+                                                                       arrow::default_memory_pool(),
+                                                                       output_stream_,
+                                                                       get_parquet_properties(options_),
+                                                                       parquet::default_arrow_writer_properties()));
+            }
+            else
+            {
+                auto ipc_options = arrow::ipc::IpcWriteOptions::Defaults();
+                const auto compression = get_arrow_compression(options_.compression, false);
+                if (compression != arrow::Compression::UNCOMPRESSED)
+                {
+                    ARROW_ASSIGN_OR_RAISE(
+                        ipc_options.codec,
+                        arrow::util::Codec::Create(compression,
+                                                   options_.compression_level == 0
+                                                       ? arrow::util::kUseDefaultCompressionLevel
+                                                       : options_.compression_level));
+                }
+                ARROW_ASSIGN_OR_RAISE(ipc_writer_, arrow::ipc::MakeFileWriter(output_stream_, schema, ipc_options));
+            }
+            return arrow::Status::OK();
+        }
+
+        void ArrowLineWriter::set_builders()
+        {
+            auto& batch_builder = *batch_builder_;
+            frame_counter_ = batch_builder.GetFieldAs<arrow::UInt32Builder>(Column::frame_counter);
+            fec_id_ = batch_builder.GetFieldAs<arrow::UInt8Builder>(Column::fec_id);
+            udp_timestamp_ = batch_builder.GetFieldAs<arrow::UInt32Builder>(Column::udp_timestamp);
+            overflow_ = batch_builder.GetFieldAs<arrow::UInt32Builder>(Column::overflow);
+
+            markers_ = batch_builder.GetFieldAs<arrow::ListBuilder>(Column::markers);
+            marker_struct_ = static_cast<arrow::StructBuilder*>(markers_->value_builder());
+            marker_vmm_id_ = get_child<arrow::UInt8Builder>(marker_struct_, 0);
+            marker_srs_timestamp_ = get_child<arrow::UInt64Builder>(marker_struct_, 1);
+
+            hits_ = batch_builder.GetFieldAs<arrow::ListBuilder>(Column::hits);
+            hit_struct_ = static_cast<arrow::StructBuilder*>(hits_->value_builder());
+            hit_is_over_threshold_ = get_child<arrow::BooleanBuilder>(hit_struct_, 0);
+            hit_channel_num_ = get_child<arrow::UInt8Builder>(hit_struct_, 1);
+            hit_tdc_ = get_child<arrow::UInt8Builder>(hit_struct_, 2);
+            hit_offset_ = get_child<arrow::UInt8Builder>(hit_struct_, 3);
+            hit_vmm_id_ = get_child<arrow::UInt8Builder>(hit_struct_, 4);
+            hit_adc_ = get_child<arrow::UInt16Builder>(hit_struct_, 5);
+            hit_bc_id_ = get_child<arrow::UInt16Builder>(hit_struct_, 6);
+
+            hit_time_ = batch_builder.GetFieldAs<arrow::ListBuilder>(Column::hit_time);
+            hit_plane_ = batch_builder.GetFieldAs<arrow::ListBuilder>(Column::hit_plane);
+            hit_strip_ = batch_builder.GetFieldAs<arrow::ListBuilder>(Column::hit_strip);
+
+            clusters_ = batch_builder.GetFieldAs<arrow::ListBuilder>(Column::clusters);
+            cluster_struct_ = static_cast<arrow::StructBuilder*>(clusters_->value_builder());
+            cluster_time_ = get_child<arrow::UInt64Builder>(cluster_struct_, 0);
+            cluster_centroid_ = get_child<arrow::FloatBuilder>(cluster_struct_, 1);
+            cluster_charge_ = get_child<arrow::UInt32Builder>(cluster_struct_, 2);
+            cluster_size_ = get_child<arrow::UInt16Builder>(cluster_struct_, 3);
+            cluster_plane_ = get_child<arrow::UInt8Builder>(cluster_struct_, 4);
+        }
+
+        auto ArrowLineWriter::append(const StructData& data_struct) -> arrow::Status
+        {
+            const auto& header = data_struct.header;
+            ARROW_RETURN_NOT_OK(frame_counter_->Append(header.frame_counter));
+            ARROW_RETURN_NOT_OK(fec_id_->Append(header.fec_id));
+            ARROW_RETURN_NOT_OK(udp_timestamp_->Append(header.udp_timestamp));
+            ARROW_RETURN_NOT_OK(overflow_->Append(header.overflow));
+            ARROW_RETURN_NOT_OK(append_markers(data_struct.marker_data));
+            ARROW_RETURN_NOT_OK(append_hits(data_struct.hit_data));
+            ARROW_RETURN_NOT_OK(append_list<arrow::UInt64Builder>(*hit_time_, data_struct.hit_time));
+            ARROW_RETURN_NOT_OK(append_list<arrow::UInt8Builder>(*hit_plane_, data_struct.hit_plane));
+            ARROW_RETURN_NOT_OK(append_list<arrow::UInt16Builder>(*hit_strip_, data_struct.hit_strip));
+            ARROW_RETURN_NOT_OK(append_clusters(data_struct.clusters));
+
+            ++n_frames_;
+            ++n_pending_frames_;
+            if (n_pending_frames_ >= options_.batch_size)
+            {
+                return write_batch();
+            }
+            return arrow::Status::OK();
+        }
+
+        auto ArrowLineWriter::append_markers(const std::vector<MarkerData>& markers) -> arrow::Status
+        {
+            const auto size = static_cast<int64_t>(markers.size());
+            ARROW_RETURN_NOT_OK(markers_->Append());
+            ARROW_RETURN_NOT_OK(marker_struct_->AppendValues(size, nullptr));
+            ARROW_RETURN_NOT_OK(reserve(size, { marker_vmm_id_, marker_srs_timestamp_ }));
+            for (const auto& marker : markers)
+            {
+                marker_vmm_id_->UnsafeAppend(marker.vmm_id);
+                marker_srs_timestamp_->UnsafeAppend(marker.srs_timestamp);
+            }
+            return arrow::Status::OK();
+        }
+
+        auto ArrowLineWriter::append_hits(const std::vector<HitData>& hits) -> arrow::Status
+        {
+            const auto size = static_cast<int64_t>(hits.size());
+            ARROW_RETURN_NOT_OK(hits_->Append());
+            ARROW_RETURN_NOT_OK(hit_struct_->AppendValues(size, nullptr));
+            ARROW_RETURN_NOT_OK(reserve(size,
+                                        { hit_is_over_threshold_,
+                                          hit_channel_num_,
+                                          hit_tdc_,
+                                          hit_offset_,
+                                          hit_vmm_id_,
+                                          hit_adc_,
+                                          hit_bc_id_ }));
+            for (const auto& hit : hits)
+            {
+                hit_is_over_threshold_->UnsafeAppend(hit.is_over_threshold);
+                hit_channel_num_->UnsafeAppend(hit.channel_num);
+                hit_tdc_->UnsafeAppend(hit.tdc);
+                hit_offset_->UnsafeAppend(hit.offset);
+                hit_vmm_id_->UnsafeAppend(hit.vmm_id);
+                hit_adc_->UnsafeAppend(hit.adc);
+                hit_bc_id_->UnsafeAppend(hit.bc_id);
+            }
+            return arrow::Status::OK();
+        }
+
+        auto ArrowLineWriter::append_clusters(const std::vector<ClusterData>& clusters) -> arrow::Status
+        {
+            const auto size = static_cast<int64_t>(clusters.size());
+            ARROW_RETURN_NOT_OK(clusters_->Append());
+            ARROW_RETURN_NOT_OK(cluster_struct_->AppendValues(size, nullptr));
+            ARROW_RETURN_NOT_OK(
+                reserve(size, { cluster_time_, cluster_centroid_, cluster_charge_, cluster_size_, cluster_plane_ }));
+            for (const auto& cluster : clusters)
+            {
+                cluster_time_->UnsafeAppend(cluster.time);
+                cluster_centroid_->UnsafeAppend(cluster.centroid);
+                cluster_charge_->UnsafeAppend(cluster.charge);
+                cluster_size_->UnsafeAppend(cluster.size);
+                cluster_plane_->UnsafeAppend(cluster.plane);
+            }
+            return arrow::Status::OK();
+        }
+
+        auto ArrowLineWriter::write_batch() -> arrow::Status
+        {
+            if (n_pending_frames_ == 0)
+            {
+                return arrow::Status::OK();
+            }
+            ARROW_ASSIGN_OR_RAISE(auto record_batch, batch_builder_->Flush());
+            if (is_parquet_)
+            {
+                ARROW_RETURN_NOT_OK(parquet_writer_->WriteRecordBatch(*record_batch));
+            }
+            else
+            {
+                ARROW_RETURN_NOT_OK(ipc_writer_->WriteRecordBatch(*record_batch));
+            }
+            n_pending_frames_ = 0;
+            ARROW_ASSIGN_OR_RAISE(auto position, output_stream_->Tell());
+            file_size_ = static_cast<std::size_t>(position);
+            return arrow::Status::OK();
+        }
+
+        auto ArrowLineWriter::close() -> arrow::Result<int64_t>
+        {
+            ARROW_RETURN_NOT_OK(write_batch());
+            if (is_parquet_)
+            {
+                ARROW_RETURN_NOT_OK(parquet_writer_->Close());
+            }
+            else
+            {
+                ARROW_RETURN_NOT_OK(ipc_writer_->Close());
+            }
+            ARROW_ASSIGN_OR_RAISE(auto file_size, output_stream_->Tell());
+            ARROW_RETURN_NOT_OK(output_stream_->Close());
+            return file_size;
+        }
+    } // namespace internal
+
+    namespace
+    {
+        auto close_line_writer(internal::ArrowLineWriter& line_writer) -> std::size_t
+        {
+            auto file_size = line_writer.close();
+            if (not file_size.ok())
+            {
+                spdlog::error("ArrowWriter: cannot close the file {:?}: {}",
+                              line_writer.get_filename(),
+                              file_size.status().ToString());
+                return line_writer.get_file_size();
+            }
+            spdlog::debug("ArrowWriter: file {:?} with {} frames is closed successfully",
+                          line_writer.get_filename(),
+                          line_writer.get_n_frames());
+            return static_cast<std::size_t>(file_size.ValueUnsafe());
+        }
+    } // namespace
+
+    ArrowFile::ArrowFile(const std::string& filename,
+                         process::DataConvertOptions convert_mode,
+                         std::size_t n_lines,
+                         const Options& options,
+                         const FileRotator::Options& rotation)
+        : SinkTask{ "ArrowWriter", convert_mode, n_lines }
+        , base_filename_{ filename }
+        , is_parquet_{ std::filesystem::path{ filename }.extension() != ".arrow" }
+        , options_{ options }
+        , rotator_{ std::make_unique<FileRotator>(filename, n_lines, rotation) }
+    {
+        assert(n_lines > 0);
+        options_.batch_size = std::max(options_.batch_size, std::size_t{ 1 });
+        options_.row_group_size = std::max(options_.row_group_size, options_.batch_size);
+        if (not is_parquet_ and options_.compression == common::CompressionType::gzip)
+        {
+            spdlog::warn("ArrowWriter: gzip is not supported by Arrow IPC files. {:?} is written without compression.",
+                         filename);
+            options_.compression = common::CompressionType::none;
+        }
+
+        line_writers_.resize(n_lines);
+        output_data_.resize(n_lines);
+        for (auto idx : std::views::iota(std::size_t{ 0 }, n_lines))
+        {
+            open_file(idx);
+        }
+    }
+
+    ArrowFile::~ArrowFile()
+    {
+        for (auto [idx, line_writer] : std::views::zip(std::views::iota(std::size_t{ 0 }), line_writers_))
+        {
+            rotator_->close(idx, [&line_writer]() { return close_line_writer(*line_writer); });
+        }
+        rotator_->wait();
+        if (auto* report = get_report(); report != nullptr and rotator_->is_reported())
+        {
+            report->register_file_rotation_result(base_filename_, rotator_->get_stats());
+        }
+        spdlog::info("Writer: Arrow file writer with the base name {:?} is closed successfully.", base_filename_);
+    }
+
+    void ArrowFile::open_file(std::size_t line_number)
+    {
+        const auto full_filename = rotator_->get_filename(line_number);
+        auto line_writer = std::make_unique<internal::ArrowLineWriter>(is_parquet_, options_);
+        check_status(line_writer->open(full_filename), full_filename);
+        line_writers_[line_number] = std::move(line_writer);
+        output_data_[line_number] = 0;
+    }
+
+    void ArrowFile::rotate(std::size_t line_number)
+    {
+        rotator_->rotate(line_number,
+                         [line_writer = std::move(line_writers_[line_number])]()
+                         { return close_line_writer(*line_writer); });
+        open_file(line_number);
+    }
+
+    void ArrowFile::write(const StructData& data_struct, std::size_t line_number)
+    {
+        auto& line_writer = *line_writers_[line_number];
+        check_status(line_writer.append(data_struct), line_writer.get_filename());
+        output_data_[line_number] = line_writer.get_n_frames();
+        if (rotator_->is_enabled() and rotator_->is_due(line_number, line_writer.get_file_size()))
+        {
+            rotate(line_number);
+        }
+    }
+} // namespace srs::sink
+#endif
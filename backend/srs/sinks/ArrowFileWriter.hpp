@@ -0,0 +1,100 @@
+#pragma once
+
+#ifdef HAS_ARROW
+#include "DataWriterOptions.hpp"
+#include "FileRotator.hpp"
+#include "srs/converters/DataConvertOptions.hpp"
+#include "srs/data/SRSDataStructs.hpp"
+#include "srs/utils/CommonConcepts.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
+#include "srs/workflow/BaseTask.hpp"
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace srs::sink
+{
+    namespace internal
+    {
+        class ArrowLineWriter;
+    } // namespace internal
+
+    /**
+     * @brief Columnar output of the struct data to Apache Parquet (".parquet") or Arrow IPC (".arrow") files
+     *
+     * Each frame is stored as one row, with the columns of the frame header and the list columns of the markers, the
+     * hits and the clusters. The hit time, plane and strip are stored in separate list columns, which are empty if not
+     * reconstructed. The events are not stored.
+     *
+     * The values are appended directly to the column builders and written as a record batch every
+     * Options::batch_size frames. Parquet files are written in row groups of Options::row_group_size frames with the
+     * dictionary encoding, except for the timestamps, which are delta encoded and bit-packed.
+     */
+    class ArrowFile : public process::SinkTask<DataWriterOption::arrow, const StructData*, std::size_t>
+    {
+      public:
+        static constexpr auto IsStructType = true;
+
+        struct Options
+        {
+            std::size_t batch_size = common::DEFAULT_ARROW_BATCH_SIZE;           //!< Frames per record batch
+            std::size_t row_group_size = common::DEFAULT_PARQUET_ROW_GROUP_SIZE; //!< Frames per Parquet row group
+            common::CompressionType compression = common::CompressionType::zstd; //!< of the column data
+            int compression_level = 0; //!< 0 means the default level of the algorithm.
+        };
+
+        /**
+         * @brief Constructor that opens the output file of each line.
+         *
+         * Throws if any file cannot be opened.
+         *
+         * @param filename Name of the output file. The format is determined by the extension.
+         * @param convert_mode Conversion of the input data
+         * @param n_lines Number of parallel pipelines
+         * @param options Batching and compression options
+         * @param rotation Rotation options
+         */
+        ArrowFile(const std::string& filename,
+                  process::DataConvertOptions convert_mode,
+                  std::size_t n_lines = 1,
+                  const Options& options = {},
+                  const FileRotator::Options& rotation = {});
+
+        ArrowFile(const ArrowFile&) = delete;
+        ArrowFile(ArrowFile&&) = delete;
+        ArrowFile& operator=(const ArrowFile&) = delete;
+        ArrowFile& operator=(ArrowFile&&) = delete;
+        ~ArrowFile();
+
+        //! Number of frames written to the current file of the line
+        [[nodiscard]] auto operator()(std::size_t line_number = 0) const -> OutputType
+        {
+            return output_data_[line_number];
+        }
+
+        auto run(const OutputTo<InputType> auto& prev_data_converter, std::size_t line_number = 0) -> RunResult
+        {
+            assert(line_number < get_n_lines());
+            const auto* data_struct = prev_data_converter(line_number);
+            assert(data_struct != nullptr);
+            write(*data_struct, line_number);
+            return this->operator()(line_number);
+        }
+
+      private:
+        std::string base_filename_;
+        bool is_parquet_ = true;
+        Options options_;
+        std::vector<std::unique_ptr<internal::ArrowLineWriter>> line_writers_;
+        std::vector<OutputType> output_data_;
+        std::unique_ptr<FileRotator> rotator_;
+
+        void open_file(std::size_t line_number);
+        void rotate(std::size_t line_number);
+        void write(const StructData& data_struct, std::size_t line_number);
+    };
+} // namespace srs::sink
+
+#endif
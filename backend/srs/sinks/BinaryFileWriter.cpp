@@ -1,53 +1,251 @@
 #include "BinaryFileWriter.hpp"
 #include "srs/converters/DataConvertOptions.hpp"
-#include "srs/utils/CommonFunctions.hpp"
+#include "srs/sinks/BlockCompressor.hpp"
+#include "srs/sinks/DirectFile.hpp"
+#include "srs/sinks/FileRotator.hpp"
+#include "srs/sinks/FrameIndexWriter.hpp"
+#include "srs/sinks/ScatterFile.hpp"
+#include "srs/sinks/StreamCompressor.hpp"
+#include "srs/utils/AppReport.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
 #include "srs/workflow/BaseTask.hpp"
+#include <algorithm>
+#include <array>
+#include <asio/thread_pool.hpp>
 #include <cassert>
 #include <cstddef>
+#include <expected>
 #include <fmt/format.h>
 #include <fmt/ranges.h>
+#include <fstream>
 #include <ios>
+#include <memory>
 #include <ranges>
 #include <spdlog/spdlog.h>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace srs::sink
 {
-    BinaryFile::BinaryFile(const std::string& filename, process::DataConvertOptions convert_mode, std::size_t n_lines)
+    BinaryFile::BinaryFile(const std::string& filename,
+                           process::DataConvertOptions convert_mode,
+                           std::size_t n_lines,
+                           const BinaryFileCompression& compression,
+                           const DirectFile::Options& direct_io,
+                           const FileRotator::Options& rotation,
+                           std::size_t index_interval)
         : SinkTask{ "BinaryWriter", convert_mode, n_lines }
         , file_name_{ filename }
+        , compression_{ compression }
+        , direct_io_{ direct_io }
+        , rotator_{ std::make_unique<FileRotator>(filename, n_lines, rotation) }
     {
         assert(n_lines > 0);
         output_data_.resize(n_lines);
-        output_streams_.reserve(n_lines);
-        for (auto idx : std::views::iota(0, static_cast<int>(n_lines)))
+        closed_file_bytes_.resize(n_lines);
+        direct_io_stats_.resize(n_lines);
+        output_files_.reserve(n_lines);
+        is_compressed_ = (convert_mode == process::DataConvertOptions::proto_frame or
+                          convert_mode == process::DataConvertOptions::packed_proto_frame) and
+                         compression.proto.type != common::CompressionType::none;
+        is_block_compressed_ =
+            convert_mode == process::DataConvertOptions::raw_frame and compression.raw.block_size > 0;
+        if (is_block_compressed_)
         {
-            auto full_filename = (n_lines == 1) ? filename : common::insert_index_to_filename(filename, idx);
-            auto& ofstream = output_streams_.emplace_back(full_filename, std::ios::trunc);
-            if (not ofstream.is_open())
+            block_compression_pool_ =
+                std::make_unique<asio::thread_pool>(std::max(compression.n_raw_threads, std::size_t{ 1 }));
+        }
+        is_direct_ = direct_io.buffer_size > 0 and not is_compressed_ and not is_block_compressed_;
+        // Uncompressed raw frames are written together with their size prefixes by scatter-gather system calls.
+        is_scattered_ =
+            convert_mode == process::DataConvertOptions::raw_frame and not is_block_compressed_ and not is_direct_;
+        // Offsets of frames in compressed outputs are meaningless.
+        index_interval_ = (is_compressed_ or is_block_compressed_) ? 0 : index_interval;
+        for (auto idx : std::views::iota(std::size_t{ 0 }, n_lines))
+        {
+            output_files_.push_back(open_file(idx));
+        }
+    }
+
+    auto BinaryFile::open_file(std::size_t line_number) -> OutputFile
+    {
+        auto full_filename = rotator_->get_filename(line_number);
+        auto output_file = OutputFile{};
+        if (index_interval_ > 0)
+        {
+            output_file.index_writer = std::make_unique<FrameIndexWriter>(full_filename, index_interval_);
+        }
+        if (is_direct_)
+        {
+            output_file.direct_file = std::make_unique<DirectFile>(full_filename, direct_io_);
+            return output_file;
+        }
+        if (is_scattered_)
+        {
+            output_file.scatter_file = std::make_unique<ScatterFile>(full_filename);
+            return output_file;
+        }
+        output_file.stream = std::make_unique<std::ofstream>(full_filename, std::ios::trunc | std::ios::binary);
+        if (not output_file.stream->is_open())
+        {
+            throw std::runtime_error(fmt::format("Filename {:?} cannot be open!", full_filename));
+        }
+        if (is_compressed_)
+        {
+            output_file.compressor = std::make_unique<StreamCompressor>(compression_.proto, *output_file.stream);
+        }
+        if (is_block_compressed_)
+        {
+            output_file.block_compressor =
+                std::make_unique<BlockCompressor>(compression_.raw, *block_compression_pool_, *output_file.stream);
+        }
+        return output_file;
+    }
+
+    void BinaryFile::rotate(std::size_t line_number)
+    {
+        auto& output_file = output_files_[line_number];
+        closed_file_bytes_[line_number] += output_file.get_size();
+        rotator_->rotate(line_number,
+                         [file = std::move(output_file), direct_io_stat = &direct_io_stats_[line_number]]() mutable
+                         { return file.close(*direct_io_stat); });
+        output_file = open_file(line_number);
+    }
+
+    auto BinaryFile::write(std::string_view size_prefix, std::string_view data, std::size_t line_number)
+        -> RunResult
+    {
+        auto& output_file = output_files_[line_number];
+        if (auto& block_compressor = output_file.block_compressor; block_compressor != nullptr)
+        {
+            block_compressor->write(size_prefix, data);
+        }
+        else if (auto& compressor = output_file.compressor; compressor != nullptr)
+        {
+            compressor->write(size_prefix);
+            compressor->write(data);
+        }
+        else if (auto& direct_file = output_file.direct_file; direct_file != nullptr)
+        {
+            const auto pieces = std::array{ size_prefix, data };
+            if (not direct_file->write(pieces))
+            {
+                return std::unexpected{ "Failed to write the data to the binary file" };
+            }
+            output_file.n_bytes += size_prefix.size() + data.size();
+        }
+        else if (auto& scatter_file = output_file.scatter_file; scatter_file != nullptr)
+        {
+            const auto pieces = std::array{ size_prefix, data };
+            if (not scatter_file->write(pieces))
             {
-                throw std::runtime_error(fmt::format("Filename {:?} cannot be open!", filename));
+                return std::unexpected{ "Failed to write the data to the binary file" };
             }
+            output_file.n_bytes += size_prefix.size() + data.size();
+        }
+        else
+        {
+            *output_file.stream << size_prefix << data;
+            output_file.n_bytes += size_prefix.size() + data.size();
         }
+
+        const auto file_size = output_file.get_size();
+        auto& output_size = output_data_[line_number];
+        output_size = closed_file_bytes_[line_number] + file_size;
+        if (rotator_->is_enabled() and rotator_->is_due(line_number, file_size))
+        {
+            rotate(line_number);
+        }
+        return output_size;
     }
 
     BinaryFile::~BinaryFile()
     {
+        if (rotator_ == nullptr)
+        {
+            return;
+        }
         close();
 
         if (auto* report = get_report(); report != nullptr)
         {
             report->register_output_sink_result(file_name_, output_data_);
+            if (is_direct_)
+            {
+                report->register_direct_io_result(file_name_, direct_io_stats_);
+            }
+            if (rotator_->is_reported())
+            {
+                report->register_file_rotation_result(file_name_, rotator_->get_stats());
+            }
         }
         spdlog::info("Writer: Binary file writer with the base name {:?} is closed successfully.", file_name_);
     }
 
     void BinaryFile::close()
     {
-        for (auto& file_stream : output_streams_)
+        if (is_closed_ or rotator_ == nullptr)
+        {
+            return;
+        }
+        is_closed_ = true;
+        for (auto [idx, output_file] : std::views::zip(std::views::iota(std::size_t{ 0 }), output_files_))
+        {
+            rotator_->close(idx,
+                            [&output_file, direct_io_stat = &direct_io_stats_[idx]]()
+                            { return output_file.close(*direct_io_stat); });
+        }
+        rotator_->wait();
+        for (auto [output_size, stat] : std::views::zip(output_data_, rotator_->get_stats()))
+        {
+            output_size = stat.n_bytes;
+        }
+    }
+
+    auto BinaryFile::OutputFile::get_size() const -> std::size_t
+    {
+        if (compressor != nullptr)
+        {
+            return compressor->get_output_bytes();
+        }
+        if (block_compressor != nullptr)
+        {
+            return block_compressor->get_output_bytes();
+        }
+        return n_bytes;
+    }
+
+    auto BinaryFile::OutputFile::close(AppReport::DirectIOStat& direct_io_stat) -> std::size_t
+    {
+        if (compressor != nullptr)
+        {
+            compressor->finish();
+        }
+        if (block_compressor != nullptr)
+        {
+            block_compressor->finish();
+        }
+        const auto file_size = get_size();
+        if (stream != nullptr)
+        {
+            stream->close();
+        }
+        if (direct_file != nullptr)
+        {
+            direct_file->close();
+            accumulate_direct_io_stat(direct_io_stat, direct_file->get_stat());
+        }
+        if (scatter_file != nullptr)
+        {
+            scatter_file->close();
+        }
+        if (index_writer != nullptr)
         {
-            file_stream.close();
+            index_writer->close();
         }
+        return file_size;
     }
 } // namespace srs::sink
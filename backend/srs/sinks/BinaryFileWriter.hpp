@@ -1,26 +1,62 @@
 #pragma once
 
 #include "srs/converters/DataConvertOptions.hpp"
+#include "srs/converters/FrameHeaderParser.hpp"
+#include "srs/sinks/BlockCompressor.hpp"
 #include "srs/sinks/DataWriterOptions.hpp"
+#include "srs/sinks/DirectFile.hpp"
+#include "srs/sinks/FileRotator.hpp"
+#include "srs/sinks/FrameIndexWriter.hpp"
+#include "srs/sinks/ScatterFile.hpp"
+#include "srs/sinks/StreamCompressor.hpp"
+#include "srs/utils/AppReport.hpp"
 #include "srs/utils/CommonConcepts.hpp"
 #include "srs/workflow/BaseTask.hpp"
+#include <asio/thread_pool.hpp>
 #include <cassert>
 #include <cstddef>
 #include <fmt/format.h>
 #include <fstream>
+#include <memory>
 #include <spdlog/spdlog.h>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 
 namespace srs::sink
 {
+    struct BinaryFileCompression
+    {
+        StreamCompressor::Options proto; //!< applied to Protobuf outputs
+        BlockCompressor::Options raw;    //!< applied to raw outputs if the block size is not 0
+        std::size_t n_raw_threads = 1;   //!< number of threads to compress the raw blocks
+    };
+
     class BinaryFile : public process::SinkTask<DataWriterOption::bin, std::string_view, std::size_t>
     {
       public:
         static constexpr auto IsStructType = false;
 
-        BinaryFile(const std::string& filename, process::DataConvertOptions convert_mode, std::size_t n_lines);
+        /**
+         * @brief Constructor
+         *
+         * @param filename Name of the output file. Line indices are inserted into the name if n_lines > 1.
+         * @param convert_mode Data conversion of the input data
+         * @param n_lines Number of parallel pipelines
+         * @param compression Compression of the output streams.
+         * @param direct_io Direct I/O of the uncompressed outputs, enabled if the buffer size is not 0.
+         * @param rotation Rotation of the output files
+         * @param index_interval Number of frames between two entries of the index files, disabled if it's 0. Only
+         * uncompressed outputs are indexed.
+         */
+        BinaryFile(const std::string& filename,
+                   process::DataConvertOptions convert_mode,
+                   std::size_t n_lines,
+                   const BinaryFileCompression& compression = {},
+                   const DirectFile::Options& direct_io = {},
+                   const FileRotator::Options& rotation = {},
+                   std::size_t index_interval = 0);
         BinaryFile(const BinaryFile&) = delete;
         BinaryFile(BinaryFile&&) noexcept = default;
         BinaryFile& operator=(const BinaryFile&) = delete;
@@ -30,10 +66,26 @@ namespace srs::sink
         auto run(const OutputTo<InputType> auto& prev_data_converter, std::size_t line_number = 0) -> RunResult
         {
             assert(line_number < get_n_lines());
-            auto input_data = prev_data_converter(line_number);
-            output_data_[line_number] += input_data.size();
-            output_streams_[line_number] << input_data;
-            return output_data_[line_number];
+            // The size prefix of a raw frame is provided separately such that the frame itself is never copied.
+            auto size_prefix = std::string_view{};
+            if constexpr (SizePrefixProvider<std::remove_cvref_t<decltype(prev_data_converter)>>)
+            {
+                size_prefix = prev_data_converter.get_size_prefix(line_number);
+            }
+            const auto data = prev_data_converter(line_number);
+            if (auto& index_writer = output_files_[line_number].index_writer; index_writer != nullptr)
+            {
+                // The frames are indexed separately for each FEC, which requires the headers of all frames.
+                if (const auto header = get_frame_header(prev_data_converter, data, line_number); header.has_value())
+                {
+                    index_writer->add(output_files_[line_number].n_bytes, header.value());
+                }
+                else
+                {
+                    index_writer->count_frame();
+                }
+            }
+            return write(size_prefix, data, line_number);
         }
         void close();
 
@@ -44,9 +96,57 @@ namespace srs::sink
         }
 
       private:
+        // Writers of the current file of a pipeline. Only one of them receives the data.
+        struct OutputFile
+        {
+            std::unique_ptr<std::ofstream> stream;
+            std::unique_ptr<StreamCompressor> compressor;
+            std::unique_ptr<BlockCompressor> block_compressor;
+            std::unique_ptr<ScatterFile> scatter_file;
+            std::unique_ptr<DirectFile> direct_file;
+            std::unique_ptr<FrameIndexWriter> index_writer;
+            std::size_t n_bytes = 0; //!< Bytes written to the uncompressed file
+
+            [[nodiscard]] auto get_size() const -> std::size_t;
+            //! Close all writers and return the final size of the file.
+            auto close(AppReport::DirectIOStat& direct_io_stat) -> std::size_t;
+        };
+
         std::string file_name_;
+        BinaryFileCompression compression_;
+        DirectFile::Options direct_io_;
+        bool is_compressed_ = false;
+        bool is_block_compressed_ = false;
+        bool is_direct_ = false;
+        bool is_scattered_ = false;
+        bool is_closed_ = false;
+        std::size_t index_interval_ = 0;
         std::vector<OutputType> output_data_;
-        std::vector<std::ofstream> output_streams_;
+        std::vector<std::size_t> closed_file_bytes_;
+        std::vector<OutputFile> output_files_;
+        // Only modified by the closing thread of the rotator
+        std::vector<AppReport::DirectIOStat> direct_io_stats_;
+        std::unique_ptr<asio::thread_pool> block_compression_pool_;
+        std::unique_ptr<FileRotator> rotator_;
+
+        // Raw frames are parsed for their headers, while the Protobuf frames get them from the serializer.
+        static auto get_frame_header(const auto& prev_data_converter,
+                                     std::string_view data,
+                                     std::size_t line_number) -> process::FrameHeaderResult
+        {
+            if constexpr (FrameHeaderProvider<std::remove_cvref_t<decltype(prev_data_converter)>>)
+            {
+                return prev_data_converter.get_frame_header(line_number);
+            }
+            else
+            {
+                return process::parse_frame_header(data);
+            }
+        }
+
+        auto open_file(std::size_t line_number) -> OutputFile;
+        void rotate(std::size_t line_number);
+        auto write(std::string_view size_prefix, std::string_view data, std::size_t line_number) -> RunResult;
     };
 
 } // namespace srs::sink
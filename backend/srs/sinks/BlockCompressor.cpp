@@ -0,0 +1,139 @@
+#include "BlockCompressor.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
+#include <asio/post.hpp>
+#include <asio/thread_pool.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <ostream>
+#include <spdlog/spdlog.h>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <zpp_bits.h>
+#include <zstd.h>
+
+namespace srs::sink
+{
+    BlockCompressor::BlockCompressor(const Options& options, asio::thread_pool& thread_pool, std::ostream& output)
+        : options_{ options }
+        , thread_pool_{ &thread_pool }
+        , output_{ &output }
+    {
+        current_block_.data.reserve(options_.block_size);
+    }
+
+    BlockCompressor::~BlockCompressor() { finish(); }
+
+    void BlockCompressor::write(std::string_view size_prefix, std::string_view frame)
+    {
+        if (is_finished_)
+        {
+            return;
+        }
+        current_block_.data.insert(current_block_.data.end(), size_prefix.begin(), size_prefix.end());
+        current_block_.data.insert(current_block_.data.end(), frame.begin(), frame.end());
+        ++current_block_.n_frames;
+        ++n_frames_;
+        if (current_block_.data.size() >= options_.block_size)
+        {
+            submit_block();
+        }
+        write_blocks(false);
+    }
+
+    void BlockCompressor::finish()
+    {
+        if (is_finished_)
+        {
+            return;
+        }
+        if (current_block_.n_frames > 0)
+        {
+            submit_block();
+        }
+        write_blocks(true);
+        output_->flush();
+        is_finished_ = true;
+    }
+
+    void BlockCompressor::submit_block()
+    {
+        auto block = std::exchange(current_block_, Block{ .first_frame_index = n_frames_ });
+        current_block_.data.reserve(options_.block_size);
+
+        auto task = std::packaged_task<Block()>{ [block = std::move(block), level = options_.level]() mutable
+                                                 { return compress(std::move(block), level); } };
+        pending_blocks_.push_back(task.get_future());
+        asio::post(*thread_pool_, std::move(task));
+
+        if (pending_blocks_.size() > options_.max_pending_blocks)
+        {
+            spdlog::trace("Block compressor: waiting for {} pending blocks", pending_blocks_.size());
+            write_block(pending_blocks_.front().get());
+            pending_blocks_.pop_front();
+        }
+    }
+
+    void BlockCompressor::write_blocks(bool is_blocking)
+    {
+        while (not pending_blocks_.empty())
+        {
+            auto& block = pending_blocks_.front();
+            if (not is_blocking and block.wait_for(std::chrono::seconds{ 0 }) != std::future_status::ready)
+            {
+                return;
+            }
+            write_block(block.get());
+            pending_blocks_.pop_front();
+        }
+    }
+
+    void BlockCompressor::write_block(const Block& block)
+    {
+        if (block.data.empty())
+        {
+            return;
+        }
+        auto header = std::vector<char>{};
+        header.reserve(sizeof(uint32_t) * 2 + common::RAW_BLOCK_METADATA_SIZE);
+        auto serialize_to = zpp::bits::out{ header, zpp::bits::append{}, zpp::bits::endian::little{} };
+        serialize_to(common::RAW_BLOCK_SKIPPABLE_MAGIC,
+                     common::RAW_BLOCK_METADATA_SIZE,
+                     block.first_frame_index,
+                     block.n_frames,
+                     static_cast<uint32_t>(block.data.size()))
+            .or_throw();
+        output_->write(header.data(), static_cast<std::streamsize>(header.size()));
+        output_->write(block.data.data(), static_cast<std::streamsize>(block.data.size()));
+        output_bytes_ += header.size() + block.data.size();
+    }
+
+    // Executed in the worker threads. Each thread keeps its own compression context.
+    auto BlockCompressor::compress(Block block, int level) -> Block
+    {
+        struct ContextDeleter
+        {
+            void operator()(ZSTD_CCtx* context) const { ZSTD_freeCCtx(context); }
+        };
+        thread_local auto context = std::unique_ptr<ZSTD_CCtx, ContextDeleter>{ ZSTD_createCCtx() };
+
+        auto output = std::vector<char>(ZSTD_compressBound(block.data.size()));
+        const auto size =
+            ZSTD_compressCCtx(context.get(), output.data(), output.size(), block.data.data(), block.data.size(), level);
+        if (ZSTD_isError(size) != 0U)
+        {
+            spdlog::error("Block compressor: failed to compress {} frames starting from frame {}: {}",
+                          block.n_frames,
+                          block.first_frame_index,
+                          ZSTD_getErrorName(size));
+            block.data.clear();
+            return block;
+        }
+        output.resize(size);
+        block.data = std::move(output);
+        return block;
+    }
+} // namespace srs::sink
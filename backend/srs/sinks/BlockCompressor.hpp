@@ -0,0 +1,76 @@
+#pragma once
+
+#include <asio/thread_pool.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+namespace srs::sink
+{
+    /**
+     * @brief Compressor of delimited raw frames in independent zstd blocks
+     *
+     * Frames are collected into a block until its size reaches the block size. Full blocks are compressed on a worker
+     * pool and written to the output in the original order. Each block is preceded by a zstd skippable frame holding
+     * the index of its first frame, the number of frames and the size of the compressed block. A frame never spans
+     * two blocks.
+     *
+     * The number of blocks waiting for the compression is limited. If the limit is reached, the writing is blocked
+     * until the oldest block is compressed.
+     */
+    class BlockCompressor
+    {
+      public:
+        struct Options
+        {
+            std::size_t block_size = 0; //!< uncompressed size of a block in bytes
+            int level = 0;              //!< 0 for the default level of zstd
+            std::size_t max_pending_blocks = 1;
+        };
+
+        BlockCompressor(const Options& options, asio::thread_pool& thread_pool, std::ostream& output);
+        BlockCompressor(const BlockCompressor&) = delete;
+        BlockCompressor(BlockCompressor&&) = delete;
+        BlockCompressor& operator=(const BlockCompressor&) = delete;
+        BlockCompressor& operator=(BlockCompressor&&) = delete;
+        ~BlockCompressor();
+
+        //! Append one delimited frame to the current block
+        void write(std::string_view frame) { write({}, frame); }
+
+        //! Append one frame with its size prefix to the current block
+        void write(std::string_view size_prefix, std::string_view frame);
+
+        //! Compress the last block and wait for all blocks to be written. No data can be written afterwards.
+        void finish();
+
+        //! Total number of bytes written to the output stream
+        [[nodiscard]] auto get_output_bytes() const -> std::size_t { return output_bytes_; }
+
+      private:
+        struct Block
+        {
+            uint64_t first_frame_index = 0;
+            uint32_t n_frames = 0;
+            std::vector<char> data;
+        };
+
+        Options options_;
+        asio::thread_pool* thread_pool_ = nullptr;
+        std::ostream* output_ = nullptr;
+        bool is_finished_ = false;
+        std::size_t output_bytes_ = 0;
+        uint64_t n_frames_ = 0;
+        Block current_block_;
+        std::deque<std::future<Block>> pending_blocks_;
+
+        void submit_block();
+        void write_blocks(bool is_blocking);
+        void write_block(const Block& block);
+        static auto compress(Block block, int level) -> Block;
+    };
+} // namespace srs::sink
@@ -0,0 +1,193 @@
+#include "CompactFileWriter.hpp"
+#include "FileRotator.hpp"
+#include "srs/converters/DataConvertOptions.hpp"
+#include "srs/data/SRSDataStructs.hpp"
+#include "srs/readers/CompactCodec.hpp"
+#include "srs/readers/CompactFileReader.hpp"
+#include "srs/workflow/BaseTask.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <fmt/format.h>
+#include <fstream>
+#include <ios>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <zpp_bits.h>
+
+namespace srs::sink
+{
+    namespace internal
+    {
+        // Encoder and the output stream of the current file of one line
+        class CompactLineWriter
+        {
+          public:
+            explicit CompactLineWriter(std::size_t block_frames)
+                : block_frames_{ block_frames }
+            {
+            }
+
+            void open(const std::string& filename)
+            {
+                filename_ = filename;
+                output_file_.open(filename, std::ios::trunc | std::ios::binary);
+                if (not output_file_.is_open())
+                {
+                    throw std::runtime_error(fmt::format("Filename {:?} cannot be open!", filename));
+                }
+                output_file_.write(reader::CompactFile::MAGIC.data(),
+                                   static_cast<std::streamsize>(reader::CompactFile::MAGIC.size()));
+                file_size_ = reader::CompactFile::MAGIC.size();
+            }
+
+            void append(const StructData& data_struct)
+            {
+                encoder_.clear();
+                encoder_.encode(data_struct);
+                ++n_frames_;
+                if (encoder_.get_n_frames() >= block_frames_)
+                {
+                    write_block();
+                }
+            }
+
+            //! Write the pending frames and the block index, and close the file. Returns the file size.
+            auto close() -> std::size_t
+            {
+                write_block();
+                const auto index_offset = file_size_;
+                auto entry = std::array<char, reader::CompactFile::INDEX_ENTRY_SIZE>{};
+                for (const auto& block : blocks_)
+                {
+                    auto serialize_to = zpp::bits::out{ entry };
+                    serialize_to(block.offset, block.first_frame, block.n_frames).or_throw();
+                    output_file_.write(entry.data(), static_cast<std::streamsize>(entry.size()));
+                    file_size_ += entry.size();
+                }
+                auto footer = std::array<char, reader::CompactFile::FOOTER_SIZE>{};
+                auto serialize_to = zpp::bits::out{ footer };
+                serialize_to(index_offset, reader::CompactFile::INDEX_MAGIC).or_throw();
+                output_file_.write(footer.data(), static_cast<std::streamsize>(footer.size()));
+                file_size_ += footer.size();
+                output_file_.close();
+                return file_size_;
+            }
+
+            [[nodiscard]] auto get_filename() const -> const std::string& { return filename_; }
+            [[nodiscard]] auto get_n_frames() const -> std::size_t { return n_frames_; }
+            //! Bytes written to the file, excluding the pending frames
+            [[nodiscard]] auto get_file_size() const -> std::size_t { return file_size_; }
+
+          private:
+            std::size_t block_frames_ = 0;
+            std::string filename_;
+            std::ofstream output_file_;
+            reader::internal::CompactFrameEncoder encoder_;
+            std::vector<reader::CompactBlockEntry> blocks_;
+            std::size_t n_frames_ = 0;
+            std::size_t file_size_ = 0;
+
+            void write_block()
+            {
+                const auto n_block_frames = encoder_.get_n_frames();
+                if (n_block_frames == 0)
+                {
+                    return;
+                }
+                const auto payload = encoder_.finish_block();
+                blocks_.push_back(reader::CompactBlockEntry{ .offset = file_size_,
+                                                             .first_frame = n_frames_ - n_block_frames,
+                                                             .n_frames = n_block_frames });
+
+                auto block_header = std::array<char, reader::CompactFile::BLOCK_HEADER_SIZE>{};
+                auto serialize_to = zpp::bits::out{ block_header };
+                serialize_to(static_cast<uint32_t>(payload.size_bytes()), n_block_frames).or_throw();
+                output_file_.write(block_header.data(), static_cast<std::streamsize>(block_header.size()));
+                output_file_.write(reinterpret_cast<const char*>(payload.data()),
+                                   static_cast<std::streamsize>(payload.size_bytes()));
+                file_size_ += block_header.size() + payload.size_bytes();
+            }
+        };
+    } // namespace internal
+
+    namespace
+    {
+        auto close_line_writer(internal::CompactLineWriter& line_writer) -> std::size_t
+        {
+            const auto file_size = line_writer.close();
+            spdlog::debug("CompactWriter: file {:?} with {} frames is closed successfully",
+                          line_writer.get_filename(),
+                          line_writer.get_n_frames());
+            return file_size;
+        }
+    } // namespace
+
+    CompactFile::CompactFile(const std::string& filename,
+                             process::DataConvertOptions convert_mode,
+                             std::size_t n_lines,
+                             std::size_t block_frames,
+                             const FileRotator::Options& rotation)
+        : SinkTask{ "CompactWriter", convert_mode, n_lines }
+        , base_filename_{ filename }
+        , block_frames_{ std::max(block_frames, std::size_t{ 1 }) }
+        , rotator_{ std::make_unique<FileRotator>(filename, n_lines, rotation) }
+    {
+        assert(n_lines > 0);
+        line_writers_.resize(n_lines);
+        output_data_.resize(n_lines);
+        for (auto idx : std::views::iota(std::size_t{ 0 }, n_lines))
+        {
+            open_file(idx);
+        }
+    }
+
+    CompactFile::~CompactFile()
+    {
+        for (auto [idx, line_writer] : std::views::zip(std::views::iota(std::size_t{ 0 }), line_writers_))
+        {
+            rotator_->close(idx, [&line_writer]() { return close_line_writer(*line_writer); });
+        }
+        rotator_->wait();
+        if (auto* report = get_report(); report != nullptr and rotator_->is_reported())
+        {
+            report->register_file_rotation_result(base_filename_, rotator_->get_stats());
+        }
+        spdlog::info("Writer: Compact file writer with the base name {:?} is closed successfully.", base_filename_);
+    }
+
+    void CompactFile::open_file(std::size_t line_number)
+    {
+        auto line_writer = std::make_unique<internal::CompactLineWriter>(block_frames_);
+        line_writer->open(rotator_->get_filename(line_number));
+        line_writers_[line_number] = std::move(line_writer);
+        output_data_[line_number] = 0;
+    }
+
+    void CompactFile::rotate(std::size_t line_number)
+    {
+        rotator_->rotate(line_number,
+                         [line_writer = std::move(line_writers_[line_number])]()
+                         { return close_line_writer(*line_writer); });
+        open_file(line_number);
+    }
+
+    void CompactFile::write(const StructData& data_struct, std::size_t line_number)
+    {
+        auto& line_writer = *line_writers_[line_number];
+        line_writer.append(data_struct);
+        output_data_[line_number] = line_writer.get_n_frames();
+        if (rotator_->is_enabled() and rotator_->is_due(line_number, line_writer.get_file_size()))
+        {
+            rotate(line_number);
+        }
+    }
+} // namespace srs::sink
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "DataWriterOptions.hpp"
+#include "FileRotator.hpp"
+#include "srs/converters/DataConvertOptions.hpp"
+#include "srs/data/SRSDataStructs.hpp"
+#include "srs/utils/CommonConcepts.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
+#include "srs/workflow/BaseTask.hpp"
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace srs::sink
+{
+    namespace internal
+    {
+        class CompactLineWriter;
+    } // namespace internal
+
+    /**
+     * @brief Output of the struct data to the compact file format (".srsc")
+     *
+     * The values of each frame are bit-packed with their true bit widths and the frame counters and timestamps are
+     * delta encoded. Frames are written in blocks of CompactFile::block_frames frames, which can be decoded
+     * independently. The block index is written at the end of each file. The hit time, plane and strip, the clusters
+     * and the events are not stored. See srs::reader::CompactFile for the file layout.
+     */
+    class CompactFile : public process::SinkTask<DataWriterOption::compact, const StructData*, std::size_t>
+    {
+      public:
+        static constexpr auto IsStructType = true;
+
+        /**
+         * @brief Constructor that opens the output file of each line.
+         *
+         * Throws if any file cannot be opened.
+         *
+         * @param filename Name of the output file
+         * @param convert_mode Conversion of the input data
+         * @param n_lines Number of parallel pipelines
+         * @param block_frames Number of frames in each block
+         * @param rotation Rotation options
+         */
+        CompactFile(const std::string& filename,
+                    process::DataConvertOptions convert_mode,
+                    std::size_t n_lines = 1,
+                    std::size_t block_frames = common::DEFAULT_COMPACT_BLOCK_FRAMES,
+                    const FileRotator::Options& rotation = {});
+
+        CompactFile(const CompactFile&) = delete;
+        CompactFile(CompactFile&&) = delete;
+        CompactFile& operator=(const CompactFile&) = delete;
+        CompactFile& operator=(CompactFile&&) = delete;
+        ~CompactFile();
+
+        //! Number of frames written to the current file of the line
+        [[nodiscard]] auto operator()(std::size_t line_number = 0) const -> OutputType
+        {
+            return output_data_[line_number];
+        }
+
+        auto run(const OutputTo<InputType> auto& prev_data_converter, std::size_t line_number = 0) -> RunResult
+        {
+            assert(line_number < get_n_lines());
+            const auto* data_struct = prev_data_converter(line_number);
+            assert(data_struct != nullptr);
+            write(*data_struct, line_number);
+            return this->operator()(line_number);
+        }
+
+      private:
+        std::string base_filename_;
+        std::size_t block_frames_ = common::DEFAULT_COMPACT_BLOCK_FRAMES;
+        std::vector<std::unique_ptr<internal::CompactLineWriter>> line_writers_;
+        std::vector<OutputType> output_data_;
+        std::unique_ptr<FileRotator> rotator_;
+
+        void open_file(std::size_t line_number);
+        void rotate(std::size_t line_number);
+        void write(const StructData& data_struct, std::size_t line_number);
+    };
+} // namespace srs::sink
@@ -16,7 +16,9 @@ namespace srs
         root = 0x01,
         json = 0x02,
         bin = 0x04,
+        arrow = 0x08,
         udp = 0x10,
+        compact = 0x20,
     };
 
     inline auto get_filetype_from_filename(std::string_view filename)
@@ -32,6 +34,14 @@ namespace srs
             {
                 return { udp, raw };
             }
+            if (auto pos = filename.find('#'); pos != std::string::npos)
+            {
+                return { udp, packed_proto };
+            }
+            if (auto pos = filename.find('!'); pos != std::string::npos)
+            {
+                return { udp, flat };
+            }
             return { udp, proto };
         }
 
@@ -44,14 +54,26 @@ namespace srs
         {
             return { bin, proto_frame };
         }
+        if (file_ext == ".pbc")
+        {
+            return { bin, packed_proto_frame };
+        }
         if (file_ext == ".root")
         {
             return { root, structure };
         }
-        if (file_ext == ".json")
+        if (file_ext == ".json" or file_ext == ".jsonl" or file_ext == ".ndjson")
         {
             return { json, structure };
         }
+        if (file_ext == ".parquet" or file_ext == ".arrow")
+        {
+            return { arrow, structure };
+        }
+        if (file_ext == ".srsc")
+        {
+            return { compact, structure };
+        }
 
         return { no_output, none };
     }
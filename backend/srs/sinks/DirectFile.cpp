@@ -0,0 +1,252 @@
+#include "DirectFile.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <fcntl.h>
+#include <fmt/format.h>
+#include <mutex>
+#include <new>
+#include <ranges>
+#include <span>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+
+namespace srs::sink
+{
+    namespace
+    {
+        auto get_error_message() -> std::string { return std::error_code{ errno, std::system_category() }.message(); }
+    } // namespace
+
+    DirectFile::DirectFile(const std::string& filename, const Options& options)
+        : filename_{ filename }
+        , options_{ options }
+    {
+        const auto n_aligned_blocks = (options_.buffer_size + ALIGNMENT - 1) / ALIGNMENT;
+        options_.buffer_size = std::max(n_aligned_blocks, std::size_t{ 1 }) * ALIGNMENT;
+        options_.n_buffers = std::max(options_.n_buffers, std::size_t{ 2 });
+
+        file_descriptor_ = open_file(O_DIRECT);
+        is_direct_ = file_descriptor_ >= 0;
+        if (not is_direct_)
+        {
+            spdlog::warn("Direct I/O is not supported for the file {:?}: {}. Buffered I/O is used instead.",
+                         filename_,
+                         get_error_message());
+            file_descriptor_ = open_file(0);
+        }
+        if (file_descriptor_ < 0)
+        {
+            throw std::runtime_error(fmt::format("Filename {:?} cannot be open: {}", filename_, get_error_message()));
+        }
+
+        auto allocate_buffer = [this]() -> Buffer
+        {
+            // NOLINTNEXTLINE (cppcoreguidelines-no-malloc)
+            auto buffer = Buffer{ static_cast<char*>(std::aligned_alloc(ALIGNMENT, options_.buffer_size)) };
+            if (buffer == nullptr)
+            {
+                throw std::bad_alloc{};
+            }
+            return buffer;
+        };
+        current_buffer_ = allocate_buffer();
+        for ([[maybe_unused]] auto _ : std::views::iota(std::size_t{ 1 }, options_.n_buffers))
+        {
+            free_buffers_.push_back(allocate_buffer());
+        }
+        write_thread_ = std::jthread{ [this]() { write_buffers(); } };
+    }
+
+    DirectFile::~DirectFile() { close(); }
+
+    auto DirectFile::open_file(int flags) -> int
+    {
+        static constexpr auto FILE_PERMISSION = 0644;
+        // NOLINTNEXTLINE (cppcoreguidelines-pro-type-vararg)
+        return ::open(filename_.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC | flags, FILE_PERMISSION);
+    }
+
+    auto DirectFile::write(std::span<const std::string_view> pieces) -> bool
+    {
+        if (is_closed_ or current_buffer_ == nullptr)
+        {
+            return false;
+        }
+        for (auto piece : pieces)
+        {
+            while (not piece.empty())
+            {
+                const auto copy_size = std::min(piece.size(), options_.buffer_size - current_size_);
+                std::ranges::copy(piece.substr(0, copy_size), current_buffer_.get() + current_size_);
+                current_size_ += copy_size;
+                piece.remove_prefix(copy_size);
+                if (current_size_ == options_.buffer_size and not submit_buffer())
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    auto DirectFile::submit_buffer() -> bool
+    {
+        auto lock = std::unique_lock{ mutex_ };
+        full_buffers_.push_back(FullBuffer{ .buffer = std::move(current_buffer_), .size = current_size_ });
+        current_size_ = 0;
+        stat_.total_queue_depth += full_buffers_.size();
+        stat_.max_queue_depth = std::max(stat_.max_queue_depth, full_buffers_.size());
+        if (free_buffers_.empty())
+        {
+            ++stat_.n_stalls;
+        }
+        buffer_ready_.notify_all();
+        buffer_ready_.wait(lock, [this]() { return not free_buffers_.empty() or is_failed_; });
+        if (is_failed_)
+        {
+            return false;
+        }
+        current_buffer_ = std::move(free_buffers_.back());
+        free_buffers_.pop_back();
+        return true;
+    }
+
+    // Executed in the background thread
+    void DirectFile::write_buffers()
+    {
+        while (true)
+        {
+            auto full_buffer = FullBuffer{};
+            {
+                auto lock = std::unique_lock{ mutex_ };
+                buffer_ready_.wait(lock, [this]() { return not full_buffers_.empty() or is_stopped_; });
+                if (full_buffers_.empty())
+                {
+                    return;
+                }
+                full_buffer = std::move(full_buffers_.front());
+                full_buffers_.pop_front();
+            }
+
+            const auto start_time = std::chrono::steady_clock::now();
+            const auto is_written = write_to_file(std::string_view{ full_buffer.buffer.get(), full_buffer.size });
+            const auto write_time = std::chrono::steady_clock::now() - start_time;
+            {
+                auto lock = std::lock_guard{ mutex_ };
+                stat_.n_bytes += full_buffer.size;
+                ++stat_.n_buffers;
+                stat_.total_write_time_ms += std::chrono::duration<double, std::milli>(write_time).count();
+                is_failed_ = is_failed_ or not is_written;
+                free_buffers_.push_back(std::move(full_buffer.buffer));
+            }
+            buffer_ready_.notify_all();
+        }
+    }
+
+    auto DirectFile::write_to_file(std::string_view data) -> bool
+    {
+        preallocate(file_offset_ + data.size());
+        while (not data.empty())
+        {
+            const auto written_size =
+                ::pwrite(file_descriptor_, data.data(), data.size(), static_cast<off_t>(file_offset_));
+            if (written_size < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                spdlog::error("Failed to write to the file {:?}: {}", filename_, get_error_message());
+                return false;
+            }
+            data.remove_prefix(static_cast<std::size_t>(written_size));
+            file_offset_ += static_cast<std::size_t>(written_size);
+        }
+        return true;
+    }
+
+    void DirectFile::preallocate(std::size_t end_offset)
+    {
+        if (options_.preallocation_size == 0 or end_offset <= preallocated_size_)
+        {
+            return;
+        }
+        const auto size = std::max(options_.preallocation_size, end_offset - preallocated_size_);
+        // The file size is kept such that it always equals the size of the written data.
+        if (::fallocate(file_descriptor_,
+                        FALLOC_FL_KEEP_SIZE,
+                        static_cast<off_t>(preallocated_size_),
+                        static_cast<off_t>(size)) != 0)
+        {
+            spdlog::debug("Preallocation of the file {:?} is disabled: {}", filename_, get_error_message());
+            options_.preallocation_size = 0;
+            return;
+        }
+        preallocated_size_ += size;
+    }
+
+    void DirectFile::release_preallocation()
+    {
+        if (preallocated_size_ <= file_offset_)
+        {
+            return;
+        }
+        // Blocks reserved past the end of the data would stay allocated after the file is closed. They are released
+        // by truncating the file to its current size.
+        if (::ftruncate(file_descriptor_, static_cast<off_t>(file_offset_)) != 0)
+        {
+            spdlog::warn(
+                "Failed to release the preallocated space of the file {:?}: {}", filename_, get_error_message());
+        }
+        preallocated_size_ = file_offset_;
+    }
+
+    void DirectFile::close()
+    {
+        if (is_closed_)
+        {
+            return;
+        }
+        is_closed_ = true;
+        {
+            auto lock = std::lock_guard{ mutex_ };
+            is_stopped_ = true;
+        }
+        buffer_ready_.notify_all();
+        if (write_thread_.joinable())
+        {
+            write_thread_.join();
+        }
+
+        // The size of the last buffer isn't aligned, which isn't allowed with direct I/O.
+        if (current_buffer_ != nullptr and current_size_ > 0 and not is_failed_)
+        {
+            if (is_direct_)
+            {
+                // NOLINTNEXTLINE (cppcoreguidelines-pro-type-vararg)
+                ::fcntl(file_descriptor_, F_SETFL, ::fcntl(file_descriptor_, F_GETFL) & ~O_DIRECT);
+            }
+            if (write_to_file(std::string_view{ current_buffer_.get(), current_size_ }))
+            {
+                stat_.n_bytes += current_size_;
+                ++stat_.n_buffers;
+            }
+            current_size_ = 0;
+        }
+        release_preallocation();
+        if (::close(file_descriptor_) != 0)
+        {
+            spdlog::error("Failed to close the file {:?}: {}", filename_, get_error_message());
+        }
+        file_descriptor_ = -1;
+    }
+} // namespace srs::sink
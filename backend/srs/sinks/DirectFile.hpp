@@ -0,0 +1,120 @@
+#pragma once
+
+#include "srs/utils/AppReport.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace srs::sink
+{
+    /**
+     * @brief Output file written from large aligned buffers by a background thread with direct I/O
+     *
+     * Data is appended to the current buffer. Once the buffer is full, it's handed to the background thread, which
+     * writes it to the file opened with O_DIRECT, bypassing the page cache, while the next buffer is being filled. If
+     * all buffers are waiting to be written, the writing is blocked until the oldest buffer is written (a stall).
+     *
+     * The disk space of the file is preallocated in chunks ahead of the writing. The last partial buffer is written
+     * without direct I/O when the file is closed, such that the file size is exactly the size of the data, and the
+     * space preallocated past the end of the data is released.
+     *
+     * If the file system doesn't support O_DIRECT, the file is opened without it and only the buffering remains.
+     */
+    class DirectFile
+    {
+      public:
+        static constexpr auto ALIGNMENT = std::size_t{ 4096 };
+
+        struct Options
+        {
+            std::size_t buffer_size = 0; //!< size of each buffer in bytes, rounded up to ALIGNMENT. 0 disables it.
+            std::size_t n_buffers = 2;   //!< at least 2
+            std::size_t preallocation_size = 0; //!< disk space allocated in advance in bytes. 0 disables it.
+        };
+
+        //! Create or truncate the file and start the background thread. Throws if the file cannot be opened.
+        DirectFile(const std::string& filename, const Options& options);
+
+        DirectFile(const DirectFile&) = delete;
+        DirectFile(DirectFile&&) = delete;
+        DirectFile& operator=(const DirectFile&) = delete;
+        DirectFile& operator=(DirectFile&&) = delete;
+        ~DirectFile();
+
+        /**
+         * @brief Append the pieces to the file in the given order.
+         *
+         * @return false if the background thread has failed to write to the file.
+         */
+        auto write(std::span<const std::string_view> pieces) -> bool;
+
+        //! Write all remaining data and close the file. No data can be written afterwards.
+        void close();
+
+        //! Only valid after the file is closed.
+        [[nodiscard]] auto get_stat() const -> const AppReport::DirectIOStat& { return stat_; }
+
+      private:
+        struct BufferDeleter
+        {
+            void operator()(char* buffer) const { std::free(buffer); } // NOLINT (cppcoreguidelines-no-malloc)
+        };
+        using Buffer = std::unique_ptr<char, BufferDeleter>;
+
+        struct FullBuffer
+        {
+            Buffer buffer;
+            std::size_t size = 0;
+        };
+
+        std::string filename_;
+        Options options_;
+        int file_descriptor_ = -1;
+        bool is_direct_ = false;
+        bool is_closed_ = false;
+
+        Buffer current_buffer_;
+        std::size_t current_size_ = 0;
+
+        // Shared with the background thread
+        std::mutex mutex_;
+        std::condition_variable buffer_ready_;
+        std::deque<FullBuffer> full_buffers_;
+        std::vector<Buffer> free_buffers_;
+        bool is_stopped_ = false;
+        bool is_failed_ = false;
+        AppReport::DirectIOStat stat_;
+        std::jthread write_thread_;
+
+        // Only used by the background thread
+        std::size_t file_offset_ = 0;
+        std::size_t preallocated_size_ = 0;
+
+        auto submit_buffer() -> bool;
+        void write_buffers();
+        auto write_to_file(std::string_view data) -> bool;
+        void preallocate(std::size_t end_offset);
+        void release_preallocation();
+        auto open_file(int flags) -> int;
+    };
+
+    //! Add the statistics of a closed file to the total statistics
+    inline void accumulate_direct_io_stat(AppReport::DirectIOStat& total, const AppReport::DirectIOStat& stat)
+    {
+        total.n_bytes += stat.n_bytes;
+        total.n_buffers += stat.n_buffers;
+        total.total_write_time_ms += stat.total_write_time_ms;
+        total.total_queue_depth += stat.total_queue_depth;
+        total.max_queue_depth = std::max(total.max_queue_depth, stat.max_queue_depth);
+        total.n_stalls += stat.n_stalls;
+    }
+} // namespace srs::sink
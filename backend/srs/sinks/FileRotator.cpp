@@ -0,0 +1,172 @@
+#include "FileRotator.hpp"
+#include "srs/utils/CommonFunctions.hpp"
+#include <algorithm>
+#include <array>
+#include <asio/post.hpp>
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fmt/format.h>
+#include <mutex>
+#include <spdlog/spdlog.h>
+#include <spawn.h>
+#include <string>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <system_error>
+#include <utility>
+
+extern char** environ; // NOLINT (readability-redundant-declaration)
+
+namespace srs::sink
+{
+    FileRotator::FileRotator(const std::string& filename, std::size_t n_lines, Options options)
+        : filename_{ filename }
+        , options_{ std::move(options) }
+        , n_lines_{ n_lines }
+    {
+        assert(n_lines > 0);
+        file_indices_.resize(n_lines);
+        open_times_.resize(n_lines, std::chrono::steady_clock::now());
+        reasons_.resize(n_lines, Reason::none);
+        stats_.resize(n_lines);
+    }
+
+    FileRotator::~FileRotator() { wait(); }
+
+    auto FileRotator::get_filename(std::size_t line_number) const -> std::string
+    {
+        auto line_filename =
+            (n_lines_ == 1) ? filename_ : common::insert_index_to_filename(filename_, static_cast<int>(line_number));
+        if (not is_enabled())
+        {
+            return line_filename;
+        }
+        auto filepath = std::filesystem::path{ line_filename };
+        auto extension = filepath.extension().string();
+        auto file_basename = filepath.replace_extension().string();
+        return fmt::format("{}.{:04}{}", file_basename, file_indices_[line_number], extension);
+    }
+
+    auto FileRotator::is_due(std::size_t line_number, std::size_t file_size) -> bool
+    {
+        if (options_.max_file_size > 0 and file_size >= options_.max_file_size)
+        {
+            reasons_[line_number] = Reason::size;
+            return true;
+        }
+        if (options_.max_duration.count() > 0 and
+            std::chrono::steady_clock::now() - open_times_[line_number] >= options_.max_duration)
+        {
+            reasons_[line_number] = Reason::time;
+            return true;
+        }
+        return false;
+    }
+
+    void FileRotator::rotate(std::size_t line_number, Closer closer)
+    {
+        spdlog::info("Writer: Output file {:?} is rotated after reaching its maximal {}.",
+                     get_filename(line_number),
+                     reasons_[line_number] == Reason::size ? "size" : "duration");
+        post_close(line_number, std::move(closer));
+        ++file_indices_[line_number];
+        open_times_[line_number] = std::chrono::steady_clock::now();
+    }
+
+    void FileRotator::close(std::size_t line_number, Closer closer)
+    {
+        reasons_[line_number] = Reason::none;
+        post_close(line_number, std::move(closer));
+    }
+
+    void FileRotator::post_close(std::size_t line_number, Closer closer)
+    {
+        asio::post(close_thread_,
+                   [this, line_number, reason = reasons_[line_number], closer = std::move(closer),
+                    filename = get_filename(line_number)]() mutable
+                   {
+                       const auto start_time = std::chrono::steady_clock::now();
+                       const auto file_size = closer();
+                       const auto close_time = std::chrono::steady_clock::now() - start_time;
+                       if (not options_.post_close_command.empty())
+                       {
+                           post_command(line_number, std::move(filename));
+                       }
+
+                       auto lock = std::lock_guard{ mutex_ };
+                       auto& stat = stats_[line_number];
+                       ++stat.n_files;
+                       stat.n_size_rotations += (reason == Reason::size) ? 1 : 0;
+                       stat.n_time_rotations += (reason == Reason::time) ? 1 : 0;
+                       stat.n_bytes += file_size;
+                       stat.max_close_time_ms = std::max(
+                           stat.max_close_time_ms, std::chrono::duration<double, std::milli>(close_time).count());
+                   });
+        reasons_[line_number] = Reason::none;
+    }
+
+    // Executed in the close thread
+    void FileRotator::post_command(std::size_t line_number, std::string filename)
+    {
+        asio::post(command_threads_,
+                   [this, line_number, filename = std::move(filename)]()
+                   {
+                       if (run_post_close_command(filename))
+                       {
+                           return;
+                       }
+                       auto lock = std::lock_guard{ mutex_ };
+                       ++stats_[line_number].n_failed_commands;
+                   });
+    }
+
+    // Executed in the command threads
+    auto FileRotator::run_post_close_command(const std::string& filename) const -> bool
+    {
+        // The filename is passed as a positional parameter such that it's never interpreted by the shell.
+        const auto& command = options_.post_close_command;
+        const auto script = command.contains("$1") ? command : fmt::format("{} \"$1\"", command);
+        // NOLINTBEGIN (cppcoreguidelines-pro-type-const-cast)
+        auto args = std::array{ const_cast<char*>("/bin/sh"),
+                                const_cast<char*>("-c"),
+                                const_cast<char*>(script.c_str()),
+                                const_cast<char*>("srs-post-close"),
+                                const_cast<char*>(filename.c_str()),
+                                static_cast<char*>(nullptr) };
+        // NOLINTEND (cppcoreguidelines-pro-type-const-cast)
+
+        auto process_id = pid_t{};
+        if (const auto err = ::posix_spawn(&process_id, "/bin/sh", nullptr, nullptr, args.data(), environ); err != 0)
+        {
+            spdlog::error("Failed to execute the post-close command {:?}: {}",
+                          options_.post_close_command,
+                          std::error_code{ err, std::system_category() }.message());
+            return false;
+        }
+        auto status = 0;
+        while (::waitpid(process_id, &status, 0) < 0)
+        {
+            if (errno != EINTR)
+            {
+                return false;
+            }
+        }
+        if (not WIFEXITED(status) or WEXITSTATUS(status) != 0)
+        {
+            spdlog::error("Post-close command {:?} failed for the file {:?}", options_.post_close_command, filename);
+            return false;
+        }
+        spdlog::debug("Post-close command {:?} is finished for the file {:?}", options_.post_close_command, filename);
+        return true;
+    }
+
+    void FileRotator::wait()
+    {
+        // Commands are only posted by the close thread.
+        close_thread_.join();
+        command_threads_.join();
+    }
+} // namespace srs::sink
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "srs/utils/AppReport.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
+#include <asio/thread_pool.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace srs::sink
+{
+    /**
+     * @brief Rotation of the output files of a file sink by size or by time
+     *
+     * Once the current file of a pipeline exceeds the maximal size or has been open for longer than the maximal
+     * duration, the sink opens the next file and hands the old one over, which is then closed and finalised by a
+     * background thread. Therefore, the writing is only interrupted by the opening of the new file.
+     *
+     * If the rotation is enabled, the file index is inserted into the filename before its extension with 4 digits,
+     * e.g. "output_0.0002.bin". If a post-close command is given, it's executed after each file is closed. The
+     * commands run in a separate thread pool such that a slow command doesn't delay the closing of the next files.
+     * The filename is available as "$1" in the command and is appended to the command if "$1" is not used.
+     */
+    class FileRotator
+    {
+      public:
+        struct Options
+        {
+            std::size_t max_file_size = 0;       //!< in bytes. 0 disables the rotation by size.
+            std::chrono::seconds max_duration{}; //!< 0 disables the rotation by time.
+            std::string post_close_command;      //!< shell command executed after each file is closed
+        };
+
+        //! Close and finalise a file. Returns the final size of the file in bytes.
+        using Closer = std::move_only_function<std::size_t()>;
+
+        /**
+         * @brief Constructor
+         *
+         * @param filename Name of the output file. Line indices are inserted into the name if n_lines > 1.
+         * @param n_lines Number of parallel pipelines
+         * @param options Rotation options
+         */
+        FileRotator(const std::string& filename, std::size_t n_lines, Options options);
+
+        FileRotator(const FileRotator&) = delete;
+        FileRotator(FileRotator&&) = delete;
+        FileRotator& operator=(const FileRotator&) = delete;
+        FileRotator& operator=(FileRotator&&) = delete;
+        ~FileRotator();
+
+        [[nodiscard]] auto is_enabled() const -> bool
+        {
+            return options_.max_file_size > 0 or options_.max_duration.count() > 0;
+        }
+
+        //! Whether the statistics should be reported
+        [[nodiscard]] auto is_reported() const -> bool
+        {
+            return is_enabled() or not options_.post_close_command.empty();
+        }
+
+        //! Name of the current file of the pipeline
+        [[nodiscard]] auto get_filename(std::size_t line_number) const -> std::string;
+
+        //! Check whether the current file of the pipeline should be rotated, given its current size.
+        [[nodiscard]] auto is_due(std::size_t line_number, std::size_t file_size) -> bool;
+
+        //! Close the current file of the pipeline in the background and move on to the next filename.
+        void rotate(std::size_t line_number, Closer closer);
+
+        //! Close the last file of the pipeline in the background.
+        void close(std::size_t line_number, Closer closer);
+
+        //! Block until all files are closed. No more files can be closed afterwards.
+        void wait();
+
+        //! Only valid after wait()
+        [[nodiscard]] auto get_stats() const -> const std::vector<AppReport::FileRotationStat>& { return stats_; }
+
+      private:
+        enum class Reason : uint8_t
+        {
+            none,
+            size,
+            time,
+        };
+
+        std::string filename_;
+        Options options_;
+        std::size_t n_lines_ = 1;
+        std::vector<int> file_indices_;
+        std::vector<std::chrono::steady_clock::time_point> open_times_;
+        std::vector<Reason> reasons_;
+
+        // Shared with the background thread
+        std::mutex mutex_;
+        std::vector<AppReport::FileRotationStat> stats_;
+        asio::thread_pool close_thread_{ 1 };
+        asio::thread_pool command_threads_{ common::POST_CLOSE_COMMAND_THREADS };
+
+        void post_close(std::size_t line_number, Closer closer);
+        void post_command(std::size_t line_number, std::string filename);
+        auto run_post_close_command(const std::string& filename) const -> bool;
+    };
+} // namespace srs::sink
@@ -1,14 +1,11 @@
 #include "FrameCountChecker.hpp"
 #include "srs/converters/DataConvertOptions.hpp"
-#include "srs/data/SRSDataStructs.hpp"
-#include "srs/utils/CommonAlias.hpp"
+#include "srs/converters/FrameHeaderParser.hpp"
 #include "srs/workflow/BaseTask.hpp"
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <expected>
-#include <fmt/base.h>
-#include <zpp_bits.h>
 
 namespace srs::sink
 {
@@ -17,26 +14,6 @@ namespace srs::sink
     {
     }
 
-    auto FrameCountChecker::extract_frame_counter(InputType binary_data) -> RunResult
-    {
-
-        auto deserialize_to = zpp::bits::in{ binary_data, zpp::bits::endian::network{}, zpp::bits::no_size{} };
-        auto read_bytes = binary_data.size() * sizeof(BufferElementType);
-        auto header = ReceiveDataHeader{};
-        constexpr auto header_bytes = sizeof(header);
-        if (read_bytes <= header_bytes)
-        {
-            return std::unexpected{ "Deserialization: The size of the binary data is too small!" };
-        }
-        auto err = deserialize_to(header);
-
-        if (zpp::bits::failure(err))
-        {
-            return std::unexpected{ "FrameCountChecker failed to deserialize the header" };
-        }
-        return header.frame_counter;
-    }
-
     void FrameCountChecker::register_frame_counter(int64_t frame_counter)
     {
         auto last_value = last_frame_counter_.load();
@@ -59,16 +36,14 @@ namespace srs::sink
         }
     }
 
-    auto FrameCountChecker::analyze_frame_counter(InputType binary_data) -> RunResult
+    auto FrameCountChecker::analyze_frame_counter(const process::FrameHeaderResult& header) -> RunResult
     {
-        auto frame_counter = extract_frame_counter(binary_data);
-
-        if (frame_counter)
+        if (not header.has_value())
         {
-            register_frame_counter(frame_counter.value());
+            return std::unexpected{ "Deserialization: The size of the binary data is too small!" };
         }
-
-        return frame_counter;
+        register_frame_counter(header->frame_counter);
+        return header->frame_counter;
     }
 
     FrameCountChecker::~FrameCountChecker() {}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "DataWriterOptions.hpp"
+#include "srs/converters/FrameHeaderParser.hpp"
 #include "srs/utils/CommonConcepts.hpp"
 #include "srs/workflow/BaseTask.hpp"
 #include <atomic>
@@ -8,6 +9,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <string_view>
+#include <type_traits>
 
 namespace srs::sink
 {
@@ -27,8 +29,15 @@ namespace srs::sink
         auto run(const OutputTo<InputType> auto& prev_data_converter, std::size_t line_number = 0) -> RunResult
         {
             assert(line_number < get_n_lines());
-            auto input_data = prev_data_converter(line_number);
-            return analyze_frame_counter(input_data);
+            // Only the header is needed, which is taken from the beginning of the pipeline if available.
+            if constexpr (FrameHeaderProvider<std::remove_cvref_t<decltype(prev_data_converter)>>)
+            {
+                return analyze_frame_counter(prev_data_converter.get_frame_header(line_number));
+            }
+            else
+            {
+                return analyze_frame_counter(process::parse_frame_header(prev_data_converter(line_number)));
+            }
         }
 
         [[nodiscard]] auto get_frame_drop_count() const -> int64_t { return frame_drop_counter_.load(); }
@@ -39,8 +48,7 @@ namespace srs::sink
         std::atomic<int64_t> last_frame_counter_;
         std::atomic<int64_t> frame_drop_counter_;
 
-        auto analyze_frame_counter(InputType binary_data) -> RunResult;
-        auto extract_frame_counter(InputType binary_data) -> RunResult;
+        auto analyze_frame_counter(const process::FrameHeaderResult& header) -> RunResult;
         void register_frame_counter(int64_t frame_counter);
     };
 } // namespace srs::sink
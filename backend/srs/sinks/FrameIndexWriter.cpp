@@ -0,0 +1,46 @@
+#include "FrameIndexWriter.hpp"
+#include "srs/data/SRSDataStructs.hpp"
+#include "srs/readers/FrameIndex.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fmt/format.h>
+#include <ios>
+#include <stdexcept>
+#include <string>
+#include <zpp_bits.h>
+
+namespace srs::sink
+{
+    FrameIndexWriter::FrameIndexWriter(const std::string& data_filename, std::size_t interval)
+        : interval_{ std::max(interval, std::size_t{ 1 }) }
+    {
+        n_fec_frames_since_entry_.fill(interval_);
+        const auto index_filename = reader::FrameIndex::get_index_filename(data_filename);
+        output_file_.open(index_filename, std::ios::trunc | std::ios::binary);
+        if (not output_file_.is_open())
+        {
+            throw std::runtime_error(fmt::format("Filename {:?} cannot be open!", index_filename));
+        }
+        auto header = std::array<char, reader::FrameIndex::HEADER_SIZE>{};
+        auto serialize_to = zpp::bits::out{ header };
+        serialize_to(reader::FrameIndex::MAGIC, static_cast<uint32_t>(interval_)).or_throw();
+        output_file_.write(header.data(), static_cast<std::streamsize>(header.size()));
+    }
+
+    void FrameIndexWriter::add(uint64_t offset, const ReceiveDataHeader& header)
+    {
+        auto& n_frames_since_entry = n_fec_frames_since_entry_[header.fec_id];
+        if (n_frames_since_entry >= interval_)
+        {
+            auto entry = std::array<char, reader::FrameIndex::ENTRY_SIZE>{};
+            auto serialize_to = zpp::bits::out{ entry };
+            serialize_to(offset, n_frames_, header.frame_counter, header.udp_timestamp, header.fec_id).or_throw();
+            output_file_.write(entry.data(), static_cast<std::streamsize>(entry.size()));
+            n_frames_since_entry = 0;
+        }
+        ++n_frames_since_entry;
+        ++n_frames_;
+    }
+} // namespace srs::sink
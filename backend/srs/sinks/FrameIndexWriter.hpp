@@ -0,0 +1,42 @@
+#pragma once
+
+#include "srs/data/SRSDataStructs.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+namespace srs::sink
+{
+    /**
+     * @brief Writer of the sidecar index of an uncompressed binary output file
+     *
+     * The frames are counted separately for each FEC. The first frame of each FEC and then every interval frames of
+     * the same FEC are recorded with their offsets and frame headers, such that every FEC can be found in the index
+     * even if the frames of multiple FECs are interleaved. Frames with invalid headers are counted but never recorded.
+     * See srs::reader::FrameIndex for the file format.
+     */
+    class FrameIndexWriter
+    {
+      public:
+        //! Create or truncate the index file of the data file. Throws if the file cannot be opened.
+        FrameIndexWriter(const std::string& data_filename, std::size_t interval);
+
+        //! Count the next frame, located at the offset of the data file, and record it if it's due for its FEC.
+        void add(uint64_t offset, const ReceiveDataHeader& header);
+
+        //! Count the next frame, whose header is invalid.
+        void count_frame() { ++n_frames_; }
+
+        void close() { output_file_.close(); }
+
+      private:
+        std::size_t interval_ = 1;
+        uint64_t n_frames_ = 0;
+        // Number of frames of each FEC since its last entry. FECs without any entry start at the interval.
+        std::array<std::size_t, std::size_t{ 1 } << common::FEC_ID_BIT_LENGTH> n_fec_frames_since_entry_{};
+        std::ofstream output_file_;
+    };
+} // namespace srs::sink
@@ -1,18 +1,24 @@
 #include "JsonWriter.hpp"
 #include "srs/converters/DataConvertOptions.hpp"
 #include "srs/data/SRSDataStructs.hpp"
-#include "srs/utils/CommonFunctions.hpp"
+#include "srs/sinks/FileRotator.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
 #include "srs/workflow/BaseTask.hpp"
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <filesystem>
+#include <fstream>
 #include <glaze/core/opts.hpp>
 #include <glaze/core/write.hpp>
 #include <ios>
+#include <memory>
 #include <ranges>
 #include <spdlog/spdlog.h>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace srs::sink
@@ -22,102 +28,203 @@ namespace srs::sink
         header = data_struct.header;
         fill_hit_data(data_struct.hit_data);
         fill_marker_data(data_struct.marker_data);
+        hit_time = data_struct.hit_time;
+        hit_plane.assign(data_struct.hit_plane.begin(), data_struct.hit_plane.end());
+        hit_strip = data_struct.hit_strip;
+        clusters = data_struct.clusters;
+        events = data_struct.events;
     }
 
     void CompactExportData::fill_hit_data(const std::vector<HitData>& hits)
     {
         hit_size = hits.size();
-        for (auto& [key, value] : hit_data)
+        for (auto* column : { &hit_data.adc,
+                              &hit_data.bc_id,
+                              &hit_data.channel_num,
+                              &hit_data.is_over_threshold,
+                              &hit_data.offset,
+                              &hit_data.tdc,
+                              &hit_data.vmm_id })
         {
-            value.clear();
-            value.reserve(hit_size);
+            column->clear();
+            column->reserve(hit_size);
         }
         for (const auto& hit : hits)
         {
-            hit_data.at("is_over_threshold").push_back(static_cast<uint16_t>(hit.is_over_threshold));
-            hit_data.at("channel_num").push_back(hit.channel_num);
-            hit_data.at("tdc").push_back(hit.tdc);
-            hit_data.at("offset").push_back(hit.offset);
-            hit_data.at("vmm_id").push_back(hit.vmm_id);
-            hit_data.at("adc").push_back(hit.adc);
-            hit_data.at("bc_id").push_back(hit.bc_id);
+            hit_data.is_over_threshold.push_back(static_cast<uint16_t>(hit.is_over_threshold));
+            hit_data.channel_num.push_back(hit.channel_num);
+            hit_data.tdc.push_back(hit.tdc);
+            hit_data.offset.push_back(hit.offset);
+            hit_data.vmm_id.push_back(hit.vmm_id);
+            hit_data.adc.push_back(hit.adc);
+            hit_data.bc_id.push_back(hit.bc_id);
         }
     }
 
     void CompactExportData::fill_marker_data(const std::vector<MarkerData>& markers)
     {
         marker_size = markers.size();
-        for (auto& [key, value] : marker_data)
-        {
-            value.clear();
-            value.reserve(marker_size);
-        }
+        marker_data.vmm_id.clear();
+        marker_data.srs_timestamp.clear();
+        marker_data.vmm_id.reserve(marker_size);
+        marker_data.srs_timestamp.reserve(marker_size);
         for (const auto& marker : markers)
         {
-            marker_data.at("vmm_id").push_back(marker.vmm_id);
-            marker_data.at("srs_timestamp").push_back(marker.srs_timestamp);
+            marker_data.vmm_id.push_back(marker.vmm_id);
+            marker_data.srs_timestamp.push_back(marker.srs_timestamp);
         }
     }
 
-    Json::Json(const std::string& filename, process::DataConvertOptions convert_mode, std::size_t n_lines)
+    namespace
+    {
+        auto is_json_lines_filename(const std::string& filename) -> bool
+        {
+            const auto file_ext = std::filesystem::path{ filename }.extension();
+            return file_ext == ".jsonl" or file_ext == ".ndjson";
+        }
+    } // namespace
+
+    Json::Json(const std::string& filename,
+               process::DataConvertOptions convert_mode,
+               std::size_t n_lines,
+               const FileRotator::Options& rotation)
         : SinkTask{ "JSONWriter", convert_mode, n_lines }
         , filename_{ filename }
+        , is_json_lines_{ is_json_lines_filename(filename) }
+        , rotator_{ std::make_unique<FileRotator>(filename, n_lines, rotation) }
     {
         assert(n_lines > 0);
         is_first_item_.resize(n_lines);
         output_data_.resize(n_lines);
         data_buffers_.resize(n_lines);
         string_buffers_.resize(n_lines);
-        file_streams_.reserve(n_lines);
+        write_buffers_.resize(n_lines);
+        file_streams_.resize(n_lines);
+        file_sizes_.resize(n_lines);
 
-        for (auto idx : std::views::iota(0, static_cast<int>(n_lines)))
+        for (auto idx : std::views::iota(std::size_t{ 0 }, n_lines))
         {
-            auto full_filename = (n_lines == 1) ? filename : common::insert_index_to_filename(filename, idx);
-            file_streams_.emplace_back(full_filename, std::ios::out | std::ios::trunc);
-        }
-
-        for (auto& file_stream : file_streams_)
-        {
-            if (not file_stream.is_open())
-            {
-                spdlog::critical("JsonWriter: cannot open the file with filename {:?}", filename);
-                throw std::runtime_error("Error occurred with JsonWriter");
-            }
-            file_stream << "[\n";
+            open_file(idx);
         }
     }
+
     Json::~Json()
     {
-        for (auto [idx, file_stream] : std::views::zip(std::views::iota(0), file_streams_))
+        if (rotator_ == nullptr)
         {
-            file_stream << "]\n";
-            file_stream.close();
-            spdlog::debug("JSON file {} with index {} is closed successfully", filename_, idx);
+            return;
+        }
+        for (auto [idx, file_stream, file_size] :
+             std::views::zip(std::views::iota(std::size_t{ 0 }), file_streams_, file_sizes_))
+        {
+            rotator_->close(idx,
+                            [&file_stream, &file_size, idx, this]()
+                            {
+                                write_buffers_[idx].append(get_closing());
+                                flush(idx);
+                                file_stream.close();
+                                spdlog::debug("JSON file {} with index {} is closed successfully", filename_, idx);
+                                return file_size + get_closing().size();
+                            });
+        }
+        rotator_->wait();
+        if (auto* report = get_report(); report != nullptr and rotator_->is_reported())
+        {
+            report->register_file_rotation_result(filename_, rotator_->get_stats());
         }
         spdlog::info("Writer: JSON file writer with the base name {:?} is closed successfully.", filename_);
     }
 
-    void Json::write_json(const StructData& data_struct, std::size_t line_num)
+    auto Json::get_closing() const -> std::string_view
     {
-        if (not is_first_item_[line_num].value)
+        return is_json_lines_ ? std::string_view{} : std::string_view{ "]\n" };
+    }
+
+    void Json::open_file(std::size_t line_num)
+    {
+        const auto full_filename = rotator_->get_filename(line_num);
+        auto& file_stream = file_streams_[line_num];
+        file_stream.open(full_filename, std::ios::out | std::ios::trunc);
+        if (not file_stream.is_open())
         {
-            file_streams_[line_num] << ", ";
+            spdlog::critical("JsonWriter: cannot open the file with filename {:?}", full_filename);
+            throw std::runtime_error("Error occurred with JsonWriter");
         }
-        else
+        auto& write_buffer = write_buffers_[line_num];
+        write_buffer.reserve(common::JSON_FLUSH_SIZE + string_buffers_[line_num].capacity());
+        if (not is_json_lines_)
         {
-            is_first_item_[line_num].value = false;
+            write_buffer.append("[\n");
         }
+        file_sizes_[line_num] = write_buffer.size();
+        is_first_item_[line_num].value = true;
+    }
+
+    void Json::flush(std::size_t line_num)
+    {
+        auto& write_buffer = write_buffers_[line_num];
+        file_streams_[line_num].write(write_buffer.data(), static_cast<std::streamsize>(write_buffer.size()));
+        write_buffer.clear();
+    }
+
+    void Json::rotate(std::size_t line_num)
+    {
+        write_buffers_[line_num].append(get_closing());
+        file_sizes_[line_num] += get_closing().size();
+        rotator_->rotate(line_num,
+                         [file_stream = std::move(file_streams_[line_num]),
+                          write_buffer = std::move(write_buffers_[line_num]),
+                          file_size = file_sizes_[line_num]]() mutable
+                         {
+                             file_stream.write(write_buffer.data(), static_cast<std::streamsize>(write_buffer.size()));
+                             file_stream.close();
+                             return file_size;
+                         });
+        file_streams_[line_num] = std::fstream{};
+        write_buffers_[line_num] = std::string{};
+        open_file(line_num);
+    }
+
+    void Json::write_json(const StructData& data_struct, std::size_t line_num)
+    {
+        auto& write_buffer = write_buffers_[line_num];
+        auto& string_buffer = string_buffers_[line_num];
+        auto& export_data = data_buffers_[line_num];
+        const auto previous_size = write_buffer.size();
 
-        data_buffers_[line_num].set_value(data_struct);
-        auto error_code = glz::write<glz::opts{ .prettify = true }>(data_buffers_[line_num], string_buffers_[line_num]);
+        export_data.set_value(data_struct);
+        auto error_code = is_json_lines_ ? glz::write<glz::opts{}>(export_data, string_buffer)
+                                         : glz::write<glz::opts{ .prettify = true }>(export_data, string_buffer);
         if (error_code)
         {
             spdlog::critical("JsonWriter: cannot interpret data struct to json. Error: {}",
                              error_code.custom_error_message);
             throw std::runtime_error("Error occurred with JsonWriter");
         }
-        output_data_[line_num] = string_buffers_[line_num].size();
-        file_streams_[line_num] << string_buffers_[line_num];
-        string_buffers_[line_num].clear();
+
+        if (is_json_lines_)
+        {
+            write_buffer.append(string_buffer);
+            write_buffer.push_back('\n');
+        }
+        else
+        {
+            if (not is_first_item_[line_num].value)
+            {
+                write_buffer.append(", ");
+            }
+            is_first_item_[line_num].value = false;
+            write_buffer.append(string_buffer);
+        }
+        output_data_[line_num] = string_buffer.size();
+        file_sizes_[line_num] += write_buffer.size() - previous_size;
+        if (write_buffer.size() >= common::JSON_FLUSH_SIZE)
+        {
+            flush(line_num);
+        }
+        if (rotator_->is_enabled() and rotator_->is_due(line_num, file_sizes_[line_num]))
+        {
+            rotate(line_num);
+        }
     }
 } // namespace srs::sink
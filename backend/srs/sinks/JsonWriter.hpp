@@ -3,6 +3,7 @@
 #include "srs/converters/DataConvertOptions.hpp"
 #include "srs/data/SRSDataStructs.hpp"
 #include "srs/sinks/DataWriterOptions.hpp"
+#include "srs/sinks/FileRotator.hpp"
 #include "srs/utils/CommonConcepts.hpp"
 #include "srs/workflow/BaseTask.hpp"
 #include <asio/any_io_executor.hpp>
@@ -15,7 +16,7 @@
 #include <glaze/core/opts.hpp>
 #include <glaze/core/write.hpp>
 #include <glaze/glaze.hpp>
-#include <map>
+#include <memory>
 #include <spdlog/spdlog.h>
 #include <string>
 #include <string_view>
@@ -23,19 +24,36 @@
 
 namespace srs::sink
 {
+    // Members are in the alphabetical order, which is the key order of the JSON objects.
+    struct HitColumns
+    {
+        std::vector<uint16_t> adc;
+        std::vector<uint16_t> bc_id;
+        std::vector<uint16_t> channel_num;
+        std::vector<uint16_t> is_over_threshold;
+        std::vector<uint16_t> offset;
+        std::vector<uint16_t> tdc;
+        std::vector<uint16_t> vmm_id;
+    };
+
+    struct MarkerColumns
+    {
+        std::vector<uint64_t> srs_timestamp;
+        std::vector<uint64_t> vmm_id;
+    };
+
     struct CompactExportData
     {
         ReceiveDataHeader header{};
         std::size_t marker_size{};
         std::size_t hit_size{};
-        std ::map<std::string, std::vector<uint64_t>> marker_data{ { "vmm_id", {} }, { "srs_timestamp", {} } };
-        std ::map<std::string, std::vector<uint16_t>> hit_data{ { "is_over_threshold", {} },
-                                                                { "channel_num", {} },
-                                                                { "tdc", {} },
-                                                                { "offset", {} },
-                                                                { "vmm_id", {} },
-                                                                { "adc", {} },
-                                                                { "bc_id", {} } };
+        MarkerColumns marker_data;
+        HitColumns hit_data;
+        std::vector<uint64_t> hit_time;
+        std::vector<uint16_t> hit_plane;
+        std::vector<uint16_t> hit_strip;
+        std::vector<ClusterData> clusters;
+        std::vector<EventData> events;
 
         void set_value(const StructData& data_struct);
 
@@ -44,6 +62,14 @@ namespace srs::sink
         void fill_marker_data(const std::vector<MarkerData>& markers);
     };
 
+    /**
+     * @brief Output of the struct data to JSON files
+     *
+     * Files with the extension ".json" contain a prettified array of all frames. Files with the extension ".jsonl" or
+     * ".ndjson" are written in the JSON Lines format, i.e. one compact JSON object per frame and per line. The
+     * serialized frames are collected in a write buffer, which is written to the file every
+     * common::JSON_FLUSH_SIZE bytes.
+     */
     class Json : public process::SinkTask<DataWriterOption::json, const StructData*, std::size_t>
     {
       public:
@@ -54,7 +80,10 @@ namespace srs::sink
             explicit operator bool() const { return value; }
         };
 
-        explicit Json(const std::string& filename, process::DataConvertOptions convert_mode, std::size_t n_lines = 1);
+        explicit Json(const std::string& filename,
+                      process::DataConvertOptions convert_mode,
+                      std::size_t n_lines = 1,
+                      const FileRotator::Options& rotation = {});
 
         Json(const Json&) = delete;
         Json(Json&&) = default;
@@ -77,15 +106,26 @@ namespace srs::sink
             return this->operator()(line_number);
         }
 
+        //! Whether the output is in the JSON Lines format
+        [[nodiscard]] auto is_json_lines() const -> bool { return is_json_lines_; }
+
       private:
         static constexpr auto name_ = std::string_view{};
         std::vector<Bool> is_first_item_;
         std::string filename_;
+        bool is_json_lines_ = false;
         std::vector<OutputType> output_data_;
         std::vector<std::fstream> file_streams_;
+        std::vector<std::size_t> file_sizes_;
         std::vector<CompactExportData> data_buffers_;
         std::vector<std::string> string_buffers_;
+        std::vector<std::string> write_buffers_;
+        std::unique_ptr<FileRotator> rotator_;
 
+        void open_file(std::size_t line_num);
+        void rotate(std::size_t line_num);
+        void flush(std::size_t line_num);
+        [[nodiscard]] auto get_closing() const -> std::string_view;
         void write_json(const StructData& data_struct, std::size_t line_num);
     };
 
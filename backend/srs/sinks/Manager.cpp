@@ -3,12 +3,17 @@
 #include "FrameCountChecker.hpp"
 #include "srs/converters/DataConvertOptions.hpp"
 #include "srs/sinks/BinaryFileWriter.hpp"
+#include "srs/sinks/CompactFileWriter.hpp"
+#include "srs/sinks/DirectFile.hpp"
+#include "srs/sinks/FileRotator.hpp"
 #include "srs/sinks/JsonWriter.hpp"
 #include "srs/sinks/UDPWriter.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
 #include "srs/workflow/AnalysisHandle.hpp"
 #include <algorithm>
 #include <asio/ip/udp.hpp>
 #include <asio/thread_pool.hpp>
+#include <chrono>
 #include <magic_enum/magic_enum.hpp>
 #include <map>
 #include <memory>
@@ -25,6 +30,10 @@
 #include "srs/sinks/RootFileWriter.hpp"
 #endif
 
+#ifdef HAS_ARROW
+#include "srs/sinks/ArrowFileWriter.hpp"
+#endif
+
 namespace srs::sink
 {
     namespace
@@ -32,7 +41,8 @@ namespace srs::sink
         auto convert_str_to_endpoint(asio::thread_pool& thread_pool, std::string_view ip_port)
             -> std::optional<asio::ip::udp::endpoint>
         {
-            const auto question_pos = ip_port.find('?');
+            // '?', '#' or '!' in front of the port number specifies the data format
+            const auto format_pos = ip_port.find_first_of("?#!");
             const auto colon_pos = ip_port.find(':');
             if (colon_pos == std::string::npos)
             {
@@ -41,7 +51,7 @@ namespace srs::sink
             }
             auto ip_string = ip_port.substr(0, colon_pos);
             auto port_str =
-                (question_pos == std::string::npos) ? ip_port.substr(colon_pos + 1) : ip_port.substr(question_pos + 1);
+                (format_pos == std::string::npos) ? ip_port.substr(colon_pos + 1) : ip_port.substr(format_pos + 1);
 
             auto err_code = std::error_code{};
             auto resolver = asio::ip::udp::resolver{ thread_pool };
@@ -68,6 +78,17 @@ namespace srs::sink
 #endif
         }
 
+        auto check_arrow_dependency() -> bool
+        {
+#ifdef HAS_ARROW
+            return true;
+#else
+            spdlog::error("Cannot output to a Parquet or Arrow file. Please make sure the program is "
+                          "built with the Apache Arrow library.");
+            return false;
+#endif
+        }
+
     } // namespace
 
     Manager::Manager(workflow::AnalysisHandle* processor)
@@ -108,11 +129,38 @@ namespace srs::sink
         }
     }
 
+    auto Manager::get_rotation_options() const -> FileRotator::Options
+    {
+        const auto& config = workflow_handler_->get_app_ref().get_config();
+        return FileRotator::Options{ .max_file_size = config.output_rotation_size,
+                                     .max_duration = std::chrono::seconds{ config.output_rotation_time },
+                                     .post_close_command = config.output_post_close_command };
+    }
+
     auto Manager::add_binary_file(const std::string& filename, process::DataConvertOptions prev_conversion) -> bool
     {
+        const auto& config = workflow_handler_->get_app_ref().get_config();
+        const auto compression = BinaryFileCompression{
+            .proto = { .type = config.proto_compression,
+                       .level = config.proto_compression_level,
+                       .dict_n_frames = config.proto_compression_dict_frames },
+            .raw = { .block_size = config.raw_compression_block_size,
+                     .level = config.raw_compression_level,
+                     .max_pending_blocks = common::RAW_BLOCK_MAX_PENDING_PER_THREAD * config.raw_compression_threads },
+            .n_raw_threads = config.raw_compression_threads
+        };
+        const auto direct_io = DirectFile::Options{ .buffer_size = config.direct_io_buffer_size,
+                                                    .n_buffers = config.direct_io_n_buffers,
+                                                    .preallocation_size = config.direct_io_preallocation_size };
         return binary_files_
             .try_emplace(filename,
-                         std::make_unique<BinaryFile>(filename, prev_conversion, workflow_handler_->get_n_lines()))
+                         std::make_unique<BinaryFile>(filename,
+                                                      prev_conversion,
+                                                      workflow_handler_->get_n_lines(),
+                                                      compression,
+                                                      direct_io,
+                                                      get_rotation_options(),
+                                                      config.frame_index_interval))
             .second;
     }
 
@@ -137,10 +185,20 @@ namespace srs::sink
                                 [[maybe_unused]] process::DataConvertOptions prev_conversion) -> bool
     {
 #ifdef HAS_ROOT
+        const auto& config = workflow_handler_->get_app_ref().get_config();
+        const auto options = RootFile::Options{ .compression = config.root_compression,
+                                                .compression_level = config.root_compression_level,
+                                                .basket_size = config.root_basket_size,
+                                                .split_level = config.root_split_level,
+                                                .cluster_size = config.root_cluster_size,
+                                                .is_merged = config.root_merge_lines };
         return root_files_
-            .try_emplace(
-                filename,
-                std::make_unique<RootFile>(filename.c_str(), prev_conversion, workflow_handler_->get_n_lines()))
+            .try_emplace(filename,
+                         std::make_unique<RootFile>(filename,
+                                                    prev_conversion,
+                                                    workflow_handler_->get_n_lines(),
+                                                    options,
+                                                    get_rotation_options()))
             .second;
 #else
         return false;
@@ -150,10 +208,54 @@ namespace srs::sink
     auto Manager::add_json_file(const std::string& filename, process::DataConvertOptions prev_conversion) -> bool
     {
         return json_files_
-            .try_emplace(filename, std::make_unique<Json>(filename, prev_conversion, workflow_handler_->get_n_lines()))
+            .try_emplace(filename,
+                         std::make_unique<Json>(
+                             filename, prev_conversion, workflow_handler_->get_n_lines(), get_rotation_options()))
+            .second;
+    }
+
+    auto Manager::add_compact_file(const std::string& filename, process::DataConvertOptions prev_conversion) -> bool
+    {
+        const auto& config = workflow_handler_->get_app_ref().get_config();
+        if (config.hit_time_reconstruction or not config.channel_mapping_filename.empty() or
+            not config.trigger_rules.empty() or config.cluster_time_window_ps > 0 or config.event_window_ps > 0)
+        {
+            spdlog::warn("Writer: Compact file {:?} doesn't store the hit time, plane and strip, the clusters or the "
+                         "events, which are produced by the struct processing.",
+                         filename);
+        }
+        return compact_files_
+            .try_emplace(filename,
+                         std::make_unique<CompactFile>(filename,
+                                                       prev_conversion,
+                                                       workflow_handler_->get_n_lines(),
+                                                       config.compact_block_frames,
+                                                       get_rotation_options()))
             .second;
     }
 
+    auto Manager::add_arrow_file([[maybe_unused]] const std::string& filename,
+                                 [[maybe_unused]] process::DataConvertOptions prev_conversion) -> bool
+    {
+#ifdef HAS_ARROW
+        const auto& config = workflow_handler_->get_app_ref().get_config();
+        const auto options = ArrowFile::Options{ .batch_size = config.arrow_batch_size,
+                                                 .row_group_size = config.parquet_row_group_size,
+                                                 .compression = config.arrow_compression,
+                                                 .compression_level = config.arrow_compression_level };
+        return arrow_files_
+            .try_emplace(filename,
+                         std::make_unique<ArrowFile>(filename,
+                                                     prev_conversion,
+                                                     workflow_handler_->get_n_lines(),
+                                                     options,
+                                                     get_rotation_options()))
+            .second;
+#else
+        return false;
+#endif
+    }
+
     void Manager::set_output_filenames(const std::vector<std::string>& filenames)
     {
         for (const auto& filename : filenames)
@@ -188,6 +290,16 @@ namespace srs::sink
                 case json:
                     is_ok = add_json_file(filename, convert_mode);
                     break;
+                case arrow:
+                    if (not check_arrow_dependency())
+                    {
+                        continue;
+                    }
+                    is_ok = add_arrow_file(filename, convert_mode);
+                    break;
+                case compact:
+                    is_ok = add_compact_file(filename, convert_mode);
+                    break;
             }
 
             if (is_ok)
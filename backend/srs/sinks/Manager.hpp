@@ -2,7 +2,9 @@
 
 #include "srs/converters/DataConvertOptions.hpp"
 #include "srs/sinks/BinaryFileWriter.hpp"
+#include "srs/sinks/CompactFileWriter.hpp"
 #include "srs/sinks/DataWriterOptions.hpp"
+#include "srs/sinks/FileRotator.hpp"
 #include "srs/sinks/FrameCountChecker.hpp"
 #include "srs/sinks/JsonWriter.hpp"
 #include "srs/sinks/UDPWriter.hpp"
@@ -18,6 +20,10 @@
 #include "srs/sinks/RootFileWriter.hpp"
 #endif
 
+#ifdef HAS_ARROW
+#include "srs/sinks/ArrowFileWriter.hpp"
+#endif
+
 namespace srs::workflow
 {
     class AnalysisHandle;
@@ -28,9 +34,18 @@ namespace srs::sink
     template <typename T>
     concept SinkVisitor =
 #ifdef HAS_ROOT
-        requires(T visitor, BinaryFile& binary_file, BinaryFile& UDP_file, BinaryFile& JSON_file, RootFile& root_file)
+        requires(T visitor,
+                 BinaryFile& binary_file,
+                 BinaryFile& UDP_file,
+                 BinaryFile& JSON_file,
+                 CompactFile& compact_file,
+                 RootFile& root_file)
 #else
-        requires(T visitor, BinaryFile& binary_file, BinaryFile& UDP_file, BinaryFile& JSON_file)
+        requires(T visitor,
+                 BinaryFile& binary_file,
+                 BinaryFile& UDP_file,
+                 BinaryFile& JSON_file,
+                 CompactFile& compact_file)
 #endif
     {
         { visitor(std::string_view{}, binary_file) } -> std::same_as<void>;
@@ -39,7 +54,14 @@ namespace srs::sink
 #endif
         { visitor(std::string_view{}, UDP_file) } -> std::same_as<void>;
         { visitor(std::string_view{}, JSON_file) } -> std::same_as<void>;
-    };
+        { visitor(std::string_view{}, compact_file) } -> std::same_as<void>;
+    }
+#ifdef HAS_ARROW
+        and requires(T visitor, ArrowFile& arrow_file) {
+            { visitor(std::string_view{}, arrow_file) } -> std::same_as<void>;
+        }
+#endif
+    ;
 
     class Manager
     {
@@ -73,15 +95,22 @@ namespace srs::sink
         std::unique_ptr<FrameCountChecker> frame_count_checker_;
         std::map<std::string, std::unique_ptr<UDP>> udp_files_;
         std::map<std::string, std::unique_ptr<Json>> json_files_;
+        std::map<std::string, std::unique_ptr<CompactFile>> compact_files_;
 #ifdef HAS_ROOT
         std::map<std::string, std::unique_ptr<RootFile>> root_files_;
+#endif
+#ifdef HAS_ARROW
+        std::map<std::string, std::unique_ptr<ArrowFile>> arrow_files_;
 #endif
         workflow::AnalysisHandle* workflow_handler_ = nullptr;
 
+        [[nodiscard]] auto get_rotation_options() const -> FileRotator::Options;
         auto add_binary_file(const std::string& filename, process::DataConvertOptions prev_conversion) -> bool;
         auto add_udp_file(const std::string& filename, process::DataConvertOptions prev_conversion) -> bool;
         auto add_root_file(const std::string& filename, process::DataConvertOptions prev_conversion) -> bool;
         auto add_json_file(const std::string& filename, process::DataConvertOptions prev_conversion) -> bool;
+        auto add_compact_file(const std::string& filename, process::DataConvertOptions prev_conversion) -> bool;
+        auto add_arrow_file(const std::string& filename, process::DataConvertOptions prev_conversion) -> bool;
 
         template <typename WriterType>
         void for_each_file(std::map<std::string, std::unique_ptr<WriterType>>& writers, auto visitor)
@@ -106,12 +135,16 @@ namespace srs::sink
         for_each_file(binary_files_, visitor);
         for_each_file(udp_files_, visitor);
         for_each_file(json_files_, visitor);
+        for_each_file(compact_files_, visitor);
         if (frame_count_checker_ != nullptr)
         {
             visitor("FrameCountChecker", *frame_count_checker_);
         }
 #ifdef HAS_ROOT
         for_each_file(root_files_, visitor);
+#endif
+#ifdef HAS_ARROW
+        for_each_file(arrow_files_, visitor);
 #endif
     }
 
@@ -120,12 +153,16 @@ namespace srs::sink
         for_each_file(binary_files_, visitor);
         for_each_file(udp_files_, visitor);
         for_each_file(json_files_, visitor);
+        for_each_file(compact_files_, visitor);
         if (frame_count_checker_ != nullptr)
         {
             visitor("FrameCountChecker", *frame_count_checker_);
         }
 #ifdef HAS_ROOT
         for_each_file(root_files_, visitor);
+#endif
+#ifdef HAS_ARROW
+        for_each_file(arrow_files_, visitor);
 #endif
     }
 } // namespace srs::sink
@@ -0,0 +1,57 @@
+#include "QuarantineFile.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
+#include <cstddef>
+#include <ios>
+#include <mutex>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <zpp_bits.h>
+
+namespace srs::sink
+{
+    QuarantineFile::QuarantineFile(const std::string& filename, std::size_t max_bytes)
+        : filename_{ filename }
+        , max_bytes_{ max_bytes }
+        , output_file_{ filename, std::ios::out | std::ios::trunc | std::ios::binary }
+    {
+        if (not output_file_.is_open())
+        {
+            throw std::runtime_error{ "Cannot open the quarantine file " + filename_ };
+        }
+        spdlog::info("Frames failed to be decoded are stored in the quarantine file {:?} (at most {} bytes)",
+                     filename_,
+                     max_bytes_);
+    }
+
+    auto QuarantineFile::write(std::string_view frame) -> bool
+    {
+        auto lock = std::lock_guard{ mutex_ };
+        const auto frame_bytes = frame.size() + sizeof(common::RawDelimSizeType);
+        if (is_full_ or written_bytes_ + frame_bytes > max_bytes_)
+        {
+            if (not is_full_)
+            {
+                is_full_ = true;
+                spdlog::warn("Quarantine file {:?} is full with {} bytes. Further bad frames are only counted.",
+                             filename_,
+                             written_bytes_);
+            }
+            return false;
+        }
+
+        buffer_.clear();
+        auto serialize_to = zpp::bits::out{ buffer_, zpp::bits::append{}, zpp::bits::endian::big{} };
+        if (zpp::bits::failure(
+                serialize_to(static_cast<common::RawDelimSizeType>(frame.size()), zpp::bits::unsized(frame))))
+        {
+            return false;
+        }
+        // Bad frames are rare. Flushing each of them keeps the file readable even if the program is killed.
+        output_file_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        output_file_.flush();
+        written_bytes_ += buffer_.size();
+        return output_file_.good();
+    }
+} // namespace srs::sink
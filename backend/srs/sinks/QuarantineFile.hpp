@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace srs::sink
+{
+    /**
+     * @brief Bounded file storing the UDP frames that fail to be decoded
+     *
+     * Frames are written with the same delimited format as the raw binary outputs, such that they can be read back
+     * with srs::reader::RawFrame. Once the maximum size is reached, further frames are rejected. Frames can be written
+     * from multiple pipelines concurrently.
+     */
+    class QuarantineFile
+    {
+      public:
+        QuarantineFile(const std::string& filename, std::size_t max_bytes);
+
+        //! Append one frame. Returns false if the file is full or not writable.
+        auto write(std::string_view frame) -> bool;
+
+        [[nodiscard]] auto get_filename() const -> const std::string& { return filename_; }
+
+      private:
+        std::string filename_;
+        std::size_t max_bytes_ = 0;
+        std::size_t written_bytes_ = 0;
+        bool is_full_ = false;
+        std::vector<char> buffer_;
+        std::ofstream output_file_;
+        std::mutex mutex_;
+    };
+} // namespace srs::sink
@@ -1,45 +1,205 @@
 #ifdef HAS_ROOT
 #include "RootFileWriter.hpp"
+#include "FileRotator.hpp"
 #include "srs/converters/DataConvertOptions.hpp"
-#include "srs/utils/CommonFunctions.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
 #include "srs/workflow/BaseTask.hpp"
+#include <Compression.h>
+#include <ROOT/TBufferMerger.hxx>
+#include <TDirectory.h>
 #include <TFile.h>
+#include <TROOT.h>
 #include <TTree.h>
+#include <asio/post.hpp>
+#include <asio/thread_pool.hpp>
 #include <cstddef>
+#include <filesystem>
+#include <future>
 #include <memory>
 #include <ranges>
 #include <spdlog/spdlog.h>
 #include <string>
+#include <utility>
 
 namespace srs::sink
 {
 
-    RootFile::RootFile(const std::string& filename, process::DataConvertOptions convert_mode, std::size_t n_lines)
+    namespace
+    {
+        // The tree is owned by the file.
+        auto close_root_file(TFile& root_file, TTree& tree) -> std::size_t
+        {
+            root_file.WriteObject(&tree, tree.GetName());
+            const auto file_size = static_cast<std::size_t>(root_file.GetSize());
+            root_file.Close();
+            spdlog::info("Writer: Root file {:?} is Closed.", root_file.GetName());
+            return file_size;
+        }
+
+        auto get_compression_setting(common::CompressionType compression, int level) -> int
+        {
+            using Algorithm = ROOT::RCompressionSetting::EAlgorithm;
+            using Level = ROOT::RCompressionSetting::ELevel;
+            switch (compression)
+            {
+                case common::CompressionType::none:
+                    return Level::kUncompressed;
+                case common::CompressionType::gzip:
+                    return ROOT::CompressionSettings(Algorithm::kZLIB, (level == 0) ? Level::kDefaultZLIB : level);
+                case common::CompressionType::zstd:
+                    return ROOT::CompressionSettings(Algorithm::kZSTD, (level == 0) ? Level::kDefaultZSTD : level);
+                case common::CompressionType::lz4:
+                    return ROOT::CompressionSettings(Algorithm::kLZ4, (level == 0) ? Level::kDefaultLZ4 : level);
+            }
+            return ROOT::RCompressionSetting::EDefaults::kUseGeneralPurpose;
+        }
+
+        // Only the post-close command is kept, since all lines are merged into the same file.
+        auto get_merged_rotation(const std::string& filename, const FileRotator::Options& rotation)
+            -> FileRotator::Options
+        {
+            if (rotation.max_file_size > 0 or rotation.max_duration.count() > 0)
+            {
+                spdlog::warn("Writer: Rotation of the merged ROOT file {:?} is not supported and disabled.", filename);
+            }
+            return FileRotator::Options{ .post_close_command = rotation.post_close_command };
+        }
+    } // namespace
+
+    RootFile::RootFile(const std::string& filename,
+                       process::DataConvertOptions convert_mode,
+                       std::size_t n_lines,
+                       const Options& options,
+                       const FileRotator::Options& rotation)
         : SinkTask{ "RootFile", convert_mode, n_lines }
         , base_filename_{ filename }
+        , options_{ options }
+        , compression_setting_{ get_compression_setting(options.compression, options.compression_level) }
+        , rotator_{ options.is_merged
+                        ? std::make_unique<FileRotator>(filename, 1, get_merged_rotation(filename, rotation))
+                        : std::make_unique<FileRotator>(filename, n_lines, rotation) }
     {
+        // Files are closed by the background thread of the rotator.
+        ROOT::EnableThreadSafety();
+        if (options_.is_merged)
+        {
+            merger_ = std::make_unique<ROOT::TBufferMerger>(
+                rotator_->get_filename(0).c_str(), "RECREATE", compression_setting_);
+            merger_files_.resize(n_lines);
+            pending_bytes_.resize(n_lines);
+            pending_merges_.resize(n_lines);
+            merge_thread_ = std::make_unique<asio::thread_pool>(1);
+            spdlog::info("Writer: Trees of {} lines are merged into the ROOT file {:?}.", n_lines, filename);
+        }
         root_files_.resize(n_lines);
         trees_.resize(n_lines);
         output_data_.resize(n_lines);
-        data_struct_buffers_.resize(n_lines);
-        for (auto [idx, root_file, tree] : std::views::zip(std::views::iota(0), root_files_, trees_))
+        data_struct_addresses_.resize(n_lines, &empty_data_);
+        for (auto idx : std::views::iota(std::size_t{ 0 }, n_lines))
+        {
+            open_file(idx);
+        }
+    }
+
+    void RootFile::open_file(std::size_t line_number)
+    {
+        auto* directory = static_cast<TDirectory*>(nullptr);
+        if (merger_ != nullptr)
+        {
+            merger_files_[line_number] = merger_->GetFile();
+            directory = merger_files_[line_number].get();
+        }
+        else
+        {
+            auto full_filename = rotator_->get_filename(line_number);
+            root_files_[line_number] =
+                std::make_unique<TFile>(full_filename.c_str(), "RECREATE", "", compression_setting_);
+            directory = root_files_[line_number].get();
+        }
+        auto& tree = trees_[line_number];
+        // NOTE: tree is owned by the TFile
+        tree = std::make_unique<TTree>("srs_data_tree", "Data structures from SRS system").release();
+        tree->SetDirectory(directory);
+        if (options_.cluster_size > 0)
         {
-            auto full_filename = (n_lines == 1) ? filename : common::insert_index_to_filename(filename, idx);
-            root_file = std::make_unique<TFile>(full_filename.c_str(), "RECREATE");
-            // NOTE: tree is owned by the TFile
-            tree = std::make_unique<TTree>("srs_data_tree", "Data structures from SRS system").release();
-            tree->SetDirectory(root_file.get());
-            tree->Branch("srs_frame_data", &data_struct_buffers_[static_cast<std::size_t>(idx)]);
+            tree->SetAutoFlush(options_.cluster_size);
         }
+        // The address of the pointer is bound, such that the pointer can be changed for each entry.
+        tree->Branch(
+            "srs_frame_data", &data_struct_addresses_[line_number], options_.basket_size, options_.split_level);
+    }
+
+    void RootFile::rotate(std::size_t line_number)
+    {
+        rotator_->rotate(line_number,
+                         [root_file = std::move(root_files_[line_number]), tree = trees_[line_number]]()
+                         { return close_root_file(*root_file, *tree); });
+        open_file(line_number);
+    }
+
+    void RootFile::push_to_merger(std::size_t line_number)
+    {
+        auto& pending_bytes = pending_bytes_[line_number];
+        pending_bytes += output_data_[line_number];
+        if (pending_bytes >= options_.merge_flush_size)
+        {
+            submit_merge(line_number);
+            open_file(line_number);
+            pending_bytes = 0;
+        }
+    }
+
+    void RootFile::submit_merge(std::size_t line_number)
+    {
+        // The tree is owned by the memory file and is destroyed together with it after the merge.
+        auto task = std::packaged_task<void()>{ [merger_file = std::move(merger_files_[line_number])]()
+                                                { merger_file->Write(); } };
+        auto& pending_merges = pending_merges_[line_number];
+        pending_merges.push_back(task.get_future());
+        asio::post(*merge_thread_, std::move(task));
+
+        if (pending_merges.size() > common::ROOT_MAX_PENDING_MERGES)
+        {
+            spdlog::trace("Writer: waiting for {} pending merges of the line {}", pending_merges.size(), line_number);
+            pending_merges.front().get();
+            pending_merges.pop_front();
+        }
+    }
+
+    auto RootFile::close_merger() -> std::size_t
+    {
+        const auto filename = rotator_->get_filename(0);
+        merger_files_.clear();
+        // The remaining memory files are merged and the output file is closed by the destructor.
+        merger_.reset();
+        spdlog::info("Writer: Root file {:?} is Closed.", filename);
+        return static_cast<std::size_t>(std::filesystem::file_size(filename));
     }
 
     RootFile::~RootFile()
     {
-        for (auto [root_file, tree] : std::views::zip(root_files_, trees_))
+        if (merger_ != nullptr)
+        {
+            for (auto idx : std::views::iota(std::size_t{ 0 }, merger_files_.size()))
+            {
+                submit_merge(idx);
+            }
+            merge_thread_->join();
+            pending_merges_.clear();
+            rotator_->close(0, [this]() { return close_merger(); });
+        }
+        else
+        {
+            for (auto [idx, root_file, tree] :
+                 std::views::zip(std::views::iota(std::size_t{ 0 }), root_files_, trees_))
+            {
+                rotator_->close(idx, [&root_file, tree]() { return close_root_file(*root_file, *tree); });
+            }
+        }
+        rotator_->wait();
+        if (auto* report = get_report(); report != nullptr and rotator_->is_reported())
         {
-            root_file->WriteObject(tree, tree->GetName());
-            root_file->Close();
-            spdlog::info("Writer: Root file {:?} is Closed.", root_file->GetName());
+            report->register_file_rotation_result(base_filename_, rotator_->get_stats());
         }
     }
 } // namespace srs::sink
@@ -2,15 +2,22 @@
 
 #ifdef HAS_ROOT
 #include "DataWriterOptions.hpp"
+#include "FileRotator.hpp"
 #include "srs/converters/DataConvertOptions.hpp"
 #include "srs/data/SRSDataStructs.hpp"
 #include "srs/utils/CommonConcepts.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
 #include "srs/workflow/BaseTask.hpp"
+#include <ROOT/TBufferMerger.hxx>
 #include <TFile.h>
 #include <TSystem.h>
 #include <TTree.h>
+#include <asio/thread_pool.hpp>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <future>
 #include <memory>
 #include <spdlog/spdlog.h>
 #include <string>
@@ -18,20 +25,67 @@
 
 namespace srs::sink
 {
+    /**
+     * @brief Output of the struct data to a TTree in ROOT files (".root")
+     *
+     * The struct data is stored in the branch "srs_frame_data", which is split into one sub-branch per member, e.g.
+     * "hit_data.adc", with the default split level. The branch is bound to the output of the previous converter, whose
+     * data is serialized directly by TTree::Fill without any copy.
+     *
+     * If Options::is_merged is true, the trees of all lines are written to a single file with ROOT::TBufferMerger.
+     * Each line fills its tree in a memory file. Every Options::merge_flush_size bytes, the memory file is handed
+     * over to a merger thread, which merges it into the output file, and the line continues with a new memory file.
+     * If more than common::ROOT_MAX_PENDING_MERGES memory files of a line are waiting for the merger thread, the line
+     * is blocked. The rotation by size or time is disabled in this mode.
+     */
     class RootFile : public process::SinkTask<DataWriterOption::root, const StructData*, std::size_t>
     {
       public:
         static constexpr auto IsStructType = true;
 
-        RootFile(const std::string& filename, process::DataConvertOptions convert_mode, std::size_t n_lines);
+        struct Options
+        {
+            common::CompressionType compression = common::CompressionType::zstd; //!< of the baskets
+            int compression_level = 0;                          //!< 0 means the default level of the algorithm.
+            int basket_size = common::DEFAULT_ROOT_BASKET_SIZE; //!< Initial basket size of each branch in bytes
+            int split_level = common::DEFAULT_ROOT_SPLIT_LEVEL; //!< 0 stores the whole struct in a single branch.
+            int64_t cluster_size = 0; //!< Entries per cluster. 0 means the default of ROOT (about 30 MB of data).
+            bool is_merged = false;   //!< Merge the trees of all lines into a single file.
+            std::size_t merge_flush_size = common::ROOT_MERGE_FLUSH_SIZE; //!< Bytes filled by a line before a merge
+        };
+
+        /**
+         * @brief Constructor that opens the output file of each line.
+         *
+         * @param filename Name of the output file
+         * @param convert_mode Conversion of the input data
+         * @param n_lines Number of parallel pipelines
+         * @param options Compression and layout options of the tree
+         * @param rotation Rotation options
+         */
+        RootFile(const std::string& filename,
+                 process::DataConvertOptions convert_mode,
+                 std::size_t n_lines,
+                 const Options& options = {},
+                 const FileRotator::Options& rotation = {});
 
         auto run(const OutputTo<InputType> auto& prev_data_converter, std::size_t line_number) -> RunResult
         {
             assert(line_number < get_n_lines());
             const auto* input_data = prev_data_converter(line_number);
             assert(input_data != nullptr);
-            data_struct_buffers_[line_number] = *input_data;
+            // TTree only reads the data through the branch address.
+            data_struct_addresses_[line_number] = const_cast<StructData*>(input_data);
             output_data_[line_number] = static_cast<std::size_t>(trees_[line_number]->Fill());
+            if (merger_ != nullptr)
+            {
+                push_to_merger(line_number);
+            }
+            else if (rotator_->is_enabled() and
+                rotator_->is_due(line_number, static_cast<std::size_t>(root_files_[line_number]->GetBytesWritten())))
+            {
+                rotate(line_number);
+            }
             return output_data_[line_number];
         }
 
@@ -43,10 +97,25 @@ namespace srs::sink
 
       private:
         std::string base_filename_;
+        Options options_;
+        int compression_setting_ = 0;
         std::vector<std::unique_ptr<TFile>> root_files_;
+        std::unique_ptr<ROOT::TBufferMerger> merger_;
+        std::vector<std::shared_ptr<ROOT::TBufferMergerFile>> merger_files_;
+        std::vector<std::size_t> pending_bytes_; //!< Bytes filled since the last merge
+        std::vector<std::deque<std::future<void>>> pending_merges_;
+        std::unique_ptr<asio::thread_pool> merge_thread_;
         std::vector<TTree*> trees_;
-        std::vector<StructData> data_struct_buffers_;
+        StructData empty_data_; //!< Bound to the branches before the first frame
+        std::vector<StructData*> data_struct_addresses_;
         std::vector<OutputType> output_data_;
+        std::unique_ptr<FileRotator> rotator_;
+
+        void open_file(std::size_t line_number);
+        void rotate(std::size_t line_number);
+        void push_to_merger(std::size_t line_number);
+        void submit_merge(std::size_t line_number);
+        auto close_merger() -> std::size_t;
     };
 
 } // namespace srs::sink
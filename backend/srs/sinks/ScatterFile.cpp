@@ -0,0 +1,144 @@
+#include "ScatterFile.hpp"
+#include <array>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <fcntl.h>
+#include <fmt/format.h>
+#include <ranges>
+#include <span>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <sys/uio.h>
+#include <system_error>
+#include <unistd.h>
+
+namespace srs::sink
+{
+    ScatterFile::ScatterFile(const std::string& filename)
+        : filename_{ filename }
+    {
+        static constexpr auto FILE_PERMISSION = 0644;
+        // NOLINTNEXTLINE (cppcoreguidelines-pro-type-vararg)
+        file_descriptor_ = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, FILE_PERMISSION);
+        if (file_descriptor_ < 0)
+        {
+            throw std::runtime_error(fmt::format("Filename {:?} cannot be open: {}",
+                                                 filename,
+                                                 std::error_code{ errno, std::system_category() }.message()));
+        }
+        buffer_.reserve(BUFFER_SIZE);
+    }
+
+    ScatterFile::~ScatterFile() { close(); }
+
+    auto ScatterFile::write(std::span<const std::string_view> pieces) -> bool
+    {
+        assert(pieces.size() <= MAX_PIECES);
+        if (file_descriptor_ < 0)
+        {
+            return false;
+        }
+        auto size = std::size_t{};
+        for (const auto piece : pieces)
+        {
+            size += piece.size();
+        }
+        if (size < COALESCE_SIZE)
+        {
+            if (buffer_.size() + size > BUFFER_SIZE and not flush())
+            {
+                return false;
+            }
+            for (const auto piece : pieces)
+            {
+                buffer_.insert(buffer_.end(), piece.begin(), piece.end());
+            }
+            return true;
+        }
+
+        // The buffered data is written before the pieces in the same call.
+        auto buffers = std::array<iovec, MAX_PIECES + 1>{};
+        buffers.front() = iovec{ .iov_base = buffer_.data(), .iov_len = buffer_.size() };
+        for (auto [buffer, piece] : std::views::zip(buffers | std::views::drop(1), pieces))
+        {
+            // NOLINTNEXTLINE (cppcoreguidelines-pro-type-const-cast)
+            buffer = iovec{ .iov_base = const_cast<char*>(piece.data()), .iov_len = piece.size() };
+        }
+        auto used_buffers = std::span{ buffers }.first(pieces.size() + 1);
+        if (buffer_.empty())
+        {
+            used_buffers = used_buffers.subspan(1);
+        }
+        // The buffer is only cleared after its bytes are written.
+        const auto is_written = write_all(used_buffers);
+        buffer_.clear();
+        return is_written;
+    }
+
+    auto ScatterFile::flush() -> bool
+    {
+        if (buffer_.empty() or file_descriptor_ < 0)
+        {
+            return true;
+        }
+        auto buffers = std::array{ iovec{ .iov_base = buffer_.data(), .iov_len = buffer_.size() } };
+        const auto is_written = write_all(buffers);
+        buffer_.clear();
+        return is_written;
+    }
+
+    auto ScatterFile::write_all(std::span<iovec> buffers) -> bool
+    {
+        auto remaining = buffers;
+        while (not remaining.empty())
+        {
+            ++n_system_calls_;
+            const auto written_size = ::writev(file_descriptor_, remaining.data(), static_cast<int>(remaining.size()));
+            if (written_size < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                spdlog::error("Failed to write to the file {:?}: {}",
+                              filename_,
+                              std::error_code{ errno, std::system_category() }.message());
+                return false;
+            }
+
+            // Partially written pieces are continued in the next call.
+            auto written_bytes = static_cast<std::size_t>(written_size);
+            while (not remaining.empty() and written_bytes >= remaining.front().iov_len)
+            {
+                written_bytes -= remaining.front().iov_len;
+                remaining = remaining.subspan(1);
+            }
+            if (not remaining.empty())
+            {
+                auto& buffer = remaining.front();
+                buffer.iov_base = static_cast<char*>(buffer.iov_base) + written_bytes;
+                buffer.iov_len -= written_bytes;
+            }
+        }
+        return true;
+    }
+
+    void ScatterFile::close()
+    {
+        if (file_descriptor_ < 0)
+        {
+            return;
+        }
+        flush();
+        if (::close(file_descriptor_) != 0)
+        {
+            spdlog::error("Failed to close the file {:?}: {}",
+                          filename_,
+                          std::error_code{ errno, std::system_category() }.message());
+        }
+        file_descriptor_ = -1;
+    }
+} // namespace srs::sink
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct iovec;
+
+namespace srs::sink
+{
+    /**
+     * @brief Output file written with scatter-gather system calls
+     *
+     * Data pieces located in different memory regions are written to the file with a single call of writev, without
+     * being copied into any intermediate buffer in the user space. Writes smaller than COALESCE_SIZE are instead
+     * copied into a buffer of BUFFER_SIZE bytes, which is written at once when it's full, together with the next large
+     * write, or when the file is closed. Therefore, small frames cost much less than one system call each.
+     */
+    class ScatterFile
+    {
+      public:
+        static constexpr auto MAX_PIECES = std::size_t{ 8 };
+        static constexpr auto COALESCE_SIZE = std::size_t{ 4096 };
+        static constexpr auto BUFFER_SIZE = std::size_t{ 1 } << 16U;
+
+        //! Create or truncate the file. Throws if the file cannot be opened.
+        explicit ScatterFile(const std::string& filename);
+
+        ScatterFile(const ScatterFile&) = delete;
+        ScatterFile(ScatterFile&&) = delete;
+        ScatterFile& operator=(const ScatterFile&) = delete;
+        ScatterFile& operator=(ScatterFile&&) = delete;
+        ~ScatterFile();
+
+        /**
+         * @brief Append the pieces to the file in the given order.
+         *
+         * @param pieces Data pieces, at most MAX_PIECES
+         * @return false if an error occurs during the writing.
+         */
+        auto write(std::span<const std::string_view> pieces) -> bool;
+
+        //! Write the buffered data to the file
+        auto flush() -> bool;
+
+        void close();
+
+        //! Number of the writev calls so far
+        [[nodiscard]] auto get_n_system_calls() const -> std::size_t { return n_system_calls_; }
+
+      private:
+        std::string filename_;
+        int file_descriptor_ = -1;
+        std::vector<char> buffer_;
+        std::size_t n_system_calls_ = 0;
+
+        auto write_all(std::span<iovec> buffers) -> bool;
+    };
+} // namespace srs::sink
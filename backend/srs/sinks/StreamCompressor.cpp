@@ -0,0 +1,274 @@
+#include "StreamCompressor.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fmt/format.h>
+#include <google/protobuf/io/gzip_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl.h>
+#include <lz4frame.h>
+#include <memory>
+#include <ostream>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+#include <zdict.h>
+#include <zstd.h>
+
+namespace srs::sink
+{
+    namespace
+    {
+        constexpr auto GZIP_DEFAULT_LEVEL = -1; // Z_DEFAULT_COMPRESSION
+
+        auto encode_uint32_le(uint32_t value) -> std::array<char, sizeof(uint32_t)>
+        {
+            auto bytes = std::array<char, sizeof(uint32_t)>{};
+            for (auto& byte : bytes)
+            {
+                byte = static_cast<char>(value & 0xffU);
+                value >>= common::BYTE_BIT_LENGTH;
+            }
+            return bytes;
+        }
+    } // namespace
+
+    void StreamCompressor::ZstdContextDeleter::operator()(ZSTD_CCtx_s* context) const { ZSTD_freeCCtx(context); }
+
+    void StreamCompressor::Lz4ContextDeleter::operator()(LZ4F_cctx_s* context) const
+    {
+        LZ4F_freeCompressionContext(context);
+    }
+
+    StreamCompressor::StreamCompressor(const Options& options, std::ostream& output)
+        : options_{ options }
+        , output_{ &output }
+    {
+        using enum common::CompressionType;
+        switch (options_.type)
+        {
+            case gzip:
+            {
+                ostream_output_ = std::make_unique<google::protobuf::io::OstreamOutputStream>(output_);
+                auto gzip_options = google::protobuf::io::GzipOutputStream::Options{};
+                gzip_options.compression_level = (options_.level == 0) ? GZIP_DEFAULT_LEVEL : options_.level;
+                gzip_output_ =
+                    std::make_unique<google::protobuf::io::GzipOutputStream>(ostream_output_.get(), gzip_options);
+                break;
+            }
+            case zstd:
+            {
+                zstd_context_.reset(ZSTD_createCCtx());
+                if (zstd_context_ == nullptr)
+                {
+                    throw std::runtime_error{ "Cannot create the zstd compression context" };
+                }
+                ZSTD_CCtx_setParameter(zstd_context_.get(), ZSTD_c_compressionLevel, options_.level);
+                output_buffer_.resize(ZSTD_CStreamOutSize());
+                is_dict_pending_ = options_.dict_n_frames > 0;
+                break;
+            }
+            case lz4:
+            {
+                auto* context = static_cast<LZ4F_cctx*>(nullptr);
+                if (LZ4F_isError(LZ4F_createCompressionContext(&context, LZ4F_VERSION)) != 0U)
+                {
+                    throw std::runtime_error{ "Cannot create the lz4 compression context" };
+                }
+                lz4_context_.reset(context);
+                auto preferences = LZ4F_preferences_t{};
+                preferences.compressionLevel = options_.level;
+                output_buffer_.resize(std::max<std::size_t>(
+                    LZ4F_compressBound(common::COMPRESSION_BUFFER_SIZE, &preferences), LZ4F_HEADER_SIZE_MAX));
+                const auto header_size =
+                    LZ4F_compressBegin(lz4_context_.get(), output_buffer_.data(), output_buffer_.size(), &preferences);
+                if (LZ4F_isError(header_size) != 0U)
+                {
+                    throw std::runtime_error{ fmt::format("Cannot begin the lz4 frame: {}",
+                                                          LZ4F_getErrorName(header_size)) };
+                }
+                write_output(std::string_view{ output_buffer_.data(), header_size });
+                break;
+            }
+            case none:
+                break;
+        }
+    }
+
+    StreamCompressor::~StreamCompressor() { finish(); }
+
+    void StreamCompressor::write(std::string_view data)
+    {
+        if (is_finished_ or data.empty())
+        {
+            return;
+        }
+
+        using enum common::CompressionType;
+        switch (options_.type)
+        {
+            case gzip:
+                write_gzip(data);
+                break;
+            case zstd:
+                if (is_dict_pending_)
+                {
+                    dict_samples_.insert(dict_samples_.end(), data.begin(), data.end());
+                    dict_sample_sizes_.push_back(data.size());
+                    if (dict_sample_sizes_.size() >= options_.dict_n_frames)
+                    {
+                        train_zstd_dictionary();
+                    }
+                    return;
+                }
+                write_zstd(data, false);
+                break;
+            case lz4:
+                write_lz4(data);
+                break;
+            case none:
+                write_output(data);
+                break;
+        }
+    }
+
+    void StreamCompressor::finish()
+    {
+        if (is_finished_)
+        {
+            return;
+        }
+
+        using enum common::CompressionType;
+        switch (options_.type)
+        {
+            case gzip:
+            {
+                [[maybe_unused]] auto is_ok = gzip_output_->Close();
+                is_ok = ostream_output_->Flush();
+                output_bytes_ = static_cast<std::size_t>(ostream_output_->ByteCount());
+                break;
+            }
+            case zstd:
+                if (is_dict_pending_)
+                {
+                    train_zstd_dictionary();
+                }
+                write_zstd(std::string_view{}, true);
+                break;
+            case lz4:
+            {
+                const auto size =
+                    LZ4F_compressEnd(lz4_context_.get(), output_buffer_.data(), output_buffer_.size(), nullptr);
+                if (LZ4F_isError(size) != 0U)
+                {
+                    spdlog::error("Cannot end the lz4 frame: {}", LZ4F_getErrorName(size));
+                    break;
+                }
+                write_output(std::string_view{ output_buffer_.data(), size });
+                break;
+            }
+            case none:
+                break;
+        }
+        output_->flush();
+        is_finished_ = true;
+    }
+
+    void StreamCompressor::write_output(std::string_view data)
+    {
+        output_->write(data.data(), static_cast<std::streamsize>(data.size()));
+        output_bytes_ += data.size();
+    }
+
+    void StreamCompressor::write_gzip(std::string_view data)
+    {
+        auto* buffer = static_cast<void*>(nullptr);
+        auto buffer_size = 0;
+        while (not data.empty())
+        {
+            if (not gzip_output_->Next(&buffer, &buffer_size))
+            {
+                spdlog::error("Failed to write to the gzip output stream");
+                return;
+            }
+            const auto size = std::min(static_cast<std::size_t>(buffer_size), data.size());
+            std::memcpy(buffer, data.data(), size);
+            gzip_output_->BackUp(buffer_size - static_cast<int>(size));
+            data.remove_prefix(size);
+        }
+    }
+
+    void StreamCompressor::write_zstd(std::string_view data, bool is_end)
+    {
+        auto input = ZSTD_inBuffer{ .src = data.data(), .size = data.size(), .pos = 0 };
+        const auto mode = is_end ? ZSTD_e_end : ZSTD_e_continue;
+        while (true)
+        {
+            auto output = ZSTD_outBuffer{ .dst = output_buffer_.data(), .size = output_buffer_.size(), .pos = 0 };
+            const auto remaining = ZSTD_compressStream2(zstd_context_.get(), &output, &input, mode);
+            if (ZSTD_isError(remaining) != 0U)
+            {
+                spdlog::error("Failed to compress data with zstd: {}", ZSTD_getErrorName(remaining));
+                return;
+            }
+            write_output(std::string_view{ output_buffer_.data(), output.pos });
+            if (is_end ? remaining == 0 : input.pos == input.size)
+            {
+                return;
+            }
+        }
+    }
+
+    void StreamCompressor::write_lz4(std::string_view data)
+    {
+        while (not data.empty())
+        {
+            const auto input_size = std::min(data.size(), common::COMPRESSION_BUFFER_SIZE);
+            const auto size = LZ4F_compressUpdate(
+                lz4_context_.get(), output_buffer_.data(), output_buffer_.size(), data.data(), input_size, nullptr);
+            if (LZ4F_isError(size) != 0U)
+            {
+                spdlog::error("Failed to compress data with lz4: {}", LZ4F_getErrorName(size));
+                return;
+            }
+            write_output(std::string_view{ output_buffer_.data(), size });
+            data.remove_prefix(input_size);
+        }
+    }
+
+    void StreamCompressor::train_zstd_dictionary()
+    {
+        is_dict_pending_ = false;
+        auto dictionary = std::vector<char>(common::DEFAULT_COMPRESSION_DICTIONARY_SIZE);
+        const auto dict_size = ZDICT_trainFromBuffer(dictionary.data(),
+                                                     dictionary.size(),
+                                                     dict_samples_.data(),
+                                                     dict_sample_sizes_.data(),
+                                                     static_cast<unsigned>(dict_sample_sizes_.size()));
+        if (ZDICT_isError(dict_size) != 0U)
+        {
+            spdlog::warn("Failed to train the zstd dictionary from {} frames: {}. Compress without a dictionary.",
+                         dict_sample_sizes_.size(),
+                         ZDICT_getErrorName(dict_size));
+        }
+        else
+        {
+            spdlog::debug(
+                "Trained a zstd dictionary of {} bytes from {} frames.", dict_size, dict_sample_sizes_.size());
+            const auto magic = encode_uint32_le(ZSTD_MAGIC_SKIPPABLE_START);
+            const auto frame_size = encode_uint32_le(static_cast<uint32_t>(dict_size));
+            write_output(std::string_view{ magic.data(), magic.size() });
+            write_output(std::string_view{ frame_size.data(), frame_size.size() });
+            write_output(std::string_view{ dictionary.data(), dict_size });
+            ZSTD_CCtx_loadDictionary(zstd_context_.get(), dictionary.data(), dict_size);
+        }
+
+        write_zstd(std::string_view{ dict_samples_.data(), dict_samples_.size() }, false);
+        dict_samples_ = std::vector<char>{};
+        dict_sample_sizes_ = std::vector<std::size_t>{};
+    }
+} // namespace srs::sink
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "srs/utils/CommonDefinitions.hpp"
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+namespace google::protobuf::io
+{
+    class GzipOutputStream;
+    class OstreamOutputStream;
+} // namespace google::protobuf::io
+
+struct ZSTD_CCtx_s;
+struct LZ4F_cctx_s;
+
+namespace srs::sink
+{
+    /**
+     * @brief Long-lived compressor of an output stream
+     *
+     * Data written to the compressor are compressed as a single stream in gzip, zstd or lz4 frame format, such that
+     * the compression context and the history window are shared among all frames. The format of the compressed
+     * output can be identified by its magic number.
+     *
+     * If the zstd dictionary is enabled, the beginning frames are buffered and used to train the dictionary, which is
+     * written to the output in a zstd skippable frame before any compressed data.
+     */
+    class StreamCompressor
+    {
+      public:
+        struct Options
+        {
+            common::CompressionType type = common::CompressionType::none;
+            int level = 0;                 //!< 0 for the default level of the algorithm
+            std::size_t dict_n_frames = 0; //!< 0 to disable the zstd dictionary
+        };
+
+        StreamCompressor(const Options& options, std::ostream& output);
+        StreamCompressor(const StreamCompressor&) = delete;
+        StreamCompressor(StreamCompressor&&) = delete;
+        StreamCompressor& operator=(const StreamCompressor&) = delete;
+        StreamCompressor& operator=(StreamCompressor&&) = delete;
+        ~StreamCompressor();
+
+        void write(std::string_view data);
+
+        //! Flush all buffered data and end the stream. No data can be written afterwards.
+        void finish();
+
+        //! Total number of compressed bytes written to the output stream
+        [[nodiscard]] auto get_output_bytes() const -> std::size_t { return output_bytes_; }
+
+      private:
+        Options options_;
+        std::ostream* output_ = nullptr;
+        bool is_finished_ = false;
+        std::size_t output_bytes_ = 0;
+        std::vector<char> output_buffer_;
+
+        // gzip:
+        std::unique_ptr<google::protobuf::io::OstreamOutputStream> ostream_output_;
+        std::unique_ptr<google::protobuf::io::GzipOutputStream> gzip_output_;
+
+        // zstd:
+        struct ZstdContextDeleter
+        {
+            void operator()(ZSTD_CCtx_s* context) const;
+        };
+        std::unique_ptr<ZSTD_CCtx_s, ZstdContextDeleter> zstd_context_;
+        bool is_dict_pending_ = false;
+        std::vector<char> dict_samples_;
+        std::vector<std::size_t> dict_sample_sizes_;
+
+        // lz4:
+        struct Lz4ContextDeleter
+        {
+            void operator()(LZ4F_cctx_s* context) const;
+        };
+        std::unique_ptr<LZ4F_cctx_s, Lz4ContextDeleter> lz4_context_;
+
+        void write_output(std::string_view data);
+        void write_gzip(std::string_view data);
+        void write_zstd(std::string_view data, bool is_end);
+        void write_lz4(std::string_view data);
+        void train_zstd_dictionary();
+    };
+} // namespace srs::sink
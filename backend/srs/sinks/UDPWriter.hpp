@@ -90,7 +90,8 @@ namespace srs::sink
 
         [[nodiscard]] auto is_deserialize_valid() const
         {
-            return get_required_conversion() == raw or get_required_conversion() == proto;
+            return get_required_conversion() == raw or get_required_conversion() == proto or
+                   get_required_conversion() == packed_proto or get_required_conversion() == flat;
         }
         [[nodiscard]] auto operator()(std::size_t line_number = 0) const -> OutputType
         {
@@ -1,11 +1,18 @@
 #pragma once
 
-#include "srs/data/SRSDataStructs.hpp"    // IWYU pragma: export
-#include "srs/readers/ProtoMsgReader.hpp" // IWYU pragma: export
-#include "srs/readers/RawFrameReader.hpp" // IWYU pragma: export
+#include "srs/data/SRSDataStructs.hpp"      // IWYU pragma: export
+#include "srs/readers/CompactFileReader.hpp" // IWYU pragma: export
+#include "srs/readers/FlatMsgReader.hpp"     // IWYU pragma: export
+#include "srs/readers/FrameIndex.hpp"        // IWYU pragma: export
+#include "srs/readers/ProtoFrameReader.hpp"  // IWYU pragma: export
+#include "srs/readers/ProtoMsgReader.hpp"    // IWYU pragma: export
+#include "srs/readers/RawFrameReader.hpp"    // IWYU pragma: export
 
 namespace srs
 {
+    using CompactFileReader = reader::CompactFile;
+    using FlatMsgReader = reader::FlatMsg;
+    using ProtoFrameReader = reader::ProtoFrame;
     using ProtoMsgReader = reader::ProtoMsg;
     using RawFrameReader = reader::RawFrame;
 } // namespace srs
@@ -221,6 +221,193 @@ namespace srs
         spdlog::debug("Buffer Queue report:\n{}", str);
     }
 
+    void AppReport::report_arena_result()
+    {
+        auto str = format_records(arena_records_,
+                                  {
+                                      "Task name",
+                                      "Split",
+                                      "Frames",
+                                      "Messages (/frame)",
+                                      "Heap allocations (/frame)",
+                                      "Max arena usage (KB)",
+                                  },
+                                  [](Row& row, int idx, const ArenaStat& stat)
+                                  {
+                                      const auto n_frames = stat.n_frames == 0
+                                                                ? std::numeric_limits<double>::quiet_NaN()
+                                                                : static_cast<double>(stat.n_frames);
+                                      row.push_back(std::format("{}", idx));
+                                      row.push_back(std::format("{}", stat.n_frames));
+                                      row.push_back(
+                                          std::format("{:.1f}", static_cast<double>(stat.n_messages) / n_frames));
+                                      row.push_back(
+                                          std::format("{:.3f}", static_cast<double>(stat.n_heap_blocks) / n_frames));
+                                      row.push_back(
+                                          std::format("{:.1f}", static_cast<double>(stat.max_bytes_used) / 1000.));
+                                  });
+        spdlog::debug("Memory allocations of arenas:\n{}", str);
+    }
+
+    void AppReport::report_decode_error_result()
+    {
+        auto str = format_records(decode_error_records_,
+                                  {
+                                      "Task name",
+                                      "Split",
+                                      "Short frame",
+                                      "Bad VMM tag",
+                                      "Trailing bytes",
+                                      "Invalid value",
+                                      "Quarantined",
+                                  },
+                                  [](Row& row, int idx, const DecodeErrorStat& stat)
+                                  {
+                                      row.push_back(std::format("{}", idx));
+                                      row.push_back(std::format("{}", stat.n_short_frame));
+                                      row.push_back(std::format("{}", stat.n_bad_vmm_tag));
+                                      row.push_back(std::format("{}", stat.n_trailing_bytes));
+                                      row.push_back(std::format("{}", stat.n_invalid_value));
+                                      row.push_back(std::format("{}", stat.n_quarantined));
+                                  });
+        spdlog::debug("Frames failed to be decoded:\n{}", str);
+    }
+
+    void AppReport::report_zero_suppression_result()
+    {
+        auto str = format_records(zero_suppression_records_,
+                                  {
+                                      "Task name",
+                                      "Split",
+                                      "Input hits",
+                                      "Suppressed hits",
+                                      "Suppression ratio (%)",
+                                  },
+                                  [](Row& row, int idx, const ZeroSuppressionStat& stat)
+                                  {
+                                      const auto n_input_hits = stat.n_input_hits == 0
+                                                                    ? std::numeric_limits<double>::quiet_NaN()
+                                                                    : static_cast<double>(stat.n_input_hits);
+                                      row.push_back(std::format("{}", idx));
+                                      row.push_back(std::format("{}", stat.n_input_hits));
+                                      row.push_back(std::format("{}", stat.n_suppressed_hits));
+                                      row.push_back(std::format(
+                                          "{:.2f}", static_cast<double>(stat.n_suppressed_hits) / n_input_hits * 100.));
+                                  });
+        spdlog::debug("Zero suppression of hits:\n{}", str);
+    }
+
+    void AppReport::report_trigger_result()
+    {
+        auto str = format_records(trigger_records_,
+                                  {
+                                      "Task name",
+                                      "Split",
+                                      "Accepted frames",
+                                      "Rejected frames",
+                                      "Acceptance ratio (%)",
+                                  },
+                                  [](Row& row, int idx, const TriggerStat& stat)
+                                  {
+                                      const auto n_frames = stat.n_accepted_frames + stat.n_rejected_frames;
+                                      const auto n_input_frames = n_frames == 0
+                                                                      ? std::numeric_limits<double>::quiet_NaN()
+                                                                      : static_cast<double>(n_frames);
+                                      row.push_back(std::format("{}", idx));
+                                      row.push_back(std::format("{}", stat.n_accepted_frames));
+                                      row.push_back(std::format("{}", stat.n_rejected_frames));
+                                      row.push_back(std::format(
+                                          "{:.2f}",
+                                          static_cast<double>(stat.n_accepted_frames) / n_input_frames * 100.));
+                                  });
+        spdlog::debug("Software trigger of frames:\n{}", str);
+    }
+
+    void AppReport::report_filter_result()
+    {
+        auto str = format_records(filter_records_,
+                                  {
+                                      "Task name",
+                                      "Split",
+                                      "Input frames",
+                                      "Frame pass ratio (%)",
+                                      "Input hits",
+                                      "Hit pass ratio (%)",
+                                  },
+                                  [](Row& row, int idx, const FilterStat& stat)
+                                  {
+                                      auto get_ratio = [](std::size_t n_passed, std::size_t n_input) -> double
+                                      {
+                                          return n_input == 0 ? std::numeric_limits<double>::quiet_NaN()
+                                                              : static_cast<double>(n_passed) /
+                                                                    static_cast<double>(n_input) * 100.;
+                                      };
+                                      row.push_back(std::format("{}", idx));
+                                      row.push_back(std::format("{}", stat.n_input_frames));
+                                      row.push_back(
+                                          std::format("{:.2f}", get_ratio(stat.n_passed_frames, stat.n_input_frames)));
+                                      row.push_back(std::format("{}", stat.n_input_hits));
+                                      row.push_back(
+                                          std::format("{:.2f}", get_ratio(stat.n_passed_hits, stat.n_input_hits)));
+                                  });
+        spdlog::debug("Output filters:\n{}", str);
+    }
+
+    void AppReport::report_direct_io_result()
+    {
+        auto str = format_records(direct_io_records_,
+                                  {
+                                      "File name",
+                                      "Split",
+                                      "Data (MB)",
+                                      "Throughput (MB/s)",
+                                      "Avg. queue depth",
+                                      "Max queue depth",
+                                      "Stalls",
+                                  },
+                                  [](Row& row, int idx, const DirectIOStat& stat)
+                                  {
+                                      const auto n_buffers = stat.n_buffers == 0
+                                                                 ? std::numeric_limits<double>::quiet_NaN()
+                                                                 : static_cast<double>(stat.n_buffers);
+                                      const auto data_mb = static_cast<double>(stat.n_bytes) / 1e6;
+                                      row.push_back(std::format("{}", idx));
+                                      row.push_back(std::format("{:.1f}", data_mb));
+                                      row.push_back(std::format("{:.1f}", data_mb / stat.total_write_time_ms * 1e3));
+                                      row.push_back(std::format(
+                                          "{:.2f}", static_cast<double>(stat.total_queue_depth) / n_buffers));
+                                      row.push_back(std::format("{}", stat.max_queue_depth));
+                                      row.push_back(std::format("{}", stat.n_stalls));
+                                  });
+        spdlog::debug("Direct I/O of binary files:\n{}", str);
+    }
+
+    void AppReport::report_file_rotation_result()
+    {
+        auto str = format_records(file_rotation_records_,
+                                  {
+                                      "Sink name",
+                                      "Split",
+                                      "Files",
+                                      "Size rotations",
+                                      "Time rotations",
+                                      "Data (MB)",
+                                      "Max close time (ms)",
+                                      "Failed commands",
+                                  },
+                                  [](Row& row, int idx, const FileRotationStat& stat)
+                                  {
+                                      row.push_back(std::format("{}", idx));
+                                      row.push_back(std::format("{}", stat.n_files));
+                                      row.push_back(std::format("{}", stat.n_size_rotations));
+                                      row.push_back(std::format("{}", stat.n_time_rotations));
+                                      row.push_back(std::format("{:.1f}", static_cast<double>(stat.n_bytes) / 1e6));
+                                      row.push_back(std::format("{:.1f}", stat.max_close_time_ms));
+                                      row.push_back(std::format("{}", stat.n_failed_commands));
+                                  });
+        spdlog::debug("File rotations of output sinks:\n{}", str);
+    }
+
     AppReport::~AppReport()
     {
         report_task_result();
@@ -228,5 +415,12 @@ namespace srs
         report_socket_result();
         report_frame_reading_result();
         report_buffer_result();
+        report_arena_result();
+        report_decode_error_result();
+        report_zero_suppression_result();
+        report_trigger_result();
+        report_filter_result();
+        report_direct_io_result();
+        report_file_rotation_result();
     }
 } // namespace srs
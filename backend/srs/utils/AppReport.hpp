@@ -44,6 +44,63 @@ namespace srs
             std::size_t full_valid{};
         };
 
+        struct ArenaStat
+        {
+            std::size_t n_frames{};
+            std::size_t n_messages{};    //!< Messages which would be allocated individually without an arena.
+            std::size_t n_heap_blocks{}; //!< Memory blocks the arena requested from the heap.
+            std::size_t max_bytes_used{};
+        };
+
+        struct DecodeErrorStat
+        {
+            std::size_t n_short_frame{};
+            std::size_t n_bad_vmm_tag{};
+            std::size_t n_trailing_bytes{};
+            std::size_t n_invalid_value{};
+            std::size_t n_quarantined{}; //!< Bad frames copied to the quarantine file
+        };
+
+        struct ZeroSuppressionStat
+        {
+            std::size_t n_input_hits{};
+            std::size_t n_suppressed_hits{};
+        };
+
+        struct TriggerStat
+        {
+            std::size_t n_accepted_frames{};
+            std::size_t n_rejected_frames{};
+        };
+
+        struct FilterStat
+        {
+            std::size_t n_input_frames{};
+            std::size_t n_passed_frames{};
+            std::size_t n_input_hits{};
+            std::size_t n_passed_hits{};
+        };
+
+        struct DirectIOStat
+        {
+            std::size_t n_bytes{};
+            std::size_t n_buffers{};         //!< Buffers written to the file
+            double total_write_time_ms{};    //!< Time of the background thread spent in the system calls
+            std::size_t total_queue_depth{}; //!< Sum of the queue depths when the buffers are submitted
+            std::size_t max_queue_depth{};
+            std::size_t n_stalls{}; //!< Submissions waiting for a free buffer
+        };
+
+        struct FileRotationStat
+        {
+            std::size_t n_files{}; //!< Files closed
+            std::size_t n_size_rotations{};
+            std::size_t n_time_rotations{};
+            std::size_t n_bytes{}; //!< Total size of the closed files
+            double max_close_time_ms{};
+            std::size_t n_failed_commands{}; //!< Post-close commands exited with errors
+        };
+
         void register_switch_socket_result(std::string socket_name,
                                            std::vector<std::pair<std::string, FecSwitchStat>> socket_times)
         {
@@ -65,6 +122,41 @@ namespace srs
             sink_records_.try_emplace(std::string{ sink_name }, bytes_written);
         }
 
+        void register_arena_result(std::string_view name, const std::vector<ArenaStat>& stats)
+        {
+            arena_records_.try_emplace(std::string{ name }, stats);
+        }
+
+        void register_decode_error_result(std::string_view name, const std::vector<DecodeErrorStat>& stats)
+        {
+            decode_error_records_.try_emplace(std::string{ name }, stats);
+        }
+
+        void register_zero_suppression_result(std::string_view name, const std::vector<ZeroSuppressionStat>& stats)
+        {
+            zero_suppression_records_.try_emplace(std::string{ name }, stats);
+        }
+
+        void register_trigger_result(std::string_view name, const std::vector<TriggerStat>& stats)
+        {
+            trigger_records_.try_emplace(std::string{ name }, stats);
+        }
+
+        void register_filter_result(std::string_view name, const std::vector<FilterStat>& stats)
+        {
+            filter_records_.try_emplace(std::string{ name }, stats);
+        }
+
+        void register_direct_io_result(std::string_view name, const std::vector<DirectIOStat>& stats)
+        {
+            direct_io_records_.try_emplace(std::string{ name }, stats);
+        }
+
+        void register_file_rotation_result(std::string_view name, const std::vector<FileRotationStat>& stats)
+        {
+            file_rotation_records_.try_emplace(std::string{ name }, stats);
+        }
+
         void register_queue_result(const QueueStat& stat) { queue_record_.second = stat; }
 
         ~AppReport();
@@ -74,12 +166,28 @@ namespace srs
         std::map<std::string, std::vector<std::size_t>> sink_records_;
         std::vector<std::pair<std::string, std::vector<std::pair<std::string, FecSwitchStat>>>> switch_socket_records_;
         std::vector<std::pair<std::string, FrameReadingStat>> frame_reading_records_;
+        std::map<std::string, std::vector<ArenaStat>> arena_records_;
+        std::map<std::string, std::vector<DecodeErrorStat>> decode_error_records_;
+        std::map<std::string, std::vector<ZeroSuppressionStat>> zero_suppression_records_;
+        std::map<std::string, std::vector<TriggerStat>> trigger_records_;
+        std::map<std::string, std::vector<FilterStat>> filter_records_;
+        std::map<std::string, std::vector<DirectIOStat>> direct_io_records_;
+        std::map<std::string, std::vector<FileRotationStat>> file_rotation_records_;
         std::pair<std::string_view, QueueStat> queue_record_{ std::string_view{ "Counts" }, {} };
 
         void report_task_result();
         void report_sink_file_result();
         void report_socket_result();
         void report_buffer_result();
+        void report_arena_result();
+        void report_decode_error_result();
+        void report_zero_suppression_result();
+
+        void report_trigger_result();
+
+        void report_filter_result();
+        void report_direct_io_result();
+        void report_file_rotation_result();
 
         void report_frame_reading_result();
     };
@@ -3,6 +3,7 @@
 #include "srs/utils/CommonAlias.hpp" // IWYU pragma: keep
 #include <asio/any_io_executor.hpp>
 #include <concepts>
+#include <cstddef>
 #include <fstream>
 #include <iterator>
 #include <map>
@@ -49,6 +50,15 @@ namespace srs
     template <typename T>
     concept SinkType = requires { T::writer_type; };
 
+    template <typename T>
+    concept FrameFilterType = requires { requires T::IsFrameFilter; };
+
+    template <typename T>
+    concept FrameHeaderProvider = requires(const T& provider) { provider.get_frame_header(std::size_t{}); };
+
+    template <typename T>
+    concept SizePrefixProvider = requires(const T& provider) { provider.get_size_prefix(std::size_t{}); };
+
     template <typename T>
     struct is_optional_type : std::false_type
     {
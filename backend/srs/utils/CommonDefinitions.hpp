@@ -1,6 +1,8 @@
 #pragma once
 
+#include <array>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <string_view>
 #include <vector>
@@ -47,9 +49,35 @@ namespace srs::common
     constexpr auto SRS_TIMESTAMP_HIGH_BIT_LENGTH = 32U;
     constexpr auto SRS_TIMESTAMP_LOW_BIT_LENGTH = 10U;
     constexpr auto FLAG_BIT_POSITION = 15; // zero based
-    constexpr auto GZIP_DEFAULT_COMPRESSION_LEVEL = 9;
-    constexpr auto PROTOBUF_ENABLE_GZIP = true;
+    constexpr auto VMM_TAG = std::array{ 'V', 'M', '3' };
+    constexpr auto BC_ID_PERIOD = uint64_t{ 4096 }; //!< BC clock cycles between two markers, unit of the hit offset
+    constexpr auto DEFAULT_BC_CLOCK_PERIOD_PS = uint64_t{ 25'000 }; //!< 40 MHz
+    constexpr auto DEFAULT_EVENT_SLICE_PS = uint64_t{ 1'000'000'000 }; //!< 1 ms
+    constexpr auto DEFAULT_EVENT_MAX_PENDING_HITS = std::size_t{ 1'000'000 };
+    constexpr auto DEFAULT_EVENT_MAX_HIT_SPREAD_PS = uint64_t{ 1'000'000'000'000 }; //!< 1 s
+    constexpr auto PEDESTAL_WARM_UP_SAMPLES = uint32_t{ 100 }; //!< hits of a channel before its zero suppression starts
+    constexpr auto UNMAPPED_PLANE_ID = uint8_t{ 0xff };  //!< plane ID of the hits missing in the channel mapping
+    constexpr auto UNMAPPED_STRIP_ID = uint16_t{ 0xffff }; //!< strip ID of the hits missing in the channel mapping
+    constexpr auto DEFAULT_CLUSTER_MAX_STRIP_GAP = uint16_t{ 1 }; //!< only adjacent strips are clustered
+    constexpr auto DEFAULT_COMPRESSION_DICTIONARY_SIZE = std::size_t{ 112640 }; //!< same as "zstd --train"
+    constexpr auto COMPRESSION_BUFFER_SIZE = std::size_t{ 1 } << 17U;
+    constexpr auto JSON_FLUSH_SIZE = std::size_t{ 1 } << 20U; //!< bytes buffered before written to a JSON file
+    constexpr auto RAW_BLOCK_SKIPPABLE_MAGIC = uint32_t{ 0x184D2A51 }; //!< zstd skippable frame of a raw block header
+    constexpr auto RAW_BLOCK_METADATA_SIZE = uint32_t{ 16 }; //!< first frame index, number of frames, compressed size
+    constexpr auto RAW_BLOCK_MAX_PENDING_PER_THREAD = std::size_t{ 2 };
+    constexpr auto POST_CLOSE_COMMAND_THREADS = std::size_t{ 4 }; //!< post-close commands running at the same time
+    constexpr auto DEFAULT_ARROW_BATCH_SIZE = std::size_t{ 1'000 };         //!< frames per Arrow record batch
+    constexpr auto DEFAULT_PARQUET_ROW_GROUP_SIZE = std::size_t{ 100'000 }; //!< frames per Parquet row group
+    constexpr auto DEFAULT_COMPACT_BLOCK_FRAMES = std::size_t{ 1'024 };     //!< frames per block of the compact output
+    constexpr auto DEFAULT_ROOT_BASKET_SIZE = 32'000; //!< bytes, same as the default of TTree::Branch
+    constexpr auto DEFAULT_ROOT_SPLIT_LEVEL = 99;     //!< one branch per member
+    constexpr auto ROOT_MERGE_FLUSH_SIZE = std::size_t{ 64 } << 20U; //!< bytes filled by a line before being merged
+    constexpr auto ROOT_MAX_PENDING_MERGES = std::size_t{ 2 }; //!< memory files of a line waiting to be merged
+    constexpr auto PACKED_PROTOBUF_VERSION = 1U;
+    constexpr auto PROTOBUF_ARENA_INITIAL_BLOCK_SIZE = std::size_t{ 256 } * 1024; //!< per pipeline, in bytes
+    constexpr auto FRAME_ARENA_INITIAL_BLOCK_SIZE = std::size_t{ 128 } * 1024; //!< per pipeline, in bytes
     constexpr auto DEFAULT_DATA_QUEUE_SIZE = 100;
+    constexpr auto DEFAULT_QUARANTINE_MAX_BYTES = std::size_t{ 100'000'000 }; //!< 100 MB
 
     // Default filenames
     constexpr auto DEFAULT_LOG_FILE = std::string_view{ "srs-control/srs-control.log" };
@@ -75,6 +103,30 @@ namespace srs::common
         print_all     //!< Print everything
     };
 
+    /**
+     * @enum CompressionType
+     * @brief Compression algorithm of the output streams
+     */
+    enum class CompressionType : uint8_t
+    {
+        none, //!< No compression
+        gzip, //!< Gzip (deflate) compression
+        zstd, //!< Zstandard compression, optionally with a trained dictionary
+        lz4   //!< LZ4 frame compression
+    };
+
+    /**
+     * @enum DecodeError
+     * @brief Failure classes of the decoding from the raw UDP frames
+     */
+    enum class DecodeError : uint8_t
+    {
+        short_frame,    //!< Frame is shorter than a header plus one data element
+        bad_vmm_tag,    //!< VMM tag in the header is not "VM3"
+        trailing_bytes, //!< Frame body is not a whole multiple of the data element size
+        invalid_value   //!< Data element with impossible field values, such as all bits being zero
+    };
+
     enum class ActionMode : uint8_t
     {
         all,
@@ -9,8 +9,13 @@
 #include <asio/redirect_error.hpp>
 #include <asio/use_awaitable.hpp>
 #include <chrono>
+#include <cstdint>
 #include <fmt/color.h>
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <magic_enum/magic_enum.hpp>
 #include <memory>
+#include <ranges>
 #include <spdlog/common.h>
 #include <spdlog/pattern_formatter.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
@@ -18,6 +23,7 @@
 #include <string>
 #include <system_error>
 #include <utility>
+#include <vector>
 
 namespace srs::workflow
 {
@@ -90,9 +96,52 @@ namespace srs::workflow
                            write_speed_string_,
                            drop_speed_string_,
                            unit_string_);
+            check_decode_errors();
+            check_trigger_rates(time_duration_us);
         }
     }
 
+    void DataMonitor::check_decode_errors()
+    {
+        const auto decode_error_counts = analysis_handle_->get_data_workflow().get_decode_error_counts();
+        auto n_new_errors = uint64_t{};
+        auto error_strings = std::vector<std::string>{};
+        const auto& error_names = magic_enum::enum_names<common::DecodeError>();
+        for (const auto [name, count, last_count] :
+             std::views::zip(error_names, decode_error_counts, last_decode_error_counts_))
+        {
+            if (count > last_count)
+            {
+                n_new_errors += count - last_count;
+                error_strings.push_back(fmt::format("{}: {}", name, count - last_count));
+            }
+        }
+        last_decode_error_counts_ = decode_error_counts;
+        if (n_new_errors > 0)
+        {
+            console_->warn("{} bad frames are rejected ({})", n_new_errors, fmt::join(error_strings, ", "));
+        }
+    }
+
+    void DataMonitor::check_trigger_rates(double time_duration_us)
+    {
+        const auto& task_workflow = analysis_handle_->get_data_workflow();
+        if (not task_workflow.is_trigger_enabled())
+        {
+            return;
+        }
+        const auto trigger_stat = task_workflow.get_trigger_stat();
+        const auto n_accepted = trigger_stat.n_accepted_frames - last_trigger_stat_.n_accepted_frames;
+        const auto n_rejected = trigger_stat.n_rejected_frames - last_trigger_stat_.n_rejected_frames;
+        last_trigger_stat_ = trigger_stat;
+        const auto n_frames = n_accepted + n_rejected;
+        const auto acceptance = (n_frames == 0) ? 0. : static_cast<double>(n_accepted) / static_cast<double>(n_frames);
+        console_->info("trigger accept|reject rate: {:.1f} | {:.1f} frames/s ({:.1f}% accepted)",
+                       static_cast<double>(n_accepted) / time_duration_us * 1e6,
+                       static_cast<double>(n_rejected) / time_duration_us * 1e6,
+                       acceptance * 100.);
+    }
+
     void DataMonitor::set_speed_string()
     {
         const auto read_speed_MBps = current_received_bytes_MBps_;
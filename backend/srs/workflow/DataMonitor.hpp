@@ -1,13 +1,16 @@
 #pragma once
 
+#include "srs/utils/AppReport.hpp"
 #include "srs/utils/CommonAlias.hpp"
 #include "srs/utils/CommonDefinitions.hpp"
 #include <asio/awaitable.hpp>
 #include <asio/steady_timer.hpp>
 #include <atomic>
+#include <array>
 #include <chrono>
 #include <cstdint>
 #include <gsl/gsl-lite.hpp>
+#include <magic_enum/magic_enum.hpp>
 #include <memory>
 #include <spdlog/logger.h>
 #include <string>
@@ -50,6 +53,8 @@ namespace srs::workflow
         uint64_t last_drop_data_bytes_ = 0;
         uint64_t last_processed_hit_num_ = 0;
         uint64_t last_frame_counts_ = 0;
+        std::array<uint64_t, magic_enum::enum_count<common::DecodeError>()> last_decode_error_counts_{};
+        AppReport::TriggerStat last_trigger_stat_{};
         double current_received_bytes_MBps_ = 0.;
         double current_write_bytes_MBps_ = 0.;
         double current_drop_bytes_MBps_ = 0.;
@@ -60,6 +65,8 @@ namespace srs::workflow
         std::string unit_string_;
 
         void set_speed_string();
+        void check_decode_errors();
+        void check_trigger_rates(double time_duration_us);
         auto print_cycle() -> asio::awaitable<void>;
     };
 } // namespace srs::workflow
@@ -1,10 +1,12 @@
 #include "srs/workflow/TaskDiagram.hpp"
 #include "srs/converters/DataConvertOptions.hpp"
 #include "srs/data/BufferQueue.hpp"
+#include "srs/devices/Configuration.hpp"
 #include "srs/utils/CommonConcepts.hpp"
 #include "srs/utils/ExitLogger.hpp"
 #include "srs/workflow/AnalysisHandle.hpp"
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <cassert>
 #include <chrono>
@@ -15,6 +17,7 @@
 #include <optional>
 #include <ranges>
 #include <spdlog/spdlog.h>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <taskflow/algorithm/pipeline.hpp>
@@ -27,6 +30,39 @@
 
 namespace srs::workflow
 {
+    namespace
+    {
+        auto create_trigger_options(const Config& config) -> process::CoincidenceTrigger::Options
+        {
+            auto options = process::CoincidenceTrigger::Options{ .rules = {},
+                                                                 .is_event_triggered = config.event_window_ps > 0 };
+            if (config.trigger_rules.empty())
+            {
+                return options;
+            }
+            if (config.channel_mapping_filename.empty())
+            {
+                spdlog::warn("Software trigger is disabled because no channel mapping is provided.");
+                return options;
+            }
+            for (const auto& [planes, window_ps] : config.trigger_rules)
+            {
+                if (planes.empty() or
+                    std::ranges::any_of(planes, [](uint16_t plane) { return plane >= common::UNMAPPED_PLANE_ID; }))
+                {
+                    throw std::runtime_error{ fmt::format(
+                        "Invalid detector planes [{}] of the software trigger rule", fmt::join(planes, ", ")) };
+                }
+                auto& rule = options.rules.emplace_back();
+                rule.window_ps = window_ps;
+                rule.planes = planes |
+                              std::views::transform([](uint16_t plane) { return static_cast<uint8_t>(plane); }) |
+                              std::ranges::to<std::vector>();
+            }
+            return options;
+        }
+    } // namespace
+
     TaskDiagram::TaskDiagram(AnalysisHandle& handle, std::size_t n_lines)
         : n_lines_{ n_lines }
         , is_pipeline_stopped_{ std::vector<std::atomic<bool>>(n_lines_) }
@@ -41,6 +77,7 @@ namespace srs::workflow
             consumer_tokens_.push_back(handle.get_queue_consumer_token());
             raw_data_.emplace_back(buffer_size);
         }
+        frame_headers_.resize(n_lines_);
 
         for (auto& is_pipe_stopped : is_pipeline_stopped_)
         {
@@ -49,6 +86,57 @@ namespace srs::workflow
 
         stats_.resize(n_lines);
         last_times_.resize(n_lines);
+
+        // Created in advance such that the decoding errors can be polled by the data monitor at any time.
+        struct_deserializer_converter_.emplace(n_lines_);
+        const auto& config = handle.get_app().get_config();
+        // The software trigger on the hits of a frame needs the hits after the struct processor.
+        const auto is_hit_dropped = config.cluster_only_output and
+                                    (config.trigger_rules.empty() or config.event_window_ps > 0);
+        if (config.cluster_only_output and not is_hit_dropped)
+        {
+            spdlog::warn("Hits are kept in the outputs because the software trigger is applied to the hits.");
+        }
+        struct_processor_converter_.emplace(
+            n_lines_,
+            process::StructProcessor::Options{ .is_hit_time_enabled = config.hit_time_reconstruction or
+                                                                      not config.trigger_rules.empty(),
+                                               .bc_clock_period_ps = config.bc_clock_period_ps,
+                                               .channel_mapping_filename = config.channel_mapping_filename,
+                                               .zero_suppression = {
+                                                   .n_sigma = config.zero_suppression_sigma,
+                                                   .pedestal_filename = config.pedestal_filename,
+                                                   .is_pedestal_subtracted = config.pedestal_subtraction,
+                                               },
+                                               .clustering = {
+                                                   .time_window_ps = config.cluster_time_window_ps,
+                                                   .max_strip_gap = config.cluster_max_strip_gap,
+                                                   .is_hit_dropped = is_hit_dropped,
+                                               },
+                                               .event_building = {
+                                                   .window_ps = config.event_window_ps,
+                                                   .slice_ps = config.event_slice_ps,
+                                                   .max_pending_hits = config.event_max_pending_hits,
+                                                   .max_hit_spread_ps = config.event_max_hit_spread_ps,
+                                               } });
+        trigger_converter_.emplace(n_lines_, create_trigger_options(config));
+        for (const auto& [output_name, expression] : config.output_filters)
+        {
+            filtered_outputs_[output_name].filter.emplace(n_lines_, output_name, expression);
+        }
+        is_raw_output_triggered_ = config.trigger_raw_output and trigger_converter_->is_enabled();
+        if (is_raw_output_triggered_ and config.event_window_ps > 0)
+        {
+            // Decisions on the events of a frame say nothing about its own raw data.
+            spdlog::warn("Raw data outputs are not triggered because the software trigger is applied to the events.");
+            is_raw_output_triggered_ = false;
+        }
+        if (not config.quarantine_filename.empty())
+        {
+            quarantine_file_ =
+                std::make_unique<sink::QuarantineFile>(config.quarantine_filename, config.quarantine_max_bytes);
+            struct_deserializer_converter_->set_quarantine(quarantine_file_.get());
+        }
     }
 
     // blocking here with pop
@@ -59,6 +147,7 @@ namespace srs::workflow
         if (not raw_data_[line_number].is_empty())
         {
             total_read_data_bytes_ += raw_data_[line_number].get_size();
+            frame_headers_[line_number] = process::parse_frame_header(raw_data_[line_number].data());
             return true;
         }
         return false;
@@ -118,9 +207,42 @@ namespace srs::workflow
         auto pipeline_task = main_taskflow_.composed_of(main_pipeline).name("Main pipeline");
         starting_task.precede(pipeline_task);
         tf_executor_.run(main_taskflow_).wait();
+        flush_events();
         is_done_.store(true);
     }
 
+    // All pipelines have stopped. The last events are written to the struct outputs with the first pipeline.
+    void TaskDiagram::flush_events()
+    {
+        if (not struct_processor_converter_->flush_events(0))
+        {
+            return;
+        }
+        if (not trigger_converter_->run_once(*struct_processor_converter_, 0).has_value())
+        {
+            return;
+        }
+        spdlog::debug("Events pending at the end of the run are written to the struct outputs.");
+        sinks_->do_for_each_sink(
+            [this](std::string_view filename, auto& sink) -> void
+            {
+                if constexpr (std::remove_cvref_t<decltype(sink)>::IsStructType)
+                {
+                    if (auto filtered_output = filtered_outputs_.find(filename);
+                        filtered_output != filtered_outputs_.end() and filtered_output->second.is_connected)
+                    {
+                        auto& filter = filtered_output->second.filter.value();
+                        if (filter.run_once(*trigger_converter_, 0).has_value())
+                        {
+                            [[maybe_unused]] auto res = sink.run_once(filter, 0);
+                        }
+                        return;
+                    }
+                    [[maybe_unused]] auto res = sink.run_once(*trigger_converter_, 0);
+                }
+            });
+    }
+
     auto TaskDiagram::is_taskflow_abort_ready() const -> bool
     {
         static constexpr auto SLEEP_TIME = std::chrono::milliseconds(10);
@@ -139,16 +261,37 @@ namespace srs::workflow
         -> std::optional<std::pair<const ThisTask&, tf::Task>>
     {
         current_task.set_report(report_);
-        // NOTE: This is where the previous converter and current task is connected.
-        auto task = taskflow
-                        .emplace([line_number, &current_task, &prev_converter = prev_task.first]()
-                                 { [[maybe_unused]] auto res = current_task.run_once(prev_converter, line_number); })
-                        .name(current_task.get_name_str());
-        if (not prev_task.second.empty())
+        if constexpr (FrameFilterType<ThisTask>)
         {
-            prev_task.second.precede(task);
+            // NOTE: Condition task. Its only successor, which all downstream tasks depend on, is skipped if the
+            // current frame is rejected.
+            auto task = taskflow
+                            .emplace(
+                                [line_number, &current_task, &prev_converter = prev_task.first]() -> int
+                                { return current_task.run_once(prev_converter, line_number).has_value() ? 0 : 1; })
+                            .name(current_task.get_name_str());
+            auto valid_task = taskflow.placeholder().name(current_task.get_name_str() + " (valid)");
+            task.precede(valid_task);
+            if (not prev_task.second.empty())
+            {
+                prev_task.second.precede(task);
+            }
+            return std::pair<const ThisTask&, tf::Task>{ current_task, valid_task };
+        }
+        else
+        {
+            // NOTE: This is where the previous converter and current task is connected.
+            auto task =
+                taskflow
+                    .emplace([line_number, &current_task, &prev_converter = prev_task.first]()
+                             { [[maybe_unused]] auto res = current_task.run_once(prev_converter, line_number); })
+                    .name(current_task.get_name_str());
+            if (not prev_task.second.empty())
+            {
+                prev_task.second.precede(task);
+            }
+            return std::pair<const ThisTask&, tf::Task>{ current_task, task };
         }
-        return std::pair<const ThisTask&, tf::Task>{ current_task, task };
     }
 
     template <typename PrevConverter, ConverterType ThisTask>
@@ -161,7 +304,10 @@ namespace srs::workflow
         {
             return {};
         }
-        auto is_required = sinks_->is_convert_required(ThisTask::converter_type);
+        // Triggering the raw data outputs requires the struct data even if no other outputs need it.
+        using enum process::DataConvertOptions;
+        auto is_required = sinks_->is_convert_required(ThisTask::converter_type) or
+                           (is_raw_output_triggered_ and ThisTask::converter_type == structure);
         if (not is_required)
         {
             return {};
@@ -186,6 +332,103 @@ namespace srs::workflow
         return emplace_to_taskflow(current_task, prev_task.value(), taskflow, line_number);
     }
 
+    template <typename PrevConverter, SinkType ThisTask>
+    void TaskDiagram::create_filtered_sink_task(ThisTask& sink,
+                                                FilteredOutput& output,
+                                                std::optional<std::pair<const PrevConverter&, tf::Task>>& prev_task,
+                                                tf::Taskflow& taskflow,
+                                                std::size_t line_number)
+    {
+        using enum process::DataConvertOptions;
+        if constexpr (not ThisTask::IsStructType)
+        {
+            // Raw data outputs don't depend on the struct data and cannot be filtered.
+            constexpr auto filterable_conversions =
+                std::array{ proto, proto_frame, packed_proto, packed_proto_frame, flat };
+            if (not std::ranges::contains(filterable_conversions, sink.get_required_conversion()))
+            {
+                return;
+            }
+        }
+        if (not prev_task.has_value())
+        {
+            return;
+        }
+        output.is_connected = true;
+
+        // Converters of a filtered output are only created for its own conversion.
+        auto create_task = [line_number, &taskflow, this]<typename PrevTask, typename CurrentTask>(
+                               std::optional<CurrentTask>& current_task,
+                               std::optional<std::pair<const PrevTask&, tf::Task>>& prev)
+            -> std::optional<std::pair<const CurrentTask&, tf::Task>>
+        {
+            if (not prev.has_value())
+            {
+                return {};
+            }
+            if (not current_task)
+            {
+                current_task.emplace(n_lines_);
+            }
+            return emplace_to_taskflow(current_task.value(), prev.value(), taskflow, line_number);
+        };
+
+        auto filter_task = emplace_to_taskflow(output.filter.value(), prev_task.value(), taskflow, line_number);
+        if constexpr (ThisTask::IsStructType)
+        {
+            create_task_imp(sink, filter_task, taskflow, line_number);
+        }
+        else
+        {
+            switch (sink.get_required_conversion())
+            {
+                case proto:
+                case proto_frame:
+                {
+                    auto struct_to_proto_task = create_task(output.struct_to_proto_converter, filter_task);
+                    if (sink.get_required_conversion() == proto)
+                    {
+                        auto serial_task = create_task(output.proto_serializer_converter, struct_to_proto_task);
+                        create_task_imp(sink, serial_task, taskflow, line_number);
+                    }
+                    else
+                    {
+                        auto serial_task = create_task(output.proto_delim_serializer_converter, struct_to_proto_task);
+                        create_task_imp(sink, serial_task, taskflow, line_number);
+                    }
+                    break;
+                }
+                case packed_proto:
+                case packed_proto_frame:
+                {
+                    auto struct_to_packed_proto_task =
+                        create_task(output.struct_to_packed_proto_converter, filter_task);
+                    if (sink.get_required_conversion() == packed_proto)
+                    {
+                        auto serial_task =
+                            create_task(output.packed_proto_serializer_converter, struct_to_packed_proto_task);
+                        create_task_imp(sink, serial_task, taskflow, line_number);
+                    }
+                    else
+                    {
+                        auto serial_task =
+                            create_task(output.packed_proto_delim_serializer_converter, struct_to_packed_proto_task);
+                        create_task_imp(sink, serial_task, taskflow, line_number);
+                    }
+                    break;
+                }
+                case flat:
+                {
+                    auto struct_to_flat_task = create_task(output.struct_to_flat_converter, filter_task);
+                    create_task_imp(sink, struct_to_flat_task, taskflow, line_number);
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+    }
+
     void TaskDiagram::construct_taskflow_line(tf::Taskflow& taskflow, std::size_t line_number)
     {
         auto create_task = [line_number, &taskflow, this]<typename PrevConverter, typename ThisTask>(
@@ -195,24 +438,49 @@ namespace srs::workflow
         { return create_task_imp(current_task, prev_task, taskflow, line_number); };
 
         auto empty_task = std::optional{ std::pair<const TaskDiagram&, tf::Task>{ *this, tf::Task{} } };
-        auto raw_delimiter_task = create_task(raw_to_delim_raw_converter_, empty_task);
         auto struct_deser_task = create_task(struct_deserializer_converter_, empty_task);
-        auto struct_to_proto_task = create_task(struct_to_proto_converter_, struct_deser_task);
+        auto struct_process_task = create_task(struct_processor_converter_, struct_deser_task);
+        auto trigger_task = create_task(trigger_converter_, struct_process_task);
+        // Raw data outputs only run after the frame is accepted by the software trigger, if required.
+        auto raw_task = (is_raw_output_triggered_ and trigger_task.has_value())
+                            ? std::optional{ std::pair<const TaskDiagram&, tf::Task>{ *this, trigger_task->second } }
+                            : empty_task;
+        auto raw_delimiter_task = create_task(raw_to_delim_raw_converter_, raw_task);
+        auto struct_to_proto_task = create_task(struct_to_proto_converter_, trigger_task);
         auto proto_serial_task = create_task(proto_serializer_converter_, struct_to_proto_task);
         auto proto_delim_serial_task = create_task(proto_delim_serializer_converter_, struct_to_proto_task);
+        auto struct_to_packed_proto_task = create_task(struct_to_packed_proto_converter_, trigger_task);
+        auto packed_proto_serial_task = create_task(packed_proto_serializer_converter_, struct_to_packed_proto_task);
+        auto packed_proto_delim_serial_task =
+            create_task(packed_proto_delim_serializer_converter_, struct_to_packed_proto_task);
+        auto struct_to_flat_task = create_task(struct_to_flat_converter_, trigger_task);
         // TODO: root_deser
 
         sinks_->do_for_each_sink(
-            [&create_task,
-             &empty_task,
+            [this,
+             line_number,
+             &taskflow,
+             &create_task,
+             &raw_task,
              &raw_delimiter_task,
-             &struct_deser_task,
+             &trigger_task,
              &proto_serial_task,
-             &proto_delim_serial_task](std::string_view filename, auto& sink) -> void
+             &proto_delim_serial_task,
+             &packed_proto_serial_task,
+             &packed_proto_delim_serial_task,
+             &struct_to_flat_task](std::string_view filename, auto& sink) -> void
             {
+                if (auto filtered_output = filtered_outputs_.find(filename); filtered_output != filtered_outputs_.end())
+                {
+                    create_filtered_sink_task(sink, filtered_output->second, trigger_task, taskflow, line_number);
+                    if (filtered_output->second.is_connected)
+                    {
+                        return;
+                    }
+                }
                 if constexpr (std::remove_cvref_t<decltype(sink)>::IsStructType)
                 {
-                    create_task(sink, struct_deser_task);
+                    create_task(sink, trigger_task);
                 }
                 else
                 {
@@ -221,7 +489,7 @@ namespace srs::workflow
                     switch (convert_mode)
                     {
                         case raw:
-                            create_task(sink, empty_task);
+                            create_task(sink, raw_task);
                             break;
                         case raw_frame:
                             create_task(sink, raw_delimiter_task);
@@ -232,12 +500,34 @@ namespace srs::workflow
                         case proto_frame:
                             create_task(sink, proto_delim_serial_task);
                             break;
+                        case packed_proto:
+                            create_task(sink, packed_proto_serial_task);
+                            break;
+                        case packed_proto_frame:
+                            create_task(sink, packed_proto_delim_serial_task);
+                            break;
+                        case flat:
+                            create_task(sink, struct_to_flat_task);
+                            break;
                         default:
                             spdlog::warn("unrecognized conversion {} from the file {}", convert_mode, filename);
-                            create_task(sink, empty_task);
+                            create_task(sink, raw_task);
                             break;
                     }
                 }
             });
+
+        if (line_number == 0)
+        {
+            for (const auto& [output_name, output] : filtered_outputs_)
+            {
+                if (not output.is_connected)
+                {
+                    spdlog::warn("Filter expression of the output {:?} is ignored as the output doesn't exist or "
+                                 "writes raw data.",
+                                 output_name);
+                }
+            }
+        }
     }
 } // namespace srs::workflow
@@ -1,14 +1,21 @@
 #pragma once
 
 #include "srs/Application.hpp"
+#include "srs/converters/CoincidenceTrigger.hpp"
+#include "srs/converters/ExpressionFilter.hpp"
+#include "srs/converters/FrameHeaderParser.hpp"
 #include "srs/converters/ProtoSerializer.hpp"
 #include "srs/converters/RawToDelimRawConveter.hpp"
 #include "srs/converters/StructDeserializer.hpp"
+#include "srs/converters/StructProcessor.hpp"
+#include "srs/converters/StructToFlatConverter.hpp"
+#include "srs/converters/StructToPackedProtoConverter.hpp"
 #include "srs/converters/StructToProtoConverter.hpp"
 #include "srs/data/BufferQueue.hpp"
 #include "srs/data/LargeBuffer.hpp"
 #include "srs/data/SRSDataStructs.hpp"
 #include "srs/sinks/Manager.hpp"
+#include "srs/sinks/QuarantineFile.hpp"
 #include "srs/utils/AppReport.hpp"
 #include "srs/utils/CommonConcepts.hpp"
 #include <atomic>
@@ -16,8 +23,12 @@
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <gsl/gsl-lite.hpp>
+#include <map>
+#include <memory>
 #include <optional>
+#include <string>
 #include <string_view>
 #include <taskflow/core/executor.hpp>
 #include <taskflow/core/task.hpp>
@@ -57,6 +68,12 @@ namespace srs::workflow
             return raw_data_[line_number].data();
         }
 
+        //! Header of the current frame, parsed once before any other tasks of the pipeline
+        [[nodiscard]] auto get_frame_header(std::size_t line_number) const -> const process::FrameHeaderResult&
+        {
+            return frame_headers_[line_number];
+        }
+
         [[nodiscard]] auto get_data_bytes() const -> uint64_t { return total_read_data_bytes_.load(); }
         [[nodiscard]] auto get_n_lines() const -> std::size_t { return n_lines_; }
 
@@ -69,9 +86,37 @@ namespace srs::workflow
             return nullptr;
         }
 
+        //! Total numbers of the frames failing to be decoded, indexed by common::DecodeError
+        [[nodiscard]] auto get_decode_error_counts() const -> process::StructDeserializer::DecodeErrorCounts
+        {
+            return struct_deserializer_converter_.value().get_decode_error_counts();
+        }
+
+        //! Total numbers of the frames accepted and rejected by the software trigger
+        [[nodiscard]] auto get_trigger_stat() const -> AppReport::TriggerStat
+        {
+            return trigger_converter_.value().get_trigger_stat();
+        }
+
+        [[nodiscard]] auto is_trigger_enabled() const -> bool { return trigger_converter_.value().is_enabled(); }
+
         void register_report(AppReport& report) { report.register_task_result("Workflow", stats_); }
 
       private:
+        // Filter and converters owned by an output with its own filter expression
+        struct FilteredOutput
+        {
+            bool is_connected = false;
+            std::optional<process::ExpressionFilter> filter;
+            std::optional<process::Struct2ProtoConverter> struct_to_proto_converter;
+            std::optional<process::ProtoSerializer> proto_serializer_converter;
+            std::optional<process::ProtoDelimSerializer> proto_delim_serializer_converter;
+            std::optional<process::Struct2PackedProtoConverter> struct_to_packed_proto_converter;
+            std::optional<process::PackedProtoSerializer> packed_proto_serializer_converter;
+            std::optional<process::PackedProtoDelimSerializer> packed_proto_delim_serializer_converter;
+            std::optional<process::Struct2FlatConverter> struct_to_flat_converter;
+        };
+
         std::atomic<bool> is_done_ = false;
         std::size_t n_lines_ = 1;
         tf::Executor tf_executor_;
@@ -80,12 +125,22 @@ namespace srs::workflow
         std::vector<BufferQueue::Token> consumer_tokens_;
         std::vector<std::atomic<bool>> is_pipeline_stopped_;
         std::vector<LargeBuffer> raw_data_;
+        std::vector<process::FrameHeaderResult> frame_headers_;
+        std::unique_ptr<sink::QuarantineFile> quarantine_file_;
+        bool is_raw_output_triggered_ = false;
 
         std::optional<process::Raw2DelimRawConverter> raw_to_delim_raw_converter_;
         std::optional<process::StructDeserializer> struct_deserializer_converter_;
+        std::optional<process::StructProcessor> struct_processor_converter_;
+        std::optional<process::CoincidenceTrigger> trigger_converter_;
         std::optional<process::Struct2ProtoConverter> struct_to_proto_converter_;
         std::optional<process::ProtoSerializer> proto_serializer_converter_;
         std::optional<process::ProtoDelimSerializer> proto_delim_serializer_converter_;
+        std::optional<process::Struct2PackedProtoConverter> struct_to_packed_proto_converter_;
+        std::optional<process::PackedProtoSerializer> packed_proto_serializer_converter_;
+        std::optional<process::PackedProtoDelimSerializer> packed_proto_delim_serializer_converter_;
+        std::optional<process::Struct2FlatConverter> struct_to_flat_converter_;
+        std::map<std::string, FilteredOutput, std::less<>> filtered_outputs_;
 
         std::atomic<uint64_t> total_read_data_bytes_ = 0;
         std::vector<AppReport::TaskStat> stats_;
@@ -96,6 +151,7 @@ namespace srs::workflow
         AppReport* report_;
 
         void construct_taskflow_line(tf::Taskflow& taskflow, std::size_t line_number);
+        void flush_events();
 
         void start_time_record(std::size_t line_num)
         {
@@ -128,5 +184,12 @@ namespace srs::workflow
                              std::optional<std::pair<const PrevConverter&, tf::Task>>& prev_task,
                              tf::Taskflow& taskflow,
                              std::size_t line_number) -> std::optional<std::pair<const ThisTask&, tf::Task>>;
+
+        template <typename PrevConverter, SinkType ThisTask>
+        void create_filtered_sink_task(ThisTask& sink,
+                                       FilteredOutput& output,
+                                       std::optional<std::pair<const PrevConverter&, tf::Task>>& prev_task,
+                                       tf::Taskflow& taskflow,
+                                       std::size_t line_number);
     };
 } // namespace srs::workflow
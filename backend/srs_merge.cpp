@@ -0,0 +1,116 @@
+#include "srs/mergers/FrameMerger.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
+#include "srs/utils/CommonFunctions.hpp"
+#include <CLI/CLI.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <spdlog/common.h>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <vector>
+
+using srs::common::internal::get_enum_dash_map;
+using srs::common::internal::get_enum_dashed_name;
+using srs::common::internal::get_enum_dashed_names;
+
+constexpr auto SPDLOG_LOG_NAMES = get_enum_dashed_names<spdlog::level::level_enum>();
+constexpr auto COMPRESSION_NAMES = get_enum_dashed_names<srs::common::CompressionType>();
+const auto spdlog_map = get_enum_dash_map<spdlog::level::level_enum>();
+const auto compression_map = get_enum_dash_map<srs::common::CompressionType>();
+
+// NOLINTNEXTLINE (bugprone-exception-escape)
+auto main(int argc, char** argv) -> int
+{
+    auto cli_args = CLI::App{ "Merge the binary output files split by srs-control" };
+    try
+    {
+        argv = cli_args.ensure_utf8(argv);
+
+        static constexpr auto BYTES_PER_MIB = std::size_t{ 1024 } * 1024;
+        auto spdlog_level = spdlog::level::info;
+        auto input_filenames = std::vector<std::string>{};
+        auto output_filename = std::string{};
+        auto options = srs::merger::FrameMerger::Options{};
+        auto buffer_size_mib = options.max_buffer_size / BYTES_PER_MIB;
+        options.compression.proto.type = srs::common::CompressionType::zstd;
+        options.index_interval = 1000;
+
+        cli_args
+            .add_option("-l, --log-level",
+                        spdlog_level,
+                        fmt::format("Set log level\nAvailable options: [{}]", fmt::join(SPDLOG_LOG_NAMES, ", ")))
+            ->transform(CLI::CheckedTransformer(spdlog_map, CLI::ignore_case).description(""))
+            ->default_str(get_enum_dashed_name(spdlog_level));
+        cli_args.add_option("-o, --output", output_filename, "Set the merged output file")->required();
+        cli_args
+            .add_option("-c, --compression",
+                        options.compression.proto.type,
+                        fmt::format("Set the compression of the Protobuf output\nAvailable options: [{}]",
+                                    fmt::join(COMPRESSION_NAMES, ", ")))
+            ->transform(CLI::CheckedTransformer(compression_map, CLI::ignore_case).description(""))
+            ->default_str(get_enum_dashed_name(options.compression.proto.type));
+        cli_args.add_option("-j, --threads", options.n_threads, "Set the number of threads to decompress raw inputs")
+            ->capture_default_str();
+        cli_args
+            .add_option("-b, --buffer-size", buffer_size_mib, "Set the maximal memory (MiB) of the frames waiting")
+            ->capture_default_str();
+        cli_args
+            .add_option(
+                "--index-interval", options.index_interval, "Set the frame index interval of the output. 0 to disable")
+            ->capture_default_str();
+        cli_args.add_flag("-d, --drop-duplicates", options.drop_duplicates, "Drop the frames with duplicated counters");
+        cli_args.add_option("files", input_filenames, "Set the input files, e.g. output_0.bin output_1.bin")
+            ->required()
+            ->check(CLI::ExistingFile);
+
+        cli_args.parse(argc, argv);
+        spdlog::set_level(spdlog_level);
+        options.max_buffer_size = buffer_size_mib * BYTES_PER_MIB;
+
+        auto merger = srs::merger::FrameMerger{ input_filenames, output_filename, options };
+        const auto start_time = std::chrono::steady_clock::now();
+        if (auto res = merger.run(); not res.has_value())
+        {
+            spdlog::critical("Merging failed: {}", res.error());
+            return EXIT_FAILURE;
+        }
+        const auto duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+        const auto& stat = merger.get_stat();
+        static constexpr auto BYTES_PER_MB = 1e6;
+        spdlog::info("{} frames ({:.1f} MB) from {} files are merged to {:?} in {:.2f} s ({:.1f} MB/s).",
+                     stat.n_frames,
+                     static_cast<double>(stat.n_bytes) / BYTES_PER_MB,
+                     input_filenames.size(),
+                     output_filename,
+                     duration,
+                     static_cast<double>(stat.n_bytes) / BYTES_PER_MB / duration);
+        spdlog::info("Gaps: {} ({} missing frames), duplicates: {}, out of order: {}, invalid frames: {}",
+                     stat.n_gaps,
+                     stat.n_missing_frames,
+                     stat.n_duplicates,
+                     stat.n_out_of_order,
+                     stat.n_invalid_frames);
+        spdlog::debug("Maximal buffer size: {} bytes, forced writes: {}", stat.max_buffer_size, stat.n_forced_writes);
+    }
+    catch (const CLI::ParseError& e)
+    {
+        return cli_args.exit(e);
+    }
+    catch (std::exception& ex)
+    {
+        spdlog::critical("Exception occurred: {}", ex.what());
+        return EXIT_FAILURE;
+    }
+    catch (...)
+    {
+        spdlog::critical("A unrecognized exception occurred!");
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -19,6 +19,8 @@ find_package(concurrentqueue REQUIRED)
 find_package(magic_enum REQUIRED CONFIG)
 find_package(Taskflow REQUIRED CONFIG)
 find_package(tabulate REQUIRED CONFIG)
+find_package(zstd REQUIRED CONFIG)
+find_package(lz4 REQUIRED CONFIG)
 
 # find_package(glaze REQUIRED CONFIG)
 find_package(ctre REQUIRED CONFIG)
@@ -56,6 +58,25 @@ else()
     message(STATUS "ROOT depenedency is disabled!")
 endif()
 
+if(NOT NO_ARROW)
+    if(USE_ARROW)
+        message(STATUS "Force to use Apache Arrow depenedency!")
+        find_package(Arrow REQUIRED CONFIG)
+        find_package(Parquet REQUIRED CONFIG)
+    else()
+        find_package(Arrow QUIET CONFIG)
+        find_package(Parquet QUIET CONFIG)
+    endif()
+endif()
+
+if(Arrow_FOUND AND Parquet_FOUND)
+    set(ARROW_FOUND TRUE)
+    message(STATUS "Apache Arrow depenedency is enabled!")
+else()
+    set(ARROW_FOUND FALSE)
+    message(STATUS "Apache Arrow depenedency is disabled!")
+endif()
+
 set(PRIVATE_THIRD_PARTY_LIBRARIES
     $<BUILD_LOCAL_INTERFACE:asio::asio>
     $<BUILD_LOCAL_INTERFACE:fmt::fmt-header-only>
@@ -66,6 +87,8 @@ set(PRIVATE_THIRD_PARTY_LIBRARIES
     $<BUILD_LOCAL_INTERFACE:zpp_bits::zpp_bits>
     $<BUILD_LOCAL_INTERFACE:concurrentqueue::concurrentqueue>
     $<BUILD_LOCAL_INTERFACE:tabulate::tabulate>
+    $<BUILD_LOCAL_INTERFACE:zstd::libzstd_static>
+    $<BUILD_LOCAL_INTERFACE:LZ4::lz4_static>
 )
 
 set(THIRD_PARTY_LIBRARIES
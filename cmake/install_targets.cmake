@@ -58,7 +58,7 @@ install(
 
 # install executable
 
-install(TARGETS srs_control srs_check srs_fec_emulator)
+install(TARGETS srs_control srs_check srs_fec_emulator srs_merge)
 
 # install miscellaneous
 
@@ -1,5 +1,7 @@
 option(USE_ROOT "Force to use ROOT dependency." OFF)
 option(NO_ROOT "Disable the usage of ROOT dependency." OFF)
+option(USE_ARROW "Force to use Apache Arrow dependency." OFF)
+option(NO_ARROW "Disable the usage of Apache Arrow dependency." OFF)
 option(BUILD_STATIC "Enable static linking of libstdc++." OFF)
 option(ENABLE_TEST "Enable testing framework of the project." ON)
 option(BUILD_DOC "Build the documentation for this project." OFF)
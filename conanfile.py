@@ -31,6 +31,8 @@ class CompressorRecipe(ConanFile):
         self.requires("asio/1.38.0")            # type: ignore
         self.requires("ctre/3.11.0")            # type: ignore
         self.requires("tabulate/1.5")           # type: ignore
+        self.requires("zstd/1.5.7")             # type: ignore
+        self.requires("lz4/1.10.0")             # type: ignore
 
         if os.environ["CMAKE_ENABLE_TEST"] == "ON":
             self.requires("catch2/3.15.1")# type: ignore
@@ -2,28 +2,65 @@
 
 import argparse
 import gzip
+import io
+import struct
 
 import delimited_protobuf as dp
 import message_pb2
 
+GZIP_MAGIC = b"\x1f\x8b"
+ZSTD_MAGIC = 0xFD2FB528
+ZSTD_SKIPPABLE_MAGIC = 0x184D2A50
+ZSTD_SKIPPABLE_MASK = 0xFFFFFFF0
+LZ4_MAGIC = 0x184D2204
+
 
 class ProtobufFile:
     def __init__(self, filename: str):
         self.filename = filename
-        self.struct_data = message_pb2.Data()
+        self.message_type = message_pb2.PackedData if filename.endswith(".pbc") else message_pb2.Data
+        self.struct_data = None
 
     def print(self):
-        with gzip.open(self.filename, "rb") as file:
+        with self.__open() as file:
             while True:
-                self.struct_data = dp.read(file, message_pb2.Data)
+                self.struct_data = dp.read(file, self.message_type)
                 if self.struct_data is not None:
                     self.__print_message()
                 else:
                     break
 
+    def __open(self) -> io.BufferedIOBase:
+        with open(self.filename, "rb") as file:
+            head = file.read(8)
+        if len(head) < 4:
+            return open(self.filename, "rb")
+        magic = struct.unpack("<I", head[:4])[0]
+        if head[:2] == GZIP_MAGIC:
+            return gzip.open(self.filename, "rb")
+        if magic == ZSTD_MAGIC or (magic & ZSTD_SKIPPABLE_MASK) == ZSTD_SKIPPABLE_MAGIC:
+            import zstandard
+
+            file = open(self.filename, "rb")
+            dictionary = None
+            if magic != ZSTD_MAGIC:
+                dict_size = struct.unpack("<I", head[4:8])[0]
+                file.seek(8)
+                dictionary = zstandard.ZstdCompressionDict(file.read(dict_size))
+            decompressor = zstandard.ZstdDecompressor(dict_data=dictionary)
+            return io.BufferedReader(decompressor.stream_reader(file, closefd=True))
+        if magic == LZ4_MAGIC:
+            import lz4.frame
+
+            return lz4.frame.open(self.filename, "rb")
+        return open(self.filename, "rb")
+
     def __print_message(self):
         if self.struct_data is None:
             return
+        if isinstance(self.struct_data, message_pb2.PackedData):
+            self.__print_packed_message()
+            return
         header = self.struct_data.header
         print("---------------------------------------------")
         print(f"hit size: {len(self.struct_data.hit_data)}")
@@ -37,6 +74,39 @@ class ProtobufFile:
                 f"off: {hit_data.offset}, vid: {hit_data.vmm_id}, "
                 f"adc: {hit_data.adc}, bid: {hit_data.bc_id}]"
             )
+        for cluster_data in self.struct_data.cluster_data:
+            print(
+                f"cluster data: [plane: {cluster_data.plane}, centroid: {cluster_data.centroid:.2f}, "
+                f"charge: {cluster_data.charge}, size: {cluster_data.size}, time: {cluster_data.time}]"
+            )
+
+    def __print_packed_message(self):
+        data = self.struct_data
+        print("---------------------------------------------")
+        print(f"hit size: {len(data.hit_adc)}")
+        print(f"header: {data.header}")
+        srs_timestamp = 0
+        for vmm_id, timestamp_delta in zip(data.marker_vmm_id, data.marker_srs_timestamp_delta):
+            srs_timestamp += timestamp_delta
+            print(f"markder data: [vmm_id: {vmm_id}, srs_timestamp: {srs_timestamp}]")
+        for channel_vmm, tdc, offset, adc, bc_id in zip(
+            data.hit_channel_vmm, data.hit_tdc, data.hit_offset, data.hit_adc, data.hit_bc_id
+        ):
+            print(
+                f"hit data: [ot: {bool((channel_vmm >> 11) & 0x1)}, "
+                f"cn: {channel_vmm & 0x3F}, tdc: {tdc}, "
+                f"off: {offset}, vid: {(channel_vmm >> 6) & 0x1F}, "
+                f"adc: {adc}, bid: {bc_id}]"
+            )
+        cluster_time = 0
+        for plane, centroid, charge, size, time_delta in zip(
+            data.cluster_plane, data.cluster_centroid, data.cluster_charge, data.cluster_size, data.cluster_time_delta
+        ):
+            cluster_time += time_delta
+            print(
+                f"cluster data: [plane: {plane}, centroid: {centroid:.2f}, "
+                f"charge: {charge}, size: {size}, time: {cluster_time}]"
+            )
 
 
 if __name__ == "__main__":
@@ -14,7 +14,7 @@ _sym_db = _symbol_database.Default()
 
 
 
-DESCRIPTOR = _descriptor_pool.Default().AddSerializedFile(b'\n\rmessage.proto\x12\tsrs.proto\"^\n\x0cStructHeader\x12\x15\n\rframe_counter\x18\x01 \x01(\r\x12\x0e\n\x06\x66\x65\x63_id\x18\x02 \x01(\r\x12\x15\n\rudp_timestamp\x18\x03 \x01(\r\x12\x10\n\x08overflow\x18\x04 \x01(\r\"3\n\nMarkerData\x12\x0e\n\x06vmm_id\x18\x01 \x01(\r\x12\x15\n\rsrs_timestamp\x18\x02 \x01(\x04\"\x82\x01\n\x07HitData\x12\x19\n\x11is_over_threshold\x18\x01 \x01(\x08\x12\x13\n\x0b\x63hannel_num\x18\x02 \x01(\r\x12\x0b\n\x03tdc\x18\x03 \x01(\r\x12\x0e\n\x06offset\x18\x04 \x01(\r\x12\x0e\n\x06vmm_id\x18\x05 \x01(\r\x12\x0b\n\x03\x61\x64\x63\x18\x06 \x01(\r\x12\r\n\x05\x62\x63_id\x18\x07 \x01(\r\"\x81\x01\n\x04\x44\x61ta\x12\'\n\x06header\x18\x01 \x01(\x0b\x32\x17.srs.proto.StructHeader\x12*\n\x0bmarker_data\x18\x02 \x03(\x0b\x32\x15.srs.proto.MarkerData\x12$\n\x08hit_data\x18\x03 \x03(\x0b\x32\x12.srs.proto.HitDatab\x06proto3')
+DESCRIPTOR = _descriptor_pool.Default().AddSerializedFile(b'\n\rmessage.proto\x12\tsrs.proto\"^\n\x0cStructHeader\x12\x15\n\rframe_counter\x18\x01 \x01(\r\x12\x0e\n\x06\x66\x65\x63_id\x18\x02 \x01(\r\x12\x15\n\rudp_timestamp\x18\x03 \x01(\r\x12\x10\n\x08overflow\x18\x04 \x01(\r\"3\n\nMarkerData\x12\x0e\n\x06vmm_id\x18\x01 \x01(\r\x12\x15\n\rsrs_timestamp\x18\x02 \x01(\x04\"\x82\x01\n\x07HitData\x12\x19\n\x11is_over_threshold\x18\x01 \x01(\x08\x12\x13\n\x0b\x63hannel_num\x18\x02 \x01(\r\x12\x0b\n\x03tdc\x18\x03 \x01(\r\x12\x0e\n\x06offset\x18\x04 \x01(\r\x12\x0e\n\x06vmm_id\x18\x05 \x01(\r\x12\x0b\n\x03\x61\x64\x63\x18\x06 \x01(\r\x12\r\n\x05\x62\x63_id\x18\x07 \x01(\r\"Z\n\x0b\x43lusterData\x12\r\n\x05plane\x18\x01 \x01(\r\x12\x10\n\x08\x63\x65ntroid\x18\x02 \x01(\x02\x12\x0e\n\x06\x63harge\x18\x03 \x01(\r\x12\x0c\n\x04size\x18\x04 \x01(\r\x12\x0c\n\x04time\x18\x05 \x01(\x04\"\xaf\x01\n\x04\x44\x61ta\x12\'\n\x06header\x18\x01 \x01(\x0b\x32\x17.srs.proto.StructHeader\x12*\n\x0bmarker_data\x18\x02 \x03(\x0b\x32\x15.srs.proto.MarkerData\x12$\n\x08hit_data\x18\x03 \x03(\x0b\x32\x12.srs.proto.HitData\x12,\n\x0c\x63luster_data\x18\x04 \x03(\x0b\x32\x16.srs.proto.ClusterData\"\xde\x02\n\nPackedData\x12\x0f\n\x07version\x18\x01 \x01(\r\x12\'\n\x06header\x18\x02 \x01(\x0b\x32\x17.srs.proto.StructHeader\x12\x15\n\rmarker_vmm_id\x18\x03 \x03(\r\x12\"\n\x1amarker_srs_timestamp_delta\x18\x04 \x03(\x12\x12\x17\n\x0fhit_channel_vmm\x18\x05 \x03(\r\x12\x0f\n\x07hit_tdc\x18\x06 \x03(\r\x12\x12\n\nhit_offset\x18\x07 \x03(\r\x12\x0f\n\x07hit_adc\x18\x08 \x03(\r\x12\x11\n\thit_bc_id\x18\t \x03(\r\x12\x15\n\rcluster_plane\x18\n \x03(\r\x12\x18\n\x10\x63luster_centroid\x18\x0b \x03(\x02\x12\x16\n\x0e\x63luster_charge\x18\x0c \x03(\r\x12\x14\n\x0c\x63luster_size\x18\r \x03(\r\x12\x1a\n\x12\x63luster_time_delta\x18\x0e \x03(\x12\x62\x06proto3')
 
 _globals = globals()
 _builder.BuildMessageAndEnumDescriptors(DESCRIPTOR, _globals)
@@ -27,6 +27,10 @@ if _descriptor._USE_C_DESCRIPTORS == False:
   _globals['_MARKERDATA']._serialized_end=175
   _globals['_HITDATA']._serialized_start=178
   _globals['_HITDATA']._serialized_end=308
-  _globals['_DATA']._serialized_start=311
-  _globals['_DATA']._serialized_end=440
+  _globals['_CLUSTERDATA']._serialized_start=310
+  _globals['_CLUSTERDATA']._serialized_end=400
+  _globals['_DATA']._serialized_start=403
+  _globals['_DATA']._serialized_end=578
+  _globals['_PACKEDDATA']._serialized_start=581
+  _globals['_PACKEDDATA']._serialized_end=931
 # @@protoc_insertion_point(module_scope)
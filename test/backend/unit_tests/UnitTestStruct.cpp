@@ -1,13 +1,45 @@
+#include "srs/converters/CoincidenceTrigger.hpp"
+#include "srs/converters/ExpressionFilter.hpp"
+#include "srs/converters/FrameArena.hpp"
+#include "srs/converters/FrameHeaderParser.hpp"
+#include "srs/converters/RawToDelimRawConveter.hpp"
 #include "srs/converters/StructDeserializer.hpp"
+#include "srs/converters/StructProcessor.hpp"
 #include "srs/converters/StructSerializer.hpp"
+#include "srs/converters/StructToFlatConverter.hpp"
+#include "srs/converters/StructToPackedProtoConverter.hpp"
 #include "srs/data/SRSDataStructs.hpp"
+#include "srs/data/message.pb.h"
+#include "srs/processors/ChannelMapper.hpp"
+#include "srs/processors/EventBuilder.hpp"
+#include "srs/processors/FilterExpression.hpp"
+#include "srs/processors/StripClusterer.hpp"
+#include "srs/readers/FlatMsgReader.hpp"
+#include "srs/readers/ProtoFrameReader.hpp"
+#include "srs/readers/ProtoMsgReader.hpp"
+#include "srs/sinks/StreamCompressor.hpp"
+#include "srs/utils/CommonDefinitions.hpp"
+#include <algorithm>
 #include <array>
+#include <catch2/catch_message.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <fstream>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <google/protobuf/util/delimited_message_util.h>
+#include <ios>
+#include <magic_enum/magic_enum.hpp>
+#include <memory_resource>
 #include <random>
 #include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 using srs::StructData;
 
@@ -88,4 +120,679 @@ TEST_CASE("data_structure")
         CHECK(struct_data.has_value());
         CHECK(random_data == *struct_data.value());
     }
+
+    SECTION("check_decode_errors")
+    {
+        using enum srs::common::DecodeError;
+        const auto random_data = generate_random_struct_data();
+        auto serializer_converter = process::StructSerializer();
+        auto initial_converter = [&random_data](std::size_t /*line_number*/ = 0) -> const StructData*
+        { return &random_data; };
+        REQUIRE(serializer_converter.run(initial_converter).has_value());
+        const auto valid_frame = std::string{ serializer_converter(0) };
+        static constexpr auto HEADER_SIZE = sizeof(srs::ReceiveDataHeader);
+        static constexpr auto VMM_TAG_POSITION = sizeof(uint32_t);
+
+        const auto [bad_frame, error] = GENERATE_COPY(
+            std::pair{ valid_frame.substr(0, HEADER_SIZE), short_frame },
+            std::pair{ std::string{ valid_frame }.replace(VMM_TAG_POSITION, 3, "VM2"), bad_vmm_tag },
+            std::pair{ valid_frame + std::string(2, '\x01'), trailing_bytes },
+            std::pair{ valid_frame + std::string(srs::common::HIT_DATA_BIT_LENGTH / 8, '\0'), invalid_value });
+        INFO("decode error: " << magic_enum::enum_name(error));
+
+        auto deserializer_converter = process::StructDeserializer();
+        auto bad_converter = [&bad_frame](std::size_t /*line_number*/ = 0) -> std::string_view { return bad_frame; };
+        CHECK_FALSE(deserializer_converter.run(bad_converter).has_value());
+        auto valid_converter = [&valid_frame](std::size_t /*line_number*/ = 0) -> std::string_view
+        { return valid_frame; };
+        REQUIRE(deserializer_converter.run(valid_converter).has_value());
+
+        const auto counts = deserializer_converter.get_decode_error_counts();
+        const auto& decode_errors = magic_enum::enum_values<srs::common::DecodeError>();
+        for (const auto [decode_error, count] : std::views::zip(decode_errors, counts))
+        {
+            CHECK(count == (decode_error == error ? 1U : 0U));
+        }
+    }
+
+    SECTION("check_frame_header_parsing")
+    {
+        const auto random_data = generate_random_struct_data();
+        auto serializer_converter = process::StructSerializer();
+        auto initial_converter = [&random_data](std::size_t /*line_number*/ = 0) -> const StructData*
+        { return &random_data; };
+        REQUIRE(serializer_converter.run(initial_converter).has_value());
+        const auto frame = serializer_converter(0);
+
+        const auto header = process::parse_frame_header(frame);
+        REQUIRE(header.has_value());
+        CHECK(header.value() == random_data.header);
+        CHECK(process::parse_frame_header(frame.substr(0, process::FRAME_HEADER_BYTES - 1)).error() ==
+              srs::common::DecodeError::short_frame);
+
+        // The deserializer takes the header from the previous task instead of parsing it again.
+        struct HeaderProvider
+        {
+            std::string_view frame;
+            process::FrameHeaderResult header;
+            auto operator()(std::size_t /*line_number*/ = 0) const -> std::string_view { return frame; }
+            auto get_frame_header(std::size_t /*line_number*/) const -> const process::FrameHeaderResult&
+            {
+                return header;
+            }
+        };
+        auto deserializer_converter = process::StructDeserializer();
+        auto modified_header = header.value();
+        ++modified_header.frame_counter;
+        auto res = deserializer_converter.run(HeaderProvider{ .frame = frame, .header = modified_header });
+        REQUIRE(res.has_value());
+        CHECK(res.value()->header == modified_header);
+        CHECK(res.value()->hit_data == random_data.hit_data);
+    }
+
+    SECTION("check_frame_arena")
+    {
+        static constexpr auto INITIAL_BLOCK_SIZE = std::size_t{ 16 };
+        static constexpr auto LARGE_FRAME_SIZE = std::size_t{ 1000 };
+        auto arena = process::FrameArena{ INITIAL_BLOCK_SIZE };
+        for ([[maybe_unused]] auto _ : std::views::iota(0, 3))
+        {
+            arena.reset();
+            auto buffer = std::pmr::vector<char>(LARGE_FRAME_SIZE, 'a', &arena);
+            CHECK(std::ranges::all_of(buffer, [](char value) { return value == 'a'; }));
+        }
+        // Only the first frame larger than the initial block requests memory from the heap.
+        const auto heap_blocks = arena.get_stat().n_heap_blocks;
+        CHECK(heap_blocks > 0);
+        arena.reset();
+        auto buffer = std::pmr::vector<char>(LARGE_FRAME_SIZE, 'b', &arena);
+        CHECK(arena.get_stat().n_heap_blocks == heap_blocks);
+    }
+
+    SECTION("check_raw_delimiter")
+    {
+        // The frame is forwarded without any copy and the size prefix is provided separately.
+        const auto frame = std::string(std::size_t{ 0x0102 }, 'c');
+        auto frame_converter = [&frame](std::size_t /*line_number*/ = 0) -> std::string_view { return frame; };
+        auto delimiter_converter = process::Raw2DelimRawConverter{};
+        const auto output = delimiter_converter.run(frame_converter, 0);
+        REQUIRE(output.has_value());
+        CHECK(output->data() == frame.data());
+        CHECK(delimiter_converter.get_size_prefix(0) == std::string_view{ "\x00\x00\x01\x02", 4 });
+    }
+
+    SECTION("check_hit_time_reconstruction")
+    {
+        static constexpr auto BC_CLOCK_PERIOD_PS = uint64_t{ 25'000 };
+        static constexpr auto SRS_TIMESTAMP_MAX = (uint64_t{ 1 } << 42U) - 1;
+        static constexpr auto LAST_TIMESTAMP = SRS_TIMESTAMP_MAX - 10;
+        auto processor = process::StructProcessor{
+            1, { .is_hit_time_enabled = true, .bc_clock_period_ps = BC_CLOCK_PERIOD_PS }
+        };
+        auto input_data = StructData{};
+        auto input_converter = [&input_data](std::size_t /*line_number*/ = 0) -> const StructData*
+        { return &input_data; };
+        auto add_marker = [&input_data](uint8_t vmm_id, uint64_t srs_timestamp)
+        {
+            auto& marker = input_data.marker_data.emplace_back();
+            marker.vmm_id = vmm_id;
+            marker.srs_timestamp = srs_timestamp;
+        };
+        auto add_hit = [&input_data](uint8_t vmm_id, uint8_t offset, uint16_t bc_id)
+        {
+            auto& hit = input_data.hit_data.emplace_back();
+            hit.vmm_id = vmm_id;
+            hit.offset = offset;
+            hit.bc_id = bc_id;
+        };
+
+        add_marker(1, LAST_TIMESTAMP);
+        add_hit(1, 2, 3);
+        auto output = processor.run(input_converter);
+        REQUIRE(output.has_value());
+        CHECK(output.value()->hit_time ==
+              std::vector<uint64_t>{ (LAST_TIMESTAMP + (2 * 4096) + 3) * BC_CLOCK_PERIOD_PS });
+        CHECK(input_data.hit_time.empty());
+
+        // The marker of the VMM is kept from the previous frame.
+        srs::reset_struct_data(input_data);
+        add_hit(1, 0, 4);
+        add_hit(2, 0, 5);
+        output = processor.run(input_converter);
+        REQUIRE(output.has_value());
+        CHECK(output.value()->hit_time ==
+              std::vector<uint64_t>{ (LAST_TIMESTAMP + 4) * BC_CLOCK_PERIOD_PS, 5 * BC_CLOCK_PERIOD_PS });
+
+        // The 42-bit timestamp rolls over.
+        srs::reset_struct_data(input_data);
+        add_marker(1, 5);
+        add_hit(1, 0, 1);
+        output = processor.run(input_converter);
+        REQUIRE(output.has_value());
+        CHECK(output.value()->hit_time ==
+              std::vector<uint64_t>{ (SRS_TIMESTAMP_MAX + 1 + 5 + 1) * BC_CLOCK_PERIOD_PS });
+    }
+
+    SECTION("check_hit_time_reconstruction_shared_by_lines")
+    {
+        static constexpr auto BC_CLOCK_PERIOD_PS = uint64_t{ 25'000 };
+        static constexpr auto MARKER_TIMESTAMP = uint64_t{ 1'000 };
+        auto processor = process::StructProcessor{
+            2, { .is_hit_time_enabled = true, .bc_clock_period_ps = BC_CLOCK_PERIOD_PS }
+        };
+        // Frames of the same FEC are dequeued by different pipelines.
+        auto input_data = std::array<StructData, 2>{};
+        input_data[0].header.fec_id = 3;
+        input_data[1].header.fec_id = 3;
+        auto input_converter = [&input_data](std::size_t line_number = 0) -> const StructData*
+        { return &input_data.at(line_number); };
+
+        auto& marker = input_data[0].marker_data.emplace_back();
+        marker.vmm_id = 1;
+        marker.srs_timestamp = MARKER_TIMESTAMP;
+        auto output = processor.run(input_converter, 0);
+        REQUIRE(output.has_value());
+
+        auto& hit = input_data[1].hit_data.emplace_back();
+        hit.vmm_id = 1;
+        hit.bc_id = 2;
+        output = processor.run(input_converter, 1);
+        REQUIRE(output.has_value());
+        CHECK(output.value()->hit_time == std::vector<uint64_t>{ (MARKER_TIMESTAMP + 2) * BC_CLOCK_PERIOD_PS });
+
+        // A delayed frame with an earlier marker doesn't replace the later one for the other frames.
+        input_data[0].marker_data.front().srs_timestamp = MARKER_TIMESTAMP - 100;
+        input_data[0].hit_data = input_data[1].hit_data;
+        output = processor.run(input_converter, 0);
+        REQUIRE(output.has_value());
+        CHECK(output.value()->hit_time == std::vector<uint64_t>{ (MARKER_TIMESTAMP - 98) * BC_CLOCK_PERIOD_PS });
+        output = processor.run(input_converter, 1);
+        REQUIRE(output.has_value());
+        CHECK(output.value()->hit_time == std::vector<uint64_t>{ (MARKER_TIMESTAMP + 2) * BC_CLOCK_PERIOD_PS });
+    }
+
+    SECTION("check_channel_mapping")
+    {
+        const auto filename = std::string{ "unit_test_channel_mapping.txt" };
+        {
+            auto mapping_file = std::ofstream{ filename, std::ios::trunc };
+            mapping_file << "# fec vmm channel plane strip\n"
+                         << "2 0 0 0 10\n"
+                         << "\n"
+                         << "2 1 63 1 200\n";
+        }
+        auto processor = process::StructProcessor{ 1, { .channel_mapping_filename = filename } };
+        auto input_data = StructData{};
+        input_data.header.fec_id = 2;
+        for (const auto [vmm_id, channel_num] : std::array{ std::pair{ 0, 0 }, std::pair{ 1, 63 }, std::pair{ 1, 0 } })
+        {
+            auto& hit = input_data.hit_data.emplace_back();
+            hit.vmm_id = static_cast<uint8_t>(vmm_id);
+            hit.channel_num = static_cast<uint8_t>(channel_num);
+        }
+        auto input_converter = [&input_data](std::size_t /*line_number*/ = 0) -> const StructData*
+        { return &input_data; };
+
+        auto output = processor.run(input_converter);
+        REQUIRE(output.has_value());
+        CHECK(output.value()->hit_plane == std::vector<uint8_t>{ 0, 1, srs::common::UNMAPPED_PLANE_ID });
+        CHECK(output.value()->hit_strip == std::vector<uint16_t>{ 10, 200, srs::common::UNMAPPED_STRIP_ID });
+
+        input_data.header.fec_id = 3;
+        output = processor.run(input_converter);
+        REQUIRE(output.has_value());
+        CHECK(std::ranges::all_of(output.value()->hit_plane,
+                                  [](uint8_t plane) { return plane == srs::common::UNMAPPED_PLANE_ID; }));
+    }
+
+    SECTION("check_channel_mapping_all_fecs")
+    {
+        // The FEC with the ID 255 is the 256th FEC in the table.
+        static constexpr auto N_FECS = 256;
+        const auto filename = std::string{ "unit_test_channel_mapping_all_fecs.txt" };
+        {
+            auto mapping_file = std::ofstream{ filename, std::ios::trunc };
+            for (auto fec_id : std::views::iota(0, N_FECS))
+            {
+                mapping_file << fec_id << " 0 0 0 " << fec_id << "\n";
+            }
+        }
+        const auto mapper = process::ChannelMapper{ filename };
+        CHECK(mapper.get_n_channels() == N_FECS);
+        CHECK(mapper.get_strip_id(0, 0, 0).strip == 0);
+        CHECK(mapper.get_strip_id(N_FECS - 1, 0, 0).strip == N_FECS - 1);
+        CHECK(mapper.get_strip_id(N_FECS - 1, 0, 1).plane == srs::common::UNMAPPED_PLANE_ID);
+    }
+
+    SECTION("check_zero_suppression")
+    {
+        const auto filename = std::string{ "unit_test_pedestal.txt" };
+        {
+            auto pedestal_file = std::ofstream{ filename, std::ios::trunc };
+            pedestal_file << "# fec vmm channel pedestal noise\n"
+                          << "0 0 0 100 5\n";
+        }
+        const auto use_calibration = GENERATE(true, false);
+        INFO("calibration file: " << use_calibration);
+        auto processor = process::StructProcessor{
+            1,
+            { .zero_suppression = { .n_sigma = 3.,
+                                    .pedestal_filename = use_calibration ? filename : std::string{},
+                                    .is_pedestal_subtracted = true } }
+        };
+        auto input_data = StructData{};
+        auto input_converter = [&input_data](std::size_t /*line_number*/ = 0) -> const StructData*
+        { return &input_data; };
+
+        if (not use_calibration)
+        {
+            // Hits alternating between 95 and 105 give the pedestal of 100 and the noise of 5.
+            for (const auto idx : std::views::iota(uint32_t{}, srs::common::PEDESTAL_WARM_UP_SAMPLES))
+            {
+                input_data.hit_data.emplace_back().adc = static_cast<uint16_t>(idx % 2 == 0 ? 95 : 105);
+            }
+            auto output = processor.run(input_converter);
+            REQUIRE(output.has_value());
+            CHECK(output.value()->hit_data.size() == srs::common::PEDESTAL_WARM_UP_SAMPLES);
+            srs::reset_struct_data(input_data);
+        }
+
+        // The threshold is about 115. Inputs are well away from it such that the rounding doesn't matter.
+        for (const auto adc : { 105, 140, 108, 125 })
+        {
+            input_data.hit_data.emplace_back().adc = static_cast<uint16_t>(adc);
+        }
+        auto output = processor.run(input_converter);
+        REQUIRE(output.has_value());
+        const auto& hits = output.value()->hit_data;
+        REQUIRE(hits.size() == 2);
+        CHECK(hits[0].adc == 40);
+        CHECK(hits[1].adc == 25);
+    }
+
+    SECTION("check_event_building")
+    {
+        auto event_builder = process::EventBuilder{ { .window_ps = 100, .slice_ps = 1000 } };
+        auto make_frame = [](uint8_t fec_id, const std::vector<uint64_t>& hit_times) -> StructData
+        {
+            auto frame = StructData{};
+            frame.header.fec_id = fec_id;
+            frame.hit_time = hit_times;
+            frame.hit_data.resize(hit_times.size());
+            return frame;
+        };
+
+        auto frame = make_frame(1, { 150, 100, 1200 });
+        event_builder.process(frame);
+        CHECK(frame.events.empty());
+        frame = make_frame(2, { 120, 400, 1210 });
+        event_builder.process(frame);
+        CHECK(frame.events.empty());
+
+        // Slices 0 and 1 are closed once both FECs have hits in slice 3.
+        frame = make_frame(1, { 3500 });
+        event_builder.process(frame);
+        CHECK(frame.events.empty());
+        frame = make_frame(2, { 3600 });
+        event_builder.process(frame);
+        REQUIRE(frame.events.size() == 3);
+        auto get_times = [](const srs::EventData& event)
+        { return event.hits | std::views::transform(&srs::EventHitData::time) | std::ranges::to<std::vector>(); };
+        CHECK(get_times(frame.events[0]) == std::vector<uint64_t>{ 100, 120, 150 });
+        CHECK(frame.events[0].hits[1].fec_id == 2);
+        CHECK(get_times(frame.events[1]) == std::vector<uint64_t>{ 400 });
+        CHECK(get_times(frame.events[2]) == std::vector<uint64_t>{ 1200, 1210 });
+
+        // Hits of the closed slices are dropped.
+        frame = make_frame(2, { 500 });
+        event_builder.process(frame);
+        CHECK(frame.events.empty());
+        CHECK(event_builder.get_n_late_hits() == 1);
+
+        // The last slice is built at the end of the run.
+        const auto last_events = event_builder.flush();
+        REQUIRE(last_events.size() == 1);
+        CHECK(get_times(last_events[0]) == std::vector<uint64_t>{ 3500, 3600 });
+        CHECK(event_builder.flush().empty());
+    }
+
+    SECTION("check_event_flush")
+    {
+        auto processor = process::StructProcessor{ 1, { .event_building = { .window_ps = 100 } } };
+        auto input_data = StructData{};
+        input_data.hit_data.emplace_back().bc_id = 40;
+        auto input_converter = [&input_data](std::size_t /*line_number*/ = 0) -> const StructData*
+        { return &input_data; };
+        auto output = processor.run(input_converter);
+        REQUIRE(output.has_value());
+        CHECK(output.value()->events.empty());
+
+        // The pending event is attached to an additional frame without hits.
+        REQUIRE(processor.flush_events(0));
+        const auto* last_frame = processor(0);
+        REQUIRE(last_frame != nullptr);
+        CHECK(last_frame->hit_data.empty());
+        REQUIRE(last_frame->events.size() == 1);
+        REQUIRE(last_frame->events[0].hits.size() == 1);
+        CHECK(last_frame->events[0].hits[0].time == 40 * srs::common::DEFAULT_BC_CLOCK_PERIOD_PS);
+        CHECK_FALSE(processor.flush_events(0));
+    }
+
+    SECTION("check_event_building_outliers")
+    {
+        auto event_builder =
+            process::EventBuilder{ { .window_ps = 100, .slice_ps = 1000, .max_hit_spread_ps = 10'000 } };
+        auto frame = StructData{};
+        frame.header.fec_id = 1;
+        frame.hit_time = { 100, 1'000'000'000 };
+        frame.hit_data.resize(frame.hit_time.size());
+
+        // The outlier doesn't close the slice of the other hit.
+        event_builder.process(frame);
+        CHECK(frame.events.empty());
+        CHECK(event_builder.get_n_outlier_hits() == 1);
+
+        frame.hit_time = { 3500 };
+        frame.hit_data.resize(1);
+        event_builder.process(frame);
+        REQUIRE(frame.events.size() == 1);
+        REQUIRE(frame.events[0].hits.size() == 1);
+        CHECK(frame.events[0].hits[0].time == 100);
+        CHECK(event_builder.get_n_late_hits() == 0);
+    }
+
+    SECTION("check_event_building_early_outlier")
+    {
+        auto event_builder =
+            process::EventBuilder{ { .window_ps = 1000, .slice_ps = 1000, .max_hit_spread_ps = 10'000 } };
+        auto frame = StructData{};
+        frame.header.fec_id = 1;
+        // Only the hit with the corrupted early timestamp is dropped.
+        frame.hit_time = { 1'000'000, 10, 1'000'100, 1'000'200 };
+        frame.hit_data.resize(frame.hit_time.size());
+        event_builder.process(frame);
+        CHECK(frame.events.empty());
+        CHECK(event_builder.get_n_outlier_hits() == 1);
+
+        frame.hit_time = { 1'003'500 };
+        frame.hit_data.resize(1);
+        event_builder.process(frame);
+        REQUIRE(frame.events.size() == 1);
+        CHECK(frame.events[0].hits.size() == 3);
+        CHECK(frame.events[0].hits[0].time == 1'000'000);
+        CHECK(event_builder.get_n_outlier_hits() == 1);
+    }
+
+    SECTION("check_strip_clustering")
+    {
+        auto clusterer = process::StripClusterer{ 1, { .time_window_ps = 100, .max_strip_gap = 1 } };
+        auto frame = StructData{};
+        auto add_hit = [&frame](uint64_t time, uint8_t plane, uint16_t strip, uint16_t adc)
+        {
+            frame.hit_data.emplace_back().adc = adc;
+            frame.hit_time.push_back(time);
+            frame.hit_plane.push_back(plane);
+            frame.hit_strip.push_back(strip);
+        };
+        add_hit(120, 0, 11, 300);
+        add_hit(100, 0, 10, 100);
+        add_hit(110, 0, 13, 50);
+        add_hit(105, 1, 10, 20);
+        add_hit(500, 0, 12, 70);
+        add_hit(100, srs::common::UNMAPPED_PLANE_ID, srs::common::UNMAPPED_STRIP_ID, 10);
+
+        clusterer.process(frame, 0);
+        REQUIRE(frame.clusters.size() == 4);
+        const auto& first_cluster = frame.clusters.front();
+        CHECK(first_cluster.plane == 0);
+        CHECK(first_cluster.time == 100);
+        CHECK(first_cluster.charge == 400);
+        CHECK(first_cluster.size == 2);
+        CHECK(first_cluster.centroid == 10.75F);
+        auto get_centroids = frame.clusters | std::views::transform(&srs::ClusterData::centroid);
+        CHECK(std::ranges::equal(get_centroids, std::array{ 10.75F, 13.F, 12.F, 10.F }));
+        CHECK(frame.clusters.back().plane == 1);
+
+        // Clusters are kept in the column-oriented protobuf message.
+        auto packed_data = srs::proto::PackedData{};
+        process::Struct2PackedProtoConverter::convert(frame, packed_data);
+        auto binary_data = std::string{};
+        REQUIRE(packed_data.SerializeToString(&binary_data));
+        auto msg_reader = srs::reader::ProtoMsg{};
+        CHECK(msg_reader.convert(binary_data).clusters == frame.clusters);
+    }
+
+    SECTION("check_cluster_only_output")
+    {
+        const auto filename = std::string{ "unit_test_cluster_mapping.txt" };
+        {
+            auto mapping_file = std::ofstream{ filename, std::ios::trunc };
+            mapping_file << "0 0 0 0 10\n"
+                         << "0 0 1 0 11\n";
+        }
+        auto processor = process::StructProcessor{
+            1,
+            { .channel_mapping_filename = filename,
+              .clustering = { .time_window_ps = 100'000, .max_strip_gap = 1, .is_hit_dropped = true } }
+        };
+        auto input_data = StructData{};
+        for (const auto [channel_num, adc] : std::array{ std::pair{ 0, 100 }, std::pair{ 1, 50 } })
+        {
+            auto& hit = input_data.hit_data.emplace_back();
+            hit.channel_num = static_cast<uint8_t>(channel_num);
+            hit.adc = static_cast<uint16_t>(adc);
+        }
+        auto input_converter = [&input_data](std::size_t /*line_number*/ = 0) -> const StructData*
+        { return &input_data; };
+
+        const auto output = processor.run(input_converter);
+        REQUIRE(output.has_value());
+        const auto& output_data = *output.value();
+        REQUIRE(output_data.clusters.size() == 1);
+        CHECK(output_data.clusters.front().size == 2);
+        CHECK(output_data.clusters.front().charge == 150);
+        CHECK(output_data.hit_data.empty());
+        CHECK(output_data.hit_time.empty());
+        CHECK(output_data.hit_plane.empty());
+        CHECK(output_data.hit_strip.empty());
+        CHECK(input_data.hit_data.size() == 2);
+    }
+
+    SECTION("check_coincidence_trigger")
+    {
+        const auto is_event_triggered = GENERATE(false, true);
+        INFO("event triggered: " << is_event_triggered);
+        auto trigger = process::CoincidenceTrigger{
+            1, { .rules = { { .planes = { 0, 1 }, .window_ps = 100 } }, .is_event_triggered = is_event_triggered }
+        };
+        auto input_data = StructData{};
+        auto input_converter = [&input_data](std::size_t /*line_number*/ = 0) -> const StructData*
+        { return &input_data; };
+        auto set_hits = [&input_data](const std::vector<std::pair<uint64_t, uint8_t>>& hits)
+        {
+            srs::reset_struct_data(input_data);
+            input_data.hit_data.resize(hits.size());
+            auto& event = input_data.events.emplace_back();
+            for (const auto [time, plane] : hits)
+            {
+                input_data.hit_time.push_back(time);
+                input_data.hit_plane.push_back(plane);
+                input_data.hit_strip.push_back(0);
+                auto& event_hit = event.hits.emplace_back();
+                event_hit.time = time;
+                event_hit.plane = plane;
+            }
+        };
+
+        set_hits({ { 0, 0 }, { 50, 2 }, { 150, 1 }, { 300, 0 }, { 390, 1 } });
+        auto output = trigger.run(input_converter);
+        REQUIRE(output.has_value());
+        if (is_event_triggered)
+        {
+            CHECK(output.value()->events == input_data.events);
+        }
+        else
+        {
+            CHECK(output.value() == &input_data);
+        }
+
+        set_hits({ { 0, 0 }, { 50, 2 }, { 150, 1 }, { 300, 0 }, { 401, 1 } });
+        CHECK(not trigger.run(input_converter).has_value());
+
+        const auto trigger_stat = trigger.get_trigger_stat();
+        CHECK(trigger_stat.n_accepted_frames == 1);
+        CHECK(trigger_stat.n_rejected_frames == 1);
+
+        if (is_event_triggered)
+        {
+            // Only the accepted event is forwarded, without the unrelated hits and markers of the frame.
+            set_hits({ { 0, 0 }, { 10, 1 } });
+            input_data.header.fec_id = 2;
+            input_data.marker_data.emplace_back();
+            input_data.events.emplace_back().hits.emplace_back().plane = 0;
+            output = trigger.run(input_converter);
+            REQUIRE(output.has_value());
+            const auto& output_data = *output.value();
+            REQUIRE(output_data.events.size() == 1);
+            CHECK(output_data.events.front() == input_data.events.front());
+            CHECK(output_data.header == input_data.header);
+            CHECK(output_data.hit_data.empty());
+            CHECK(output_data.hit_time.empty());
+            CHECK(output_data.marker_data.empty());
+            CHECK(input_data.events.size() == 2);
+            CHECK(input_data.hit_data.size() == 2);
+        }
+    }
+
+    SECTION("check_filter_expression")
+    {
+        auto input_data = StructData{};
+        input_data.header.fec_id = 2;
+        for (const auto [vmm_id, adc] : std::array{ std::pair{ 3, 250 }, std::pair{ 1, 300 }, std::pair{ 0, 100 } })
+        {
+            auto& hit = input_data.hit_data.emplace_back();
+            hit.vmm_id = static_cast<uint8_t>(vmm_id);
+            hit.adc = static_cast<uint16_t>(adc);
+        }
+        input_data.hit_time = { 10, 20, 30 };
+        auto input_converter = [&input_data](std::size_t /*line_number*/ = 0) -> const StructData*
+        { return &input_data; };
+
+        auto frame_filter = process::ExpressionFilter{ 1, "frame_output", "fec_id == 2 && !(n_hits < 3)" };
+        CHECK(not frame_filter.get_expression().is_hit_level());
+        auto output = frame_filter.run(input_converter);
+        REQUIRE(output.has_value());
+        CHECK(output.value() == &input_data);
+
+        auto hit_filter = process::ExpressionFilter{ 1, "hit_output", "adc > 200 && vmm_id in [0,3] || time == 30" };
+        CHECK(hit_filter.get_expression().is_hit_level());
+        output = hit_filter.run(input_converter);
+        REQUIRE(output.has_value());
+        CHECK(output.value()->hit_time == std::vector<uint64_t>{ 10, 30 });
+        REQUIRE(output.value()->hit_data.size() == 2);
+        CHECK(output.value()->hit_data[0].adc == 250);
+
+        input_data.header.fec_id = 1;
+        CHECK(not frame_filter.run(input_converter).has_value());
+
+        // Frame fields in a hit-level expression are the same for all hits. Missing plane IDs are unmapped.
+        auto buffers = process::FilterExpression::Buffers{};
+        const auto mixed_expression = process::FilterExpression{ "!(fec_id == 1 && adc < 280) || plane == 255" };
+        const auto passed_hits = mixed_expression.evaluate(input_data, buffers);
+        CHECK(std::ranges::equal(passed_hits, std::array<uint8_t, 3>{ 1, 1, 1 }));
+        const auto unmapped_expression = process::FilterExpression{ "!(fec_id == 1 && adc < 280) && plane != 255" };
+        CHECK(std::ranges::equal(unmapped_expression.evaluate(input_data, buffers), std::array<uint8_t, 3>{ 0, 0, 0 }));
+        const auto adc_expression = process::FilterExpression{ "!(fec_id == 1 && adc < 280)" };
+        CHECK(std::ranges::equal(adc_expression.evaluate(input_data, buffers), std::array<uint8_t, 3>{ 0, 1, 0 }));
+
+        for (const auto* expression : { "adc >", "foo == 1", "adc == 1 &&", "adc in [1,", "(adc == 1", "adc = 1" })
+        {
+            INFO("expression: " << expression);
+            CHECK_THROWS_AS(process::FilterExpression{ expression }, std::runtime_error);
+        }
+    }
+
+    SECTION("check_packed_proto_conversion")
+    {
+        const auto random_data = generate_random_struct_data();
+
+        auto packed_data = srs::proto::PackedData{};
+        process::Struct2PackedProtoConverter::convert(random_data, packed_data);
+        auto binary_data = std::string{};
+        REQUIRE(packed_data.SerializeToString(&binary_data));
+
+        auto msg_reader = srs::reader::ProtoMsg{};
+        const auto& output_struct = msg_reader.convert(binary_data);
+        // vmm_tag is not part of the protobuf message
+        CHECK(random_data.header.frame_counter == output_struct.header.frame_counter);
+        CHECK(random_data.header.udp_timestamp == output_struct.header.udp_timestamp);
+        CHECK(random_data.marker_data == output_struct.marker_data);
+        CHECK(random_data.hit_data == output_struct.hit_data);
+    }
+
+    SECTION("check_flat_conversion")
+    {
+        const auto random_data = generate_random_struct_data();
+
+        auto binary_data = std::vector<char>{};
+        process::Struct2FlatConverter::convert(random_data, binary_data);
+
+        auto msg_reader = srs::reader::FlatMsg{};
+        auto output_struct = msg_reader.convert(std::string_view{ binary_data.data(), binary_data.size() });
+        if (not output_struct)
+        {
+            UNSCOPED_INFO(output_struct.error());
+        }
+        REQUIRE(output_struct.has_value());
+        CHECK(random_data == *output_struct.value());
+    }
+}
+
+TEST_CASE("Compressed Protobuf frames")
+{
+    using enum srs::common::CompressionType;
+    static constexpr auto N_FRAMES = 10;
+    const auto options = GENERATE(srs::sink::StreamCompressor::Options{ .type = none },
+                                  srs::sink::StreamCompressor::Options{ .type = gzip },
+                                  srs::sink::StreamCompressor::Options{ .type = zstd },
+                                  srs::sink::StreamCompressor::Options{ .type = zstd, .dict_n_frames = 4 },
+                                  srs::sink::StreamCompressor::Options{ .type = lz4 });
+    INFO("compression: " << magic_enum::enum_name(options.type) << ", dictionary frames: " << options.dict_n_frames);
+
+    const auto filename = std::string{ "unit_test_compressed.pbc" };
+    auto input_data = std::vector<StructData>{};
+    {
+        auto output_file = std::ofstream{ filename, std::ios::trunc | std::ios::binary };
+        auto compressor = srs::sink::StreamCompressor{ options, output_file };
+        auto packed_data = srs::proto::PackedData{};
+        auto binary_data = std::string{};
+        for ([[maybe_unused]] auto idx : std::views::iota(0, N_FRAMES))
+        {
+            const auto& struct_data = input_data.emplace_back(generate_random_struct_data());
+            packed_data.Clear();
+            binary_data.clear();
+            process::Struct2PackedProtoConverter::convert(struct_data, packed_data);
+            auto output_stream = google::protobuf::io::StringOutputStream{ &binary_data };
+            REQUIRE(google::protobuf::util::SerializeDelimitedToZeroCopyStream(packed_data, &output_stream));
+            compressor.write(binary_data);
+        }
+        compressor.finish();
+    }
+
+    auto frame_reader = srs::reader::ProtoFrame{ filename };
+    for (const auto& struct_data : input_data)
+    {
+        auto output_struct = frame_reader.read_one_frame();
+        if (not output_struct)
+        {
+            UNSCOPED_INFO(output_struct.error());
+        }
+        REQUIRE(output_struct.has_value());
+        REQUIRE(output_struct.value() != nullptr);
+        CHECK(struct_data.marker_data == output_struct.value()->marker_data);
+        CHECK(struct_data.hit_data == output_struct.value()->hit_data);
+    }
+    auto end_of_file = frame_reader.read_one_frame();
+    REQUIRE(end_of_file.has_value());
+    CHECK(end_of_file.value() == nullptr);
 }
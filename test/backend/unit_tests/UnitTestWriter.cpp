@@ -1,11 +1,61 @@
 #include "srs/converters/DataConvertOptions.hpp"
+#include "srs/converters/FrameHeaderParser.hpp"
+#include "srs/converters/RawToDelimRawConveter.hpp"
+#include "srs/converters/StructDeserializer.hpp"
+#include "srs/data/SRSDataStructs.hpp"
+#include "srs/mergers/FrameMerger.hpp"
+#include "srs/readers/CompactFileReader.hpp"
+#include "srs/readers/FrameIndex.hpp"
+#include "srs/readers/RawFrameReader.hpp"
 #include "srs/sinks/BinaryFileWriter.hpp"
+#include "srs/sinks/BlockCompressor.hpp"
+#include "srs/sinks/CompactFileWriter.hpp"
+#include "srs/sinks/FileRotator.hpp"
 #include "srs/sinks/JsonWriter.hpp"
+#include "srs/sinks/ScatterFile.hpp"
 #include "srs/sinks/UDPWriter.hpp"
 #include "srs/sinks/WriterConcept.hpp"
+#include <algorithm>
+#include <array>
 #include <asio/ip/udp.hpp>
 #include <asio/thread_pool.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_message.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fmt/format.h>
+#include <fstream>
+#include <ios>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <sys/stat.h>
+#include <utility>
+#include <vector>
+#include <zpp_bits.h>
+
+#ifdef HAS_ROOT
+#include "srs/sinks/RootFileWriter.hpp"
+#include <TFile.h>
+#include <TTree.h>
+#include <memory>
+#endif
+
+#ifdef HAS_ARROW
+#include "srs/sinks/ArrowFileWriter.hpp"
+#include <arrow/api.h>
+#include <arrow/io/file.h>
+#include <arrow/ipc/reader.h>
+#include <memory>
+#include <parquet/arrow/reader.h>
+#include <parquet/file_reader.h>
+#endif
 
 namespace sink = srs::sink;
 namespace process = srs::process;
@@ -17,8 +67,825 @@ TEST_CASE("binary_writer")
     sink::WritableFile auto binary_writer = sink::BinaryFile{ "unit_test.bin", raw_frame, 1 };
 }
 
+TEST_CASE("binary_writer_scatter_gather")
+{
+    static constexpr auto N_FRAMES = 100;
+    const auto filename = std::string{ "unit_test_scattered.bin" };
+
+    auto input_frames = std::vector<std::string>{};
+    {
+        auto binary_writer = sink::BinaryFile{ filename, raw_frame, 1 };
+        auto delimiter_converter = process::Raw2DelimRawConverter{};
+        for (auto idx : std::views::iota(0, N_FRAMES))
+        {
+            const auto& frame =
+                input_frames.emplace_back(static_cast<std::size_t>(idx % 50) + 1, static_cast<char>('a' + (idx % 26)));
+            auto frame_converter = [&frame](std::size_t /*line_number*/ = 0) -> std::string_view { return frame; };
+            REQUIRE(delimiter_converter.run(frame_converter, 0).has_value());
+            REQUIRE(binary_writer.run(delimiter_converter).has_value());
+        }
+    }
+
+    auto frame_reader = srs::reader::RawFrame{ filename };
+    for (const auto& frame : input_frames)
+    {
+        auto output_frame = frame_reader.read_one_frame();
+        REQUIRE(output_frame.has_value());
+        CHECK(output_frame.value() == frame);
+    }
+}
+
+TEST_CASE("scatter_file_coalescing")
+{
+    static constexpr auto N_SMALL_FRAMES = 100;
+    const auto filename = std::string{ "unit_test_coalesced.bin" };
+    const auto prefix = std::string{ "prefix" };
+    const auto small_frame = std::string(std::size_t{ 50 }, 'a');
+    const auto large_frame = std::string(sink::ScatterFile::COALESCE_SIZE, 'b');
+
+    auto expected_content = std::string{};
+    {
+        auto scatter_file = sink::ScatterFile{ filename };
+        for ([[maybe_unused]] auto _ : std::views::iota(0, N_SMALL_FRAMES))
+        {
+            REQUIRE(scatter_file.write(std::array<std::string_view, 2>{ prefix, small_frame }));
+            expected_content += prefix + small_frame;
+        }
+        // Small frames are kept in the buffer.
+        CHECK(scatter_file.get_n_system_calls() == 0);
+
+        // A large frame is written together with the buffered ones.
+        REQUIRE(scatter_file.write(std::array<std::string_view, 2>{ prefix, large_frame }));
+        expected_content += prefix + large_frame;
+        CHECK(scatter_file.get_n_system_calls() == 1);
+
+        REQUIRE(scatter_file.write(std::array<std::string_view, 2>{ prefix, small_frame }));
+        expected_content += prefix + small_frame;
+    }
+
+    auto input_file = std::ifstream{ filename, std::ios::binary };
+    const auto content = std::string{ std::istreambuf_iterator<char>{ input_file }, std::istreambuf_iterator<char>{} };
+    CHECK(content == expected_content);
+}
+
+TEST_CASE("binary_writer_direct_io")
+{
+    static constexpr auto N_FRAMES = 2000;
+    static constexpr auto PREALLOCATION_SIZE = std::size_t{ 1024 } * 1024;
+    static constexpr auto DISK_BLOCK_SIZE = 512; // unit of st_blocks
+    const auto filename = std::string{ "unit_test_direct.bin" };
+
+    auto input_frames = std::vector<std::string>{};
+    {
+        auto binary_writer = sink::BinaryFile{
+            filename,
+            raw_frame,
+            1,
+            {},
+            { .buffer_size = sink::DirectFile::ALIGNMENT, .n_buffers = 2, .preallocation_size = PREALLOCATION_SIZE }
+        };
+        auto delimiter_converter = process::Raw2DelimRawConverter{};
+        for (auto idx : std::views::iota(0, N_FRAMES))
+        {
+            const auto& frame =
+                input_frames.emplace_back(static_cast<std::size_t>(idx % 100) + 1, static_cast<char>('a' + (idx % 26)));
+            auto frame_converter = [&frame](std::size_t /*line_number*/ = 0) -> std::string_view { return frame; };
+            REQUIRE(delimiter_converter.run(frame_converter, 0).has_value());
+            REQUIRE(binary_writer.run(delimiter_converter).has_value());
+        }
+    }
+
+    auto frame_reader = srs::reader::RawFrame{ filename };
+    for (const auto& frame : input_frames)
+    {
+        auto output_frame = frame_reader.read_one_frame();
+        REQUIRE(output_frame.has_value());
+        CHECK(output_frame.value() == frame);
+    }
+    auto end_of_file = frame_reader.read_one_frame();
+    REQUIRE(end_of_file.has_value());
+    CHECK(end_of_file.value().empty());
+
+    // The space preallocated past the end of the data is released when the file is closed.
+    struct stat file_stat{};
+    REQUIRE(::stat(filename.c_str(), &file_stat) == 0);
+    const auto file_size = static_cast<std::size_t>(file_stat.st_size);
+    INFO(fmt::format("file size: {}, allocated blocks: {}", file_size, file_stat.st_blocks));
+    CHECK(file_size < PREALLOCATION_SIZE);
+    CHECK(static_cast<std::size_t>(file_stat.st_blocks) * DISK_BLOCK_SIZE <= file_size + sink::DirectFile::ALIGNMENT);
+}
+
+TEST_CASE("binary_writer_rotation")
+{
+    static constexpr auto N_FRAMES = 100;
+    static constexpr auto MAX_FILE_SIZE = std::size_t{ 1000 };
+    const auto filename = std::string{ "unit_test_rotated.bin" };
+
+    auto input_frames = std::vector<std::string>{};
+    auto n_files = 0;
+    {
+        auto binary_writer = sink::BinaryFile{ filename, raw_frame, 1, {}, {}, { .max_file_size = MAX_FILE_SIZE } };
+        auto delimiter_converter = process::Raw2DelimRawConverter{};
+        auto file_size = std::size_t{};
+        for (auto idx : std::views::iota(0, N_FRAMES))
+        {
+            const auto& frame =
+                input_frames.emplace_back(static_cast<std::size_t>(idx % 50) + 1, static_cast<char>('a' + (idx % 26)));
+            auto frame_converter = [&frame](std::size_t /*line_number*/ = 0) -> std::string_view { return frame; };
+            REQUIRE(delimiter_converter.run(frame_converter, 0).has_value());
+            REQUIRE(binary_writer.run(delimiter_converter).has_value());
+            file_size += frame.size() + sizeof(uint32_t);
+            if (file_size >= MAX_FILE_SIZE)
+            {
+                ++n_files;
+                file_size = 0;
+            }
+        }
+        // The last file is opened even if it's empty.
+        ++n_files;
+    }
+
+    auto input_frame = input_frames.begin();
+    for (auto file_idx : std::views::iota(0, n_files))
+    {
+        const auto rotated_filename = fmt::format("unit_test_rotated.{:04}.bin", file_idx);
+        INFO(rotated_filename);
+        REQUIRE(std::filesystem::file_size(rotated_filename) <= MAX_FILE_SIZE + 50 + sizeof(uint32_t));
+        auto frame_reader = srs::reader::RawFrame{ rotated_filename };
+        for (auto output_frame = frame_reader.read_one_frame(); output_frame.has_value() and not output_frame->empty();
+             output_frame = frame_reader.read_one_frame())
+        {
+            REQUIRE(input_frame != input_frames.end());
+            CHECK(output_frame.value() == *input_frame);
+            ++input_frame;
+        }
+    }
+    CHECK(input_frame == input_frames.end());
+}
+
+TEST_CASE("file_rotator_post_close_command")
+{
+    static constexpr auto N_FILES = 3;
+    static constexpr auto MAX_CLOSE_INTERVAL = std::chrono::milliseconds{ 500 };
+
+    auto close_times = std::vector<std::chrono::steady_clock::time_point>{};
+    auto filenames = std::vector<std::string>{};
+    auto rotator = sink::FileRotator{ "unit_test_post_close.bin",
+                                      1,
+                                      { .max_file_size = 1, .post_close_command = R"(sleep 1 && touch "$1.done")" } };
+    for ([[maybe_unused]] auto _ : std::views::iota(0, N_FILES))
+    {
+        filenames.push_back(rotator.get_filename(0));
+        std::filesystem::remove(filenames.back() + ".done");
+        rotator.rotate(0,
+                       [&close_times]()
+                       {
+                           close_times.push_back(std::chrono::steady_clock::now());
+                           return std::size_t{};
+                       });
+    }
+    rotator.wait();
+
+    // Files are closed without waiting for the commands of the previous files.
+    REQUIRE(close_times.size() == N_FILES);
+    CHECK(close_times.back() - close_times.front() < MAX_CLOSE_INTERVAL);
+    CHECK(rotator.get_stats().front().n_files == N_FILES);
+    CHECK(rotator.get_stats().front().n_failed_commands == 0);
+    for (const auto& filename : filenames)
+    {
+        INFO(filename);
+        CHECK(std::filesystem::exists(filename + ".done"));
+    }
+}
+
+TEST_CASE("binary_writer_frame_index")
+{
+    static constexpr auto N_FRAMES = 1000;
+    static constexpr auto INDEX_INTERVAL = std::size_t{ 10 };
+    static constexpr auto N_FECS = 3;
+    static constexpr auto TIME_STEP = uint32_t{ 10 };
+    const auto filename = std::string{ "unit_test_indexed.bin" };
+
+    auto input_frames = std::vector<std::string>{};
+    {
+        auto binary_writer = sink::BinaryFile{ filename, raw_frame, 1, {}, {}, {}, INDEX_INTERVAL };
+        auto delimiter_converter = process::Raw2DelimRawConverter{};
+        for (auto idx : std::views::iota(0, N_FRAMES))
+        {
+            auto frame_header = std::array<char, 16>{};
+            auto serialize_to = zpp::bits::out{ frame_header, zpp::bits::endian::network{}, zpp::bits::no_size{} };
+            serialize_to(static_cast<uint32_t>(idx),
+                         std::array{ 'V', 'M', '3' },
+                         static_cast<uint8_t>(idx % N_FECS),
+                         static_cast<uint32_t>(idx) * TIME_STEP)
+                .or_throw();
+            auto& frame = input_frames.emplace_back(frame_header.size() + static_cast<std::size_t>(idx % 37), 'a');
+            std::ranges::copy(frame_header, frame.begin());
+            auto frame_converter = [&frame](std::size_t /*line_number*/ = 0) -> std::string_view { return frame; };
+            REQUIRE(delimiter_converter.run(frame_converter, 0).has_value());
+            REQUIRE(binary_writer.run(delimiter_converter).has_value());
+        }
+    }
+
+    const auto index = srs::reader::FrameIndex{ filename };
+    CHECK(index.get_interval() == INDEX_INTERVAL);
+    // Each FEC is indexed at its first frame and then every INDEX_INTERVAL frames of its own.
+    static constexpr auto N_FEC_ENTRIES = ((N_FRAMES / N_FECS) + INDEX_INTERVAL - 1) / INDEX_INTERVAL;
+    REQUIRE(index.get_entries().size() == N_FECS * N_FEC_ENTRIES);
+    CHECK(index.get_data_size() == std::filesystem::file_size(filename));
+
+    auto frame_reader = srs::reader::RawFrame{ filename };
+    for (auto frame_number : { 0, 1, 57, 500, N_FRAMES - 1 })
+    {
+        INFO(frame_number);
+        REQUIRE(frame_reader.seek_frame(index, static_cast<uint64_t>(frame_number)).has_value());
+        auto output_frame = frame_reader.read_one_frame();
+        REQUIRE(output_frame.has_value());
+        CHECK(output_frame.value() == input_frames.at(static_cast<std::size_t>(frame_number)));
+    }
+    CHECK(not frame_reader.seek_frame(index, N_FRAMES + 1).has_value());
+
+    // The first frame of FEC 2 at or after the timestamp 5003 is the frame 503.
+    REQUIRE(frame_reader.seek_time(index, 2, 5003).has_value());
+    auto output_frame = frame_reader.read_one_frame();
+    REQUIRE(output_frame.has_value());
+    CHECK(output_frame.value() == input_frames.at(503));
+    CHECK(not frame_reader.seek_fec(index, N_FECS).has_value());
+
+    auto n_frames = std::size_t{};
+    for (const auto& byte_range : index.split(4))
+    {
+        CHECK(byte_range.first_frame == n_frames);
+        REQUIRE(frame_reader.seek(byte_range.begin).has_value());
+        while (frame_reader.get_offset() < byte_range.end)
+        {
+            output_frame = frame_reader.read_one_frame();
+            REQUIRE(output_frame.has_value());
+            REQUIRE(n_frames < input_frames.size());
+            CHECK(output_frame.value() == input_frames[n_frames]);
+            ++n_frames;
+        }
+    }
+    CHECK(n_frames == N_FRAMES);
+}
+
+TEST_CASE("binary_writer_frame_index_interleaved_fecs")
+{
+    static constexpr auto N_FRAMES = 100;
+    static constexpr auto INDEX_INTERVAL = std::size_t{ 10 };
+    static constexpr auto N_FECS = 2;
+    // FEC 1 starts after a few frames of FEC 0.
+    static constexpr auto FEC1_FIRST_FRAME = 3;
+    const auto filename = std::string{ "unit_test_indexed_fecs.bin" };
+
+    auto input_frames = std::vector<std::string>{};
+    {
+        auto binary_writer = sink::BinaryFile{ filename, raw_frame, 1, {}, {}, {}, INDEX_INTERVAL };
+        auto delimiter_converter = process::Raw2DelimRawConverter{};
+        for (auto idx : std::views::iota(0, N_FRAMES))
+        {
+            const auto fec_id = (idx < FEC1_FIRST_FRAME) ? 0 : idx % N_FECS;
+            auto frame_header = std::array<char, 16>{};
+            auto serialize_to = zpp::bits::out{ frame_header, zpp::bits::endian::network{}, zpp::bits::no_size{} };
+            serialize_to(static_cast<uint32_t>(idx),
+                         std::array{ 'V', 'M', '3' },
+                         static_cast<uint8_t>(fec_id),
+                         static_cast<uint32_t>(idx))
+                .or_throw();
+            auto& frame = input_frames.emplace_back(frame_header.size(), 'a');
+            std::ranges::copy(frame_header, frame.begin());
+            auto frame_converter = [&frame](std::size_t /*line_number*/ = 0) -> std::string_view { return frame; };
+            REQUIRE(delimiter_converter.run(frame_converter, 0).has_value());
+            REQUIRE(binary_writer.run(delimiter_converter).has_value());
+        }
+    }
+
+    const auto index = srs::reader::FrameIndex{ filename };
+    for (auto fec_id : std::views::iota(0, N_FECS))
+    {
+        INFO(fec_id);
+        const auto fec_entries = std::ranges::count(index.get_entries(), fec_id, &srs::reader::FrameIndexEntry::fec_id);
+        CHECK(fec_entries > 1);
+    }
+
+    auto frame_reader = srs::reader::RawFrame{ filename };
+    for (auto [fec_id, first_frame] : { std::pair{ 0, 0 }, std::pair{ 1, FEC1_FIRST_FRAME } })
+    {
+        INFO(fec_id);
+        REQUIRE(frame_reader.seek_fec(index, static_cast<uint8_t>(fec_id)).has_value());
+        auto output_frame = frame_reader.read_one_frame();
+        REQUIRE(output_frame.has_value());
+        CHECK(output_frame.value() == input_frames.at(static_cast<std::size_t>(first_frame)));
+    }
+}
+
+TEST_CASE("binary_writer_block_compression")
+{
+    static constexpr auto N_FRAMES = 1000;
+    static constexpr auto BLOCK_SIZE = std::size_t{ 4096 };
+    const auto filename = std::string{ "unit_test_compressed.bin" };
+
+    auto input_frames = std::vector<std::string>{};
+    {
+        auto thread_pool = asio::thread_pool{ 4 };
+        auto output_file = std::ofstream{ filename, std::ios::trunc | std::ios::binary };
+        auto compressor = sink::BlockCompressor{ { .block_size = BLOCK_SIZE, .max_pending_blocks = 8 },
+                                                 thread_pool,
+                                                 output_file };
+        auto delimited_frame = std::vector<char>{};
+        for (auto idx : std::views::iota(0, N_FRAMES))
+        {
+            const auto& frame =
+                input_frames.emplace_back(static_cast<std::size_t>(idx % 100) + 1, static_cast<char>('a' + (idx % 26)));
+            delimited_frame.clear();
+            auto serialize_to = zpp::bits::out{ delimited_frame, zpp::bits::append{}, zpp::bits::endian::big{} };
+            serialize_to(static_cast<uint32_t>(frame.size()), zpp::bits::unsized(frame)).or_throw();
+            compressor.write(std::string_view{ delimited_frame.data(), delimited_frame.size() });
+        }
+        compressor.finish();
+    }
+
+    auto frame_reader = srs::reader::RawFrame{ filename, 4 };
+    REQUIRE(frame_reader.is_compressed());
+    for (const auto& frame : input_frames)
+    {
+        auto output_frame = frame_reader.read_one_frame();
+        if (not output_frame)
+        {
+            UNSCOPED_INFO(output_frame.error());
+        }
+        REQUIRE(output_frame.has_value());
+        CHECK(output_frame.value() == frame);
+    }
+    auto end_of_file = frame_reader.read_one_frame();
+    REQUIRE(end_of_file.has_value());
+    CHECK(end_of_file.value().empty());
+}
+
+TEST_CASE("frame_merger")
+{
+    static constexpr auto N_FRAMES_PER_FEC = 100;
+    static constexpr auto N_FECS = 2;
+    static constexpr auto N_INPUTS = 2;
+    static constexpr auto MISSING_COUNTER = 50;
+    static constexpr auto DUPLICATED_COUNTER = 20;
+    const auto output_filename = std::string{ "unit_test_merged.bin" };
+    auto input_filenames = std::vector<std::string>{};
+
+    {
+        auto binary_writers = std::vector<sink::BinaryFile>{};
+        for (auto input_idx : std::views::iota(0, N_INPUTS))
+        {
+            binary_writers.emplace_back(input_filenames.emplace_back(fmt::format("unit_test_split_{}.bin", input_idx)),
+                                        raw_frame,
+                                        1);
+        }
+        auto delimiter_converter = process::Raw2DelimRawConverter{};
+        auto write_frame = [&](uint32_t counter, uint8_t fec_id, std::size_t input_idx)
+        {
+            auto frame = std::string(process::FRAME_HEADER_BYTES + 10, 'a');
+            auto frame_header = std::array<char, process::FRAME_HEADER_BYTES>{};
+            auto serialize_to = zpp::bits::out{ frame_header, zpp::bits::endian::network{}, zpp::bits::no_size{} };
+            serialize_to(counter, std::array{ 'V', 'M', '3' }, fec_id, counter).or_throw();
+            std::ranges::copy(frame_header, frame.begin());
+            auto frame_converter = [&frame](std::size_t /*line_number*/ = 0) -> std::string_view { return frame; };
+            REQUIRE(delimiter_converter.run(frame_converter, 0).has_value());
+            REQUIRE(binary_writers.at(input_idx).run(delimiter_converter).has_value());
+        };
+
+        // Frames of each FEC are distributed to the input files in blocks of 3.
+        for (auto counter : std::views::iota(0, N_FRAMES_PER_FEC))
+        {
+            for (auto fec_id : std::views::iota(0, N_FECS))
+            {
+                if (fec_id == 1 and counter == MISSING_COUNTER)
+                {
+                    continue;
+                }
+                const auto input_idx = static_cast<std::size_t>((counter / 3 + fec_id) % N_INPUTS);
+                write_frame(static_cast<uint32_t>(counter), static_cast<uint8_t>(fec_id), input_idx);
+                if (fec_id == 0 and counter == DUPLICATED_COUNTER)
+                {
+                    const auto other_input_idx = (input_idx + 1) % N_INPUTS;
+                    write_frame(static_cast<uint32_t>(counter), static_cast<uint8_t>(fec_id), other_input_idx);
+                }
+            }
+        }
+    }
+
+    auto drop_duplicates = GENERATE(false, true);
+    INFO(fmt::format("drop duplicates: {}", drop_duplicates));
+    auto merger = srs::merger::FrameMerger{ input_filenames, output_filename, { .drop_duplicates = drop_duplicates } };
+    REQUIRE(merger.run().has_value());
+    const auto& stat = merger.get_stat();
+    CHECK(stat.n_frames == (N_FRAMES_PER_FEC * N_FECS));
+    CHECK(stat.n_gaps == 1);
+    CHECK(stat.n_missing_frames == 1);
+    CHECK(stat.n_duplicates == 1);
+    CHECK(stat.n_out_of_order == 0);
+    CHECK(stat.n_forced_writes == 0);
+
+    auto frame_reader = srs::reader::RawFrame{ output_filename };
+    auto n_frames = std::size_t{};
+    auto next_counters = std::array<uint32_t, N_FECS>{};
+    for (auto output_frame = frame_reader.read_one_frame(); output_frame.has_value() and not output_frame->empty();
+         output_frame = frame_reader.read_one_frame())
+    {
+        const auto header = process::parse_frame_header(output_frame.value());
+        REQUIRE(header.has_value());
+        REQUIRE(header->fec_id < N_FECS);
+        auto& next_counter = next_counters.at(header->fec_id);
+        if (header->fec_id == 0 and header->frame_counter == DUPLICATED_COUNTER and next_counter > DUPLICATED_COUNTER)
+        {
+            CHECK(not drop_duplicates);
+        }
+        else
+        {
+            CHECK(header->frame_counter == next_counter);
+        }
+        next_counter = header->frame_counter + ((header->fec_id == 1 and header->frame_counter + 1 == MISSING_COUNTER)
+                                                    ? 2
+                                                    : 1);
+        ++n_frames;
+    }
+    CHECK(n_frames == (N_FRAMES_PER_FEC * N_FECS) - (drop_duplicates ? 1 : 0));
+    CHECK(next_counters == std::array<uint32_t, N_FECS>{ N_FRAMES_PER_FEC, N_FRAMES_PER_FEC });
+}
+
+#ifdef HAS_ROOT
+TEST_CASE("root_writer_merged_lines")
+{
+    static constexpr auto N_LINES = std::size_t{ 3 };
+    static constexpr auto N_FRAMES = 500;
+    static constexpr auto MERGE_FLUSH_SIZE = std::size_t{ 4096 };
+    static constexpr auto ADC_VALUE = uint16_t{ 321 };
+    const auto filename = std::string{ "unit_test_merged.root" };
+
+    {
+        // Small flush size such that the memory files are merged many times during the writing.
+        auto root_writer = sink::RootFile{
+            filename, structure, N_LINES, { .is_merged = true, .merge_flush_size = MERGE_FLUSH_SIZE }
+        };
+        auto frames = std::vector<srs::StructData>(N_LINES);
+        auto frame_converter = [&frames](std::size_t line_number) -> const srs::StructData*
+        { return &frames[line_number]; };
+        for (auto idx : std::views::iota(0, N_FRAMES))
+        {
+            for (auto [line_number, data_struct] : std::views::zip(std::views::iota(std::size_t{ 0 }), frames))
+            {
+                data_struct.header.fec_id = static_cast<uint8_t>(line_number);
+                data_struct.header.frame_counter = static_cast<uint32_t>(idx);
+                data_struct.hit_data.assign(static_cast<std::size_t>(idx % 5) + 1, srs::HitData{ .adc = ADC_VALUE });
+                REQUIRE(root_writer.run(frame_converter, line_number).has_value());
+            }
+        }
+    }
+
+    auto input_file = std::unique_ptr<TFile>{ TFile::Open(filename.c_str(), "READ") };
+    REQUIRE(input_file != nullptr);
+    auto* tree = input_file->Get<TTree>("srs_data_tree");
+    REQUIRE(tree != nullptr);
+    REQUIRE(tree->GetEntries() == static_cast<int64_t>(N_LINES * N_FRAMES));
+
+    auto data_struct = srs::StructData{};
+    auto* data_struct_address = &data_struct;
+    tree->SetBranchAddress("srs_frame_data", &data_struct_address);
+    auto n_line_frames = std::vector<int>(N_LINES);
+    for (auto entry : std::views::iota(int64_t{ 0 }, tree->GetEntries()))
+    {
+        tree->GetEntry(entry);
+        REQUIRE(data_struct.header.fec_id < N_LINES);
+        ++n_line_frames[data_struct.header.fec_id];
+        REQUIRE(data_struct.hit_data.size() == (data_struct.header.frame_counter % 5) + 1);
+        CHECK(data_struct.hit_data.front().adc == ADC_VALUE);
+    }
+    tree->ResetBranchAddresses();
+    CHECK(std::ranges::all_of(n_line_frames, [](int n_frames) { return n_frames == N_FRAMES; }));
+}
+#endif
+
+#ifdef HAS_ARROW
+namespace
+{
+    // Table read back from the file and the number of rows of each row group or record batch
+    struct ArrowTable
+    {
+        std::shared_ptr<arrow::Table> table;
+        std::vector<int64_t> group_sizes;
+    };
+
+    auto read_arrow_table(const std::string& filename) -> ArrowTable
+    {
+        auto output = ArrowTable{};
+        auto input_file = arrow::io::ReadableFile::Open(filename).ValueOrDie();
+        if (filename.ends_with(".parquet"))
+        {
+            auto reader_builder = parquet::arrow::FileReaderBuilder{};
+            REQUIRE(reader_builder.Open(input_file).ok());
+            auto reader = std::unique_ptr<parquet::arrow::FileReader>{};
+            REQUIRE(reader_builder.Build(&reader).ok());
+            REQUIRE(reader->ReadTable(&output.table).ok());
+            const auto metadata = reader->parquet_reader()->metadata();
+            for (auto idx : std::views::iota(0, metadata->num_row_groups()))
+            {
+                output.group_sizes.push_back(metadata->RowGroup(idx)->num_rows());
+            }
+            return output;
+        }
+
+        auto reader = arrow::ipc::RecordBatchFileReader::Open(input_file).ValueOrDie();
+        auto batches = std::vector<std::shared_ptr<arrow::RecordBatch>>{};
+        for (auto idx : std::views::iota(0, reader->num_record_batches()))
+        {
+            const auto& batch = batches.emplace_back(reader->ReadRecordBatch(idx).ValueOrDie());
+            output.group_sizes.push_back(batch->num_rows());
+        }
+        output.table = arrow::Table::FromRecordBatches(reader->schema(), batches).ValueOrDie();
+        return output;
+    }
+} // namespace
+
+TEST_CASE("arrow_writer")
+{
+    static constexpr auto N_FRAMES = 250;
+    static constexpr auto GROUP_SIZE = 100;
+    static constexpr auto ADC_VALUE = uint16_t{ 100 };
+    const auto filename = GENERATE(std::string{ "unit_test.parquet" }, std::string{ "unit_test.arrow" });
+    INFO(filename);
+
+    auto n_hits = std::size_t{};
+    {
+        auto arrow_writer =
+            sink::ArrowFile{ filename, structure, 1, { .batch_size = GROUP_SIZE, .row_group_size = GROUP_SIZE } };
+        auto data_struct = srs::StructData{};
+        auto frame_converter = [&data_struct](std::size_t /*line_number*/ = 0) -> const srs::StructData*
+        { return &data_struct; };
+        for (auto idx : std::views::iota(0, N_FRAMES))
+        {
+            data_struct.header.frame_counter = static_cast<uint32_t>(idx);
+            data_struct.marker_data.assign(static_cast<std::size_t>(idx % 3), srs::MarkerData{ .vmm_id = 1 });
+            data_struct.hit_data.assign(static_cast<std::size_t>(idx % 7), srs::HitData{ .adc = ADC_VALUE });
+            data_struct.hit_time.assign(data_struct.hit_data.size(), static_cast<uint64_t>(idx));
+            n_hits += data_struct.hit_data.size();
+            auto res = arrow_writer.run(frame_converter, 0);
+            REQUIRE(res.has_value());
+            CHECK(res.value() == static_cast<std::size_t>(idx + 1));
+        }
+    }
+
+    const auto [table, group_sizes] = read_arrow_table(filename);
+    REQUIRE(table != nullptr);
+    CHECK(table->num_rows() == N_FRAMES);
+    const auto expected_group_sizes = std::vector<int64_t>{ GROUP_SIZE, GROUP_SIZE, N_FRAMES - (2 * GROUP_SIZE) };
+    CHECK(group_sizes == expected_group_sizes);
+
+    const auto frame_counters = table->GetColumnByName("frame_counter");
+    REQUIRE(frame_counters != nullptr);
+    auto frame_counter = uint32_t{};
+    for (const auto& chunk : frame_counters->chunks())
+    {
+        const auto& values = static_cast<const arrow::UInt32Array&>(*chunk);
+        for (auto idx : std::views::iota(int64_t{ 0 }, values.length()))
+        {
+            CHECK(values.Value(idx) == frame_counter);
+            ++frame_counter;
+        }
+    }
+
+    const auto hits = table->GetColumnByName("hits");
+    REQUIRE(hits != nullptr);
+    auto n_read_hits = std::size_t{};
+    for (const auto& chunk : hits->chunks())
+    {
+        const auto& hit_lists = static_cast<const arrow::ListArray&>(*chunk);
+        const auto& hit_values = static_cast<const arrow::StructArray&>(*hit_lists.values());
+        const auto adc_values = std::static_pointer_cast<arrow::UInt16Array>(hit_values.GetFieldByName("adc"));
+        REQUIRE(adc_values != nullptr);
+        for (auto idx : std::views::iota(int64_t{ 0 }, hit_lists.length()))
+        {
+            for (auto hit_idx : std::views::iota(hit_lists.value_offset(idx), hit_lists.value_offset(idx + 1)))
+            {
+                CHECK(adc_values->Value(hit_idx) == ADC_VALUE);
+                ++n_read_hits;
+            }
+        }
+    }
+    CHECK(n_read_hits == n_hits);
+}
+#endif
+
+TEST_CASE("compact_file")
+{
+    static constexpr auto N_FRAMES = 500;
+    static constexpr auto BLOCK_FRAMES = 64;
+    static constexpr auto N_FECS = 3;
+    const auto filename = std::string{ "unit_test.srsc" };
+    auto frames = std::vector<srs::StructData>(N_FRAMES);
+    for (auto [frame_idx, data_struct] : std::views::zip(std::views::iota(0U), frames))
+    {
+        auto& header = data_struct.header;
+        header.fec_id = static_cast<uint8_t>(frame_idx % N_FECS);
+        header.frame_counter = std::numeric_limits<uint32_t>::max() - 10 + (frame_idx / N_FECS);
+        header.udp_timestamp = frame_idx * 1000;
+        header.overflow = (frame_idx % 100 == 0) ? frame_idx : 0;
+        header.vmm_tag = (frame_idx == 7) ? std::array{ 'V', 'M', '2' } : std::array{ 'V', 'M', '3' };
+        for (auto marker_idx : std::views::iota(0U, frame_idx % 3))
+        {
+            data_struct.marker_data.push_back(
+                srs::MarkerData{ .vmm_id = static_cast<uint8_t>(marker_idx), .srs_timestamp = frame_idx * 100ULL });
+        }
+        for (auto hit_idx : std::views::iota(0U, frame_idx % 11))
+        {
+            data_struct.hit_data.push_back(srs::HitData{ .is_over_threshold = hit_idx % 2 == 0,
+                                                         .channel_num = static_cast<uint8_t>(hit_idx * 5),
+                                                         .tdc = static_cast<uint8_t>(frame_idx),
+                                                         .offset = static_cast<uint8_t>(hit_idx / 4),
+                                                         .vmm_id = static_cast<uint8_t>(hit_idx / 3),
+                                                         .adc = static_cast<uint16_t>(1023 - hit_idx),
+                                                         .bc_id = static_cast<uint16_t>(4095 - frame_idx) });
+        }
+    }
+
+    {
+        auto compact_writer = sink::CompactFile{ filename, structure, 1, BLOCK_FRAMES };
+        const auto* current_frame = static_cast<const srs::StructData*>(nullptr);
+        auto frame_converter = [&current_frame](std::size_t /*line_number*/ = 0) -> const srs::StructData*
+        { return current_frame; };
+        for (const auto& data_struct : frames)
+        {
+            current_frame = &data_struct;
+            auto res = compact_writer.run(frame_converter, 0);
+            REQUIRE(res.has_value());
+        }
+    }
+
+    // Footer is missing if the file is truncated.
+    const auto is_truncated = GENERATE(false, true);
+    INFO(fmt::format("truncated: {}", is_truncated));
+    auto expected_n_frames = std::size_t{ N_FRAMES };
+    if (is_truncated)
+    {
+        const auto last_block = srs::reader::CompactFile{ filename }.get_blocks().back();
+        std::filesystem::resize_file(filename, last_block.offset + srs::reader::CompactFile::BLOCK_HEADER_SIZE);
+        expected_n_frames = last_block.first_frame;
+    }
+
+    auto compact_reader = srs::reader::CompactFile{ filename };
+    REQUIRE(compact_reader.get_n_frames() == expected_n_frames);
+    for (auto idx : std::views::iota(std::size_t{ 0 }, expected_n_frames))
+    {
+        INFO(fmt::format("frame: {}", idx));
+        auto res = compact_reader.read_one_frame();
+        REQUIRE(res.has_value());
+        REQUIRE(res.value() != nullptr);
+        CHECK(*res.value() == frames[idx]);
+    }
+    auto end_res = compact_reader.read_one_frame();
+    REQUIRE(end_res.has_value());
+    CHECK(end_res.value() == nullptr);
+
+    for (auto frame_number : { std::size_t{ 0 }, std::size_t{ BLOCK_FRAMES }, std::size_t{ 200 } })
+    {
+        INFO(fmt::format("seek frame: {}", frame_number));
+        REQUIRE(compact_reader.seek_frame(frame_number).has_value());
+        auto res = compact_reader.read_one_frame();
+        REQUIRE(res.has_value());
+        REQUIRE(res.value() != nullptr);
+        CHECK(*res.value() == frames[frame_number]);
+    }
+    CHECK_FALSE(compact_reader.seek_frame(expected_n_frames).has_value());
+}
+
+namespace
+{
+    // Frames of the raw binary test file decoded into structs
+    auto read_test_raw_data() -> std::vector<srs::StructData>
+    {
+        auto frames = std::vector<srs::StructData>{};
+        auto frame_reader = srs::reader::RawFrame{ TEST_RAW_DATA_FILENAME };
+        auto body_data = process::StructDeserializer::ReceiveDataSquence{};
+        for (auto frame = frame_reader.read_one_frame(); frame.has_value() and not frame->empty();
+             frame = frame_reader.read_one_frame())
+        {
+            REQUIRE(process::StructDeserializer::convert(frame.value(), frames.emplace_back(), body_data).has_value());
+        }
+        return frames;
+    }
+
+    void write_compact_file(const std::string& filename, const std::vector<srs::StructData>& frames)
+    {
+        auto compact_writer = sink::CompactFile{ filename, structure, 1 };
+        const auto* current_frame = static_cast<const srs::StructData*>(nullptr);
+        auto frame_converter = [&current_frame](std::size_t /*line_number*/ = 0) -> const srs::StructData*
+        { return current_frame; };
+        for (const auto& data_struct : frames)
+        {
+            current_frame = &data_struct;
+            REQUIRE(compact_writer.run(frame_converter, 0).has_value());
+        }
+    }
+} // namespace
+
+TEST_CASE("compact_file_against_binary")
+{
+    // Same frames as in the raw binary file
+    const auto filename = std::string{ "unit_test_raw_data.srsc" };
+    const auto frames = read_test_raw_data();
+    REQUIRE_FALSE(frames.empty());
+    write_compact_file(filename, frames);
+
+    const auto binary_size = std::filesystem::file_size(TEST_RAW_DATA_FILENAME);
+    const auto compact_size = std::filesystem::file_size(filename);
+    INFO(fmt::format("binary: {} bytes, compact: {} bytes", binary_size, compact_size));
+    CHECK(compact_size < binary_size);
+
+    auto compact_reader = srs::reader::CompactFile{ filename };
+    REQUIRE(compact_reader.get_n_frames() == frames.size());
+    for (const auto& frame : frames)
+    {
+        auto res = compact_reader.read_one_frame();
+        REQUIRE(res.has_value());
+        REQUIRE(res.value() != nullptr);
+        CHECK(*res.value() == frame);
+    }
+}
+
+// Hidden from the default run. Run with "unit_test_srs_backend [!benchmark]".
+TEST_CASE("compact_file_decoding_speed", "[!benchmark]")
+{
+    const auto filename = std::string{ "unit_test_raw_data_benchmark.srsc" };
+    write_compact_file(filename, read_test_raw_data());
+
+    BENCHMARK("decode_binary")
+    {
+        auto frame_reader = srs::reader::RawFrame{ TEST_RAW_DATA_FILENAME };
+        auto body_data = process::StructDeserializer::ReceiveDataSquence{};
+        auto data_struct = srs::StructData{};
+        auto n_hits = std::size_t{};
+        for (auto frame = frame_reader.read_one_frame(); frame.has_value() and not frame->empty();
+             frame = frame_reader.read_one_frame())
+        {
+            reset_struct_data(data_struct);
+            [[maybe_unused]] auto res = process::StructDeserializer::convert(frame.value(), data_struct, body_data);
+            n_hits += data_struct.hit_data.size();
+        }
+        return n_hits;
+    };
+
+    BENCHMARK("decode_compact")
+    {
+        auto reader = srs::reader::CompactFile{ filename };
+        auto data_struct = srs::StructData{};
+        auto n_hits = std::size_t{};
+        while (reader.read_one_frame(data_struct).value_or(false))
+        {
+            n_hits += data_struct.hit_data.size();
+        }
+        return n_hits;
+    };
+}
+
 TEST_CASE("JSON_writer") { sink::WritableFile auto json_writer = sink::Json{ "unit_test.json", structure, 1 }; }
 
+TEST_CASE("JSON_writer_lines")
+{
+    static constexpr auto N_FRAMES = 100;
+    const auto filename = GENERATE(std::string{ "unit_test.json" }, std::string{ "unit_test.jsonl" });
+    INFO(filename);
+
+    auto data_struct = srs::StructData{};
+    auto frame_converter = [&data_struct](std::size_t /*line_number*/ = 0) -> const srs::StructData*
+    { return &data_struct; };
+    {
+        auto json_writer = sink::Json{ filename, structure, 1 };
+        CHECK(json_writer.is_json_lines() == filename.ends_with(".jsonl"));
+        for (auto idx : std::views::iota(0, N_FRAMES))
+        {
+            data_struct.header.frame_counter = static_cast<uint32_t>(idx);
+            data_struct.hit_data.assign(static_cast<std::size_t>(idx % 5), srs::HitData{ .adc = 100 });
+            auto res = json_writer.run(frame_converter, 0);
+            REQUIRE(res.has_value());
+            CHECK(res.value() > 0);
+        }
+    }
+
+    auto input_file = std::ifstream{ filename };
+    auto content = std::string{ std::istreambuf_iterator<char>{ input_file }, std::istreambuf_iterator<char>{} };
+    if (filename.ends_with(".jsonl"))
+    {
+        CHECK(std::ranges::count(content, '\n') == N_FRAMES);
+        for (auto line : content | std::views::split('\n') | std::views::take(N_FRAMES))
+        {
+            CHECK(std::string_view{ line }.starts_with(R"({"header":{"frame_counter":)"));
+        }
+    }
+    else
+    {
+        CHECK(content.starts_with("[\n"));
+        CHECK(content.ends_with("]\n"));
+    }
+}
+
 TEST_CASE("udp_writer")
 {
     auto io_context = asio::thread_pool{ 1 };